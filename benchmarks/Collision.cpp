@@ -0,0 +1,104 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <ij/World.h>
+
+namespace
+{
+    // the wall test before there was a WalkabilityMap
+    [[nodiscard]] bool isWalkablePointOnMap(const ij::Vector2f &point, const ij::Map &map)
+    {
+        using namespace ij;
+        const Vector2<ptrdiff_t> tileIndex(AssertCast<ptrdiff_t>(std::floor(point.x / TileSize)),
+                                           AssertCast<ptrdiff_t>(std::floor(point.y / TileSize)));
+        if ((tileIndex.x < 0) || (tileIndex.y < 0))
+        {
+            return false;
+        }
+        if ((tileIndex.x >= AssertCast<ptrdiff_t>(map.Width)) || (tileIndex.y >= AssertCast<ptrdiff_t>(map.GetHeight())))
+        {
+            return false;
+        }
+        return (map.GetTileAt(AssertCast<size_t>(tileIndex.x), AssertCast<size_t>(tileIndex.y)) != NoTile);
+    }
+
+    [[nodiscard]] bool isWalkableOnMap(const ij::Vector2f &point, const ij::Map &map)
+    {
+        const ij::Vector2f halfDimensions = ij::DefaultEntityDimensions / 2.0f;
+        return isWalkablePointOnMap(point - halfDimensions, map) && isWalkablePointOnMap(point + halfDimensions, map) &&
+               isWalkablePointOnMap(point + ij::Vector2f(-halfDimensions.x, halfDimensions.y), map) &&
+               isWalkablePointOnMap(point + ij::Vector2f(halfDimensions.x, -halfDimensions.y), map) &&
+               isWalkablePointOnMap(point, map);
+    }
+
+    [[nodiscard]] bool moveOnMap(ij::Vector2f &position, const ij::Vector2f &desiredChange, const ij::Map &map)
+    {
+        const ij::Vector2f desiredDestination = (position + desiredChange);
+        if (isWalkableOnMap(desiredDestination, map))
+        {
+            position = desiredDestination;
+            return false;
+        }
+        if (const ij::Vector2f horizontal = (position + ij::Vector2f(desiredChange.x, 0)); isWalkableOnMap(horizontal, map))
+        {
+            position = horizontal;
+            return true;
+        }
+        if (const ij::Vector2f vertical = (position + ij::Vector2f(0, desiredChange.y)); isWalkableOnMap(vertical, map))
+        {
+            position = vertical;
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE("Move walking entities with collision detection", "[benchmark][collision]")
+{
+    ij::StandardRandomNumberGenerator random(1);
+    const ij::Map map = ij::GenerateRandomMap(random);
+    const ij::World world(0, map, 1);
+    constexpr size_t numberOfEntities = 100'000;
+    std::vector<ij::Vector2f> start;
+    std::vector<ij::Vector2f> changes;
+    for (size_t i = 0; i < numberOfEntities; ++i)
+    {
+        start.push_back(ij::GenerateRandomPointForSpawning(world, random));
+        const float angle = ij::AssertCast<float>(random.GenerateInt32(0, 359)) * 0.0174533f;
+        // far enough to hit a wall sometimes
+        changes.emplace_back(std::cos(angle) * 20.0f, std::sin(angle) * 20.0f);
+    }
+    std::vector<ij::Vector2f> positions = start;
+    std::vector<std::uint8_t> hasBumpedIntoWall(numberOfEntities);
+
+    BENCHMARK("one entity at a time on the Map")
+    {
+        positions = start;
+        for (size_t i = 0; i < numberOfEntities; ++i)
+        {
+            hasBumpedIntoWall[i] = moveOnMap(positions[i], changes[i], map);
+        }
+        return hasBumpedIntoWall[0];
+    };
+
+    BENCHMARK("one entity at a time on the WalkabilityMap")
+    {
+        positions = start;
+        for (size_t i = 0; i < numberOfEntities; ++i)
+        {
+            hasBumpedIntoWall[i] = ij::MoveWithCollisionDetection(positions[i], true, changes[i], world);
+        }
+        return hasBumpedIntoWall[0];
+    };
+
+    ij::MovementBatch batch;
+    BENCHMARK("MovementBatch")
+    {
+        batch.Clear();
+        for (size_t i = 0; i < numberOfEntities; ++i)
+        {
+            batch.Add(i, start[i], changes[i]);
+        }
+        ij::MoveWithCollisionDetection(batch, world.Walkability, positions, hasBumpedIntoWall);
+        return hasBumpedIntoWall[0];
+    };
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/DepthOrder.h>
+#include <ij/RandomNumberGenerator.h>
+#include <ij/Sprite.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // the size of the NullCanvas
+    constexpr ij::Int32 windowHeight = 800;
+
+    // Sprites walking up and down a view of this height by a few pixels per frame. Those which leave it at one edge
+    // come back at the other one like new sprites entering the view.
+    struct Crowd final
+    {
+        std::vector<ij::Vector2i> Positions;
+        std::vector<ij::Int32> Speeds;
+        ij::Int32 ViewHeight;
+
+        Crowd(const size_t numberOfSprites, const ij::Int32 viewHeight)
+            : ViewHeight(viewHeight)
+        {
+            ij::StandardRandomNumberGenerator random(1);
+            for (size_t i = 0; i < numberOfSprites; ++i)
+            {
+                Positions.emplace_back(random.GenerateInt32(0, 1199), random.GenerateInt32(0, (viewHeight - 1)));
+                Speeds.push_back(random.GenerateInt32(-3, 3));
+            }
+        }
+
+        void MoveOneFrame()
+        {
+            for (size_t i = 0; i < Positions.size(); ++i)
+            {
+                Positions[i].y = ((Positions[i].y + Speeds[i] + ViewHeight) % ViewHeight);
+            }
+        }
+    };
+
+    void createSprites(const Crowd &crowd, std::vector<ij::Sprite> &sprites)
+    {
+        sprites.clear();
+        for (const ij::Vector2i &position : crowd.Positions)
+        {
+            sprites.emplace_back(ij::TextureId(0), position, ij::Color(255, 255, 255, 255), ij::Vector2u(0, 0),
+                                 ij::Vector2u(64, 64));
+        }
+    }
+
+    // the order of DrawWorld before there was a DepthOrder
+    [[nodiscard]] float bottomOfSprite(const ij::Sprite &sprite)
+    {
+        return (ij::AssertCast<float>(sprite.Position.y) + ij::AssertCast<float>(sprite.TextureSize.y));
+    }
+
+    void benchmarkSorting(const std::string &view, const size_t numberOfSprites, const ij::Int32 viewHeight)
+    {
+        std::vector<ij::Sprite> sprites;
+        Crowd sortedCrowd(numberOfSprites, viewHeight);
+        BENCHMARK(std::to_string(numberOfSprites) + " sprites in " + view + " with std::ranges::sort")
+        {
+            sortedCrowd.MoveOneFrame();
+            createSprites(sortedCrowd, sprites);
+            std::ranges::sort(sprites, [](const ij::Sprite &left, const ij::Sprite &right) -> bool {
+                return (bottomOfSprite(left) < bottomOfSprite(right));
+            });
+            return sprites.front().Position.y;
+        };
+
+        Crowd orderedCrowd(numberOfSprites, viewHeight);
+        ij::DepthOrder order;
+        BENCHMARK(std::to_string(numberOfSprites) + " sprites in " + view + " with DepthOrder")
+        {
+            orderedCrowd.MoveOneFrame();
+            createSprites(orderedCrowd, sprites);
+            for (size_t i = 0; i < sprites.size(); ++i)
+            {
+                order.Add(i, (sprites[i].Position.y + ij::AssertCast<ij::Int32>(sprites[i].TextureSize.y)));
+            }
+            return sprites[order.Sort().front()].Position.y;
+        };
+        const ij::DepthOrderStatistics &statistics = order.Statistics;
+        INFO(statistics.RadixSorts << " radix sorts, " << statistics.Repairs << " repairs");
+        CHECK(statistics.Repairs > statistics.RadixSorts);
+    }
+} // namespace
+
+TEST_CASE("Sort the sprites of a frame by depth", "[benchmark][draw]")
+{
+    // ij_bench --draw counts about 30 sprites in a window at the default density and about 220 at 0.2 enemies per
+    // tile. Zooming out shows twice the width and height around the window.
+    benchmarkSorting("the window", 30, windowHeight);
+    benchmarkSorting("the zoomed out view", 120, (2 * windowHeight));
+    benchmarkSorting("a crowded window", 220, windowHeight);
+    benchmarkSorting("a crowded zoomed out view", 880, (2 * windowHeight));
+}
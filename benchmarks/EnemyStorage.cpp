@@ -0,0 +1,186 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <ij/EnemyTemplate.h>
+#include <ij/Normalize.h>
+#include <ij/PlayerCharacter.h>
+#include <limits>
+
+namespace
+{
+    // The bot as it was before the enemies were stored as a structure of arrays: one heap allocated behavior per
+    // enemy which is called virtually, so that the benchmark can compare the two layouts.
+    struct LegacyBot final : ij::ObjectBehavior
+    {
+        void update(ij::LogicEntity &object, ij::LogicEntity &player, ij::World &world, const ij::TimeSpan deltaTime,
+                    ij::RandomNumberGenerator &random) override
+        {
+            using namespace ij;
+            if (isDead(object))
+            {
+                return;
+            }
+            switch (_state)
+            {
+            case Bot::State::MovingAround:
+                if (isWithinDistance(object.Position, player.Position, 400) && !isDead(player))
+                {
+                    _state = Bot::State::Chasing;
+                    _target = &player;
+                    break;
+                }
+                if (object.HasBumpedIntoWall || (random.GenerateInt32(0, 1999) < 10))
+                {
+                    object.SetActivity((object.GetActivity() == ObjectActivity::Standing) ? ObjectActivity::Walking
+                                                                                           : ObjectActivity::Standing);
+                    object.Direction = normalize(Vector2f(AssertCast<float>(random.GenerateInt32(0, 9) - 5),
+                                                          AssertCast<float>(random.GenerateInt32(0, 9) - 5)));
+                }
+                break;
+
+            case Bot::State::Chasing:
+                if (isDead(*_target))
+                {
+                    object.SetActivity(ObjectActivity::Standing);
+                    _state = Bot::State::MovingAround;
+                    _target = nullptr;
+                }
+                else if (isWithinDistance(object.Position, _target->Position, 40))
+                {
+                    _state = Bot::State::Attacking;
+                    object.SetActivity(ObjectActivity::Standing);
+                }
+                else if (isWithinDistance(object.Position, _target->Position, 600))
+                {
+                    object.SetActivity(ObjectActivity::Walking);
+                    object.Direction = normalize(_target->Position - object.Position);
+                }
+                else
+                {
+                    object.SetActivity(ObjectActivity::Standing);
+                    _state = Bot::State::MovingAround;
+                    _target = nullptr;
+                }
+                break;
+
+            case Bot::State::Attacking:
+                if (!isWithinDistance(object.Position, _target->Position, 60))
+                {
+                    _state = Bot::State::Chasing;
+                    object.SetActivity(ObjectActivity::Standing);
+                    break;
+                }
+                _sinceLastAttack += deltaTime;
+                while (_sinceLastAttack >= TimeSpan::FromMilliseconds(1000))
+                {
+                    object.SetActivity(ObjectActivity::Attacking);
+                    InflictDamage(player, world, 1);
+                    _sinceLastAttack -= TimeSpan::FromMilliseconds(1000);
+                }
+                if (isDead(player))
+                {
+                    _state = Bot::State::MovingAround;
+                    _target = nullptr;
+                    object.SetActivity(ObjectActivity::Standing);
+                }
+                break;
+            }
+            object.HasBumpedIntoWall = false;
+        }
+
+    private:
+        ij::Bot::State _state = ij::Bot::State::MovingAround;
+        ij::LogicEntity *_target = nullptr;
+        ij::TimeSpan _sinceLastAttack = ij::TimeSpan::FromMilliseconds(0);
+    };
+
+    struct LegacyObject final
+    {
+        ij::VisualEntity Visuals;
+        ij::LogicEntity Logic;
+    };
+
+    const ij::VisualEntity BenchmarkVisuals(ij::TextureId(0), ij::Vector2u(64, 64), 4, ij::TimeSpan::FromMilliseconds(0),
+                                            &ij::cutEnemyTexture<4, 3>, ij::ObjectAnimation::Standing);
+
+    // The same enemies and the same player for every layout. Each benchmark gets a game of its own, because the
+    // enemies hurt the player and the player's death changes what the bots do.
+    struct BenchmarkGame final
+    {
+        std::array<bool, 4> NoDirectionKeys = {};
+        bool IsAttackPressed = false;
+        ij::StandardRandomNumberGenerator Random;
+        ij::World SimulatedWorld;
+        // empty unless the enemies are legacy objects, which are not in the world then
+        std::vector<LegacyObject> LegacyEnemies;
+        ij::LogicEntity Player;
+
+        BenchmarkGame(const ij::Map &map, const size_t numberOfEnemies, const bool isLegacy)
+            : Random(123)
+            , SimulatedWorld(0, map, 123)
+            , Player(std::make_unique<ij::PlayerCharacter>(NoDirectionKeys, IsAttackPressed), ij::Vector2f(0, 0),
+                     ij::Vector2f(0, 0), true, false, 100, 100, ij::ObjectActivity::Standing)
+        {
+            using namespace ij;
+            // compare only the storage layouts, the legacy loop has no level of detail
+            SimulatedWorld.LevelOfDetail.NearRadius = std::numeric_limits<float>::infinity();
+            for (size_t i = 0; i < numberOfEnemies; ++i)
+            {
+                const Vector2f position = GenerateRandomPointForSpawning(SimulatedWorld, Random);
+                const Vector2f direction = DirectionToVector(AssertCast<Direction>(Random.GenerateInt32(0, 3)));
+                if (isLegacy)
+                {
+                    LegacyEnemies.emplace_back(
+                        LegacyObject{BenchmarkVisuals, LogicEntity(std::make_unique<LegacyBot>(), position, direction,
+                                                                   true, false, 100, 100, ObjectActivity::Standing)});
+                }
+                else
+                {
+                    AddEnemy(SimulatedWorld, BenchmarkVisuals, position, direction, 100, 100);
+                }
+            }
+            Player.Position = GenerateRandomPointForSpawning(SimulatedWorld, Random);
+            Player.PreviousPosition = Player.Position;
+        }
+    };
+} // namespace
+
+TEST_CASE("Simulation tick with different enemy storage layouts", "[benchmark][enemies]")
+{
+    using namespace ij;
+    const size_t numberOfEnemies = GENERATE(5'000, 50'000, 500'000);
+    const TimeSpan timeStep = TimeSpan::FromMilliseconds(1000 / FrameRate);
+
+    StandardRandomNumberGenerator random(123);
+    const Map map = GenerateRandomMap(random);
+    WorkerPool noWorkers(0);
+    WorkerPool workers(GetDefaultNumberOfWorkers());
+
+    BenchmarkGame sequential(map, numberOfEnemies, false);
+    BENCHMARK("structure of arrays, " + std::to_string(numberOfEnemies) + " enemies, one tick")
+    {
+        TimeSpan remaining = timeStep;
+        UpdateWorld(remaining, sequential.Player, sequential.SimulatedWorld, noWorkers);
+        return sequential.SimulatedWorld.enemies.Positions.front().x;
+    };
+
+    BenchmarkGame parallel(map, numberOfEnemies, false);
+    BENCHMARK("structure of arrays, " + std::to_string(numberOfEnemies) + " enemies, one tick, " +
+              std::to_string(workers.GetNumberOfWorkers() + 1) + " threads")
+    {
+        TimeSpan remaining = timeStep;
+        UpdateWorld(remaining, parallel.Player, parallel.SimulatedWorld, workers);
+        return parallel.SimulatedWorld.enemies.Positions.front().x;
+    };
+
+    BenchmarkGame legacy(map, numberOfEnemies, true);
+    BENCHMARK("legacy objects, " + std::to_string(numberOfEnemies) + " enemies, one tick")
+    {
+        updateLogic(legacy.Player, legacy.Player, legacy.SimulatedWorld, timeStep, legacy.Random);
+        for (LegacyObject &enemy : legacy.LegacyEnemies)
+        {
+            updateLogic(enemy.Logic, legacy.Player, legacy.SimulatedWorld, timeStep, legacy.Random);
+        }
+        return legacy.LegacyEnemies.front().Logic.Position.x;
+    };
+}
@@ -0,0 +1,51 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/Normalize.h>
+#include <ij/World.h>
+
+TEST_CASE("Find the way towards the player", "[benchmark][flow]")
+{
+    ij::StandardRandomNumberGenerator random(3);
+    const ij::World world(0, ij::GenerateRandomMap(random, 200, 200), 1);
+    const ij::Vector2f player = ij::GenerateRandomPointForSpawning(world, random);
+    ij::FlowField field(ij::GetFlowFieldRadius(ij::BotChaseDistance));
+    std::vector<ij::Vector2f> chasers;
+    while (chasers.size() < 1000)
+    {
+        const ij::Vector2f chaser = ij::GenerateRandomPointForSpawning(world, random);
+        if (ij::isWithinDistance(chaser, player, ij::BotChaseDistance))
+        {
+            chasers.push_back(chaser);
+        }
+    }
+
+    // what happens whenever the player enters another tile
+    bool isRight = false;
+    BENCHMARK("recompute the field")
+    {
+        isRight = !isRight;
+        return field.Update(world.Walkability, (player + ij::Vector2f((isRight ? ij::TileSize : 0.0f), 0)));
+    };
+
+    (void)field.Update(world.Walkability, player);
+    BENCHMARK("directions for 1000 chasers from the field")
+    {
+        float sum = 0;
+        for (const ij::Vector2f &chaser : chasers)
+        {
+            const std::optional<ij::Vector2f> flow = field.GetDirection(chaser);
+            sum += (flow ? flow->x : 0.0f);
+        }
+        return sum;
+    };
+
+    BENCHMARK("directions for 1000 chasers straight at the player")
+    {
+        float sum = 0;
+        for (const ij::Vector2f &chaser : chasers)
+        {
+            sum += ij::normalize(player - chaser).x;
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,44 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <ij/FastRandomNumberGenerator.h>
+#include <ij/MapFile.h>
+
+TEST_CASE("Load a map file instead of generating the map", "[benchmark][map]")
+{
+    const size_t size = GENERATE(size_t(500), size_t(4000));
+    const std::filesystem::path file =
+        (std::filesystem::temp_directory_path() / ("ij_benchmark_" + std::to_string(size) + ".ijmap"));
+    {
+        ij::FastRandomNumberGenerator random(1);
+        REQUIRE(ij::SaveMapFile(file, ij::GenerateRandomMap(random, size, size)));
+    }
+
+    BENCHMARK("GenerateRandomMap " + std::to_string(size))
+    {
+        ij::FastRandomNumberGenerator random(1);
+        return ij::GenerateRandomMap(random, size, size);
+    };
+
+    BENCHMARK("LoadMapFile " + std::to_string(size))
+    {
+        return ij::LoadMapFile(file);
+    };
+
+    // the tiles are only read from the file when they are accessed, so this includes the first access to every page
+    // that is already in the file cache
+    BENCHMARK("LoadMapFile and read every chunk " + std::to_string(size))
+    {
+        const std::optional<ij::Map> map = ij::LoadMapFile(file);
+        int sum = 0;
+        for (size_t chunkY = 0; chunkY < map->GetHeightInChunks(); ++chunkY)
+        {
+            for (size_t chunkX = 0; chunkX < map->GetWidthInChunks(); ++chunkX)
+            {
+                sum += map->GetChunk(chunkX, chunkY)[0];
+            }
+        }
+        return sum;
+    };
+    std::filesystem::remove(file);
+}
@@ -0,0 +1,114 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <ij/FastRandomNumberGenerator.h>
+#include <ij/Map.h>
+#include <iostream>
+
+namespace
+{
+    // how the map was stored before it had chunks
+    struct LegacyMap final
+    {
+        std::vector<int> Tiles;
+        size_t Width = 0;
+
+        [[nodiscard]] int GetTileAt(const size_t x, const size_t y) const
+        {
+            return Tiles[(y * Width) + x];
+        }
+    };
+} // namespace
+
+TEST_CASE("Look up tiles in different map layouts", "[benchmark][map]")
+{
+    const size_t size = GENERATE(size_t(500), size_t(4000));
+    ij::StandardRandomNumberGenerator random(1);
+    const ij::Map map = ij::GenerateRandomMap(random, size, size);
+    LegacyMap legacy;
+    legacy.Width = size;
+    legacy.Tiles.reserve(map.GetNumberOfTiles());
+    for (size_t y = 0; y < size; ++y)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            legacy.Tiles.push_back(map.GetTileAt(x, y));
+        }
+    }
+    std::cout << size << "x" << size << " tiles: " << (legacy.Tiles.size() * sizeof(int) / 1024)
+              << " KiB before, " << (map.GetMemoryUsage() / 1024) << " KiB in chunks\n";
+
+    // random access like the collision detection of enemies all over the map
+    constexpr size_t numberOfLookups = 1'000'000;
+    std::vector<size_t> xs(numberOfLookups);
+    std::vector<size_t> ys(numberOfLookups);
+    ij::Xoshiro256 coordinates(2);
+    for (size_t i = 0; i < numberOfLookups; ++i)
+    {
+        xs[i] = coordinates.GenerateSize(0, size - 1);
+        ys[i] = coordinates.GenerateSize(0, size - 1);
+    }
+
+    BENCHMARK("vector<int>, " + std::to_string(size) + ", random")
+    {
+        int sum = 0;
+        for (size_t i = 0; i < numberOfLookups; ++i)
+        {
+            sum += legacy.GetTileAt(xs[i], ys[i]);
+        }
+        return sum;
+    };
+
+    BENCHMARK("chunks, " + std::to_string(size) + ", random")
+    {
+        int sum = 0;
+        for (size_t i = 0; i < numberOfLookups; ++i)
+        {
+            sum += map.GetTileAt(xs[i], ys[i]);
+        }
+        return sum;
+    };
+
+    // like the renderer before it iterated over chunks
+    BENCHMARK("vector<int>, " + std::to_string(size) + ", row by row")
+    {
+        int sum = 0;
+        for (size_t y = 0; y < size; ++y)
+        {
+            for (size_t x = 0; x < size; ++x)
+            {
+                sum += legacy.GetTileAt(x, y);
+            }
+        }
+        return sum;
+    };
+
+    BENCHMARK("chunks, " + std::to_string(size) + ", row by row")
+    {
+        int sum = 0;
+        for (size_t y = 0; y < size; ++y)
+        {
+            for (size_t x = 0; x < size; ++x)
+            {
+                sum += map.GetTileAt(x, y);
+            }
+        }
+        return sum;
+    };
+
+    BENCHMARK("chunks, " + std::to_string(size) + ", chunk by chunk")
+    {
+        int sum = 0;
+        for (size_t chunkY = 0; chunkY < map.GetHeightInChunks(); ++chunkY)
+        {
+            for (size_t chunkX = 0; chunkX < map.GetWidthInChunks(); ++chunkX)
+            {
+                for (const ij::Tile tile : map.GetChunk(chunkX, chunkY))
+                {
+                    sum += tile;
+                }
+            }
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,160 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/MinHeap.h>
+#include <ij/PathFinder.h>
+#include <ij/RandomNumberGenerator.h>
+#include <limits>
+#include <string>
+
+namespace
+{
+    using Query = std::pair<ij::TilePosition, ij::TilePosition>;
+
+    [[nodiscard]] std::vector<Query> generateQueries(ij::RandomNumberGenerator &random, const ij::Map &map,
+                                                     const size_t count)
+    {
+        const auto randomTile = [&]() {
+            for (;;)
+            {
+                const size_t x = random.GenerateSize(0, (map.Width - 1));
+                const size_t y = random.GenerateSize(0, (map.GetHeight() - 1));
+                if (map.GetTileAt(x, y) != ij::NoTile)
+                {
+                    return ij::TilePosition(ij::AssertCast<ij::UInt32>(x), ij::AssertCast<ij::UInt32>(y));
+                }
+            }
+        };
+        std::vector<Query> queries;
+        for (size_t i = 0; i < count; ++i)
+        {
+            queries.emplace_back(randomTile(), randomTile());
+        }
+        return queries;
+    }
+
+    // what paths cost before: A* over all the tiles of the map with a binary heap
+    [[nodiscard]] bool findPathLegacy(const ij::Map &map, const ij::TilePosition &start, const ij::TilePosition &goal,
+                                      std::vector<ij::UInt32> &costs)
+    {
+        const ij::Int64 width = ij::AssertCast<ij::Int64>(map.Width);
+        const ij::Int64 height = ij::AssertCast<ij::Int64>(map.GetHeight());
+        const auto isWalkable = [&](const ij::Int64 x, const ij::Int64 y) {
+            return (x >= 0) && (y >= 0) && (x < width) && (y < height) &&
+                   (map.GetTileAt(ij::AssertCast<size_t>(x), ij::AssertCast<size_t>(y)) != ij::NoTile);
+        };
+        const auto estimate = [&goal](const ij::Int64 x, const ij::Int64 y) {
+            const ij::Int64 dx = std::abs(x - goal.x);
+            const ij::Int64 dy = std::abs(y - goal.y);
+            return ij::AssertCast<ij::UInt32>((10 * (dx + dy)) - (6 * (std::min)(dx, dy)));
+        };
+        costs.assign(ij::AssertCast<size_t>(width * height), (std::numeric_limits<ij::UInt32>::max)());
+        ij::MinHeap<std::pair<ij::UInt32, ij::UInt32>> open;
+        const ij::UInt32 startIndex = ij::AssertCast<ij::UInt32>((start.y * width) + start.x);
+        const ij::UInt32 goalIndex = ij::AssertCast<ij::UInt32>((goal.y * width) + goal.x);
+        costs[startIndex] = 0;
+        open.Push(std::make_pair(estimate(start.x, start.y), startIndex));
+        while (!open.IsEmpty())
+        {
+            const auto [total, index] = open.Pop();
+            if (index == goalIndex)
+            {
+                return true;
+            }
+            const ij::Int64 x = (index % width);
+            const ij::Int64 y = (index / width);
+            const ij::UInt32 cost = costs[index];
+            if (total != (cost + estimate(x, y)))
+            {
+                continue;
+            }
+            for (ij::Int64 dy = -1; dy <= 1; ++dy)
+            {
+                for (ij::Int64 dx = -1; dx <= 1; ++dx)
+                {
+                    if (((dx == 0) && (dy == 0)) || !isWalkable((x + dx), (y + dy)) || !isWalkable((x + dx), y) ||
+                        !isWalkable(x, (y + dy)))
+                    {
+                        continue;
+                    }
+                    const ij::UInt32 neighbour = ij::AssertCast<ij::UInt32>(((y + dy) * width) + (x + dx));
+                    const ij::UInt32 neighbourCost = (cost + (((dx != 0) && (dy != 0)) ? 14u : 10u));
+                    if (neighbourCost >= costs[neighbour])
+                    {
+                        continue;
+                    }
+                    costs[neighbour] = neighbourCost;
+                    open.Push(std::make_pair((neighbourCost + estimate((x + dx), (y + dy))), neighbour));
+                }
+            }
+        }
+        return false;
+    }
+
+    void benchmarkMap(const size_t size)
+    {
+        ij::StandardRandomNumberGenerator random(9);
+        const ij::Map map = ij::GenerateRandomMap(random, size, size);
+        const std::vector<Query> queries = generateQueries(random, map, 100);
+        ij::PathFinder cached(map, 1024);
+        ij::PathFinder uncached(map, 0);
+        const std::string tiles = (std::to_string(size) + "x" + std::to_string(size) + " tiles");
+
+        BENCHMARK("100 paths on " + tiles + " with HPA* and a cache")
+        {
+            size_t found = 0;
+            for (const Query &query : queries)
+            {
+                found += cached.FindPath(query.first, query.second).IsFound;
+            }
+            return found;
+        };
+
+        BENCHMARK("100 paths on " + tiles + " with HPA*")
+        {
+            size_t found = 0;
+            for (const Query &query : queries)
+            {
+                found += uncached.FindPath(query.first, query.second).IsFound;
+            }
+            return found;
+        };
+
+        BENCHMARK("100 paths on " + tiles + " with HPA* in steps of 1000 expansions")
+        {
+            std::vector<ij::PathRequestId> requests;
+            for (const Query &query : queries)
+            {
+                requests.push_back(uncached.RequestPath(query.first, query.second));
+            }
+            size_t found = 0;
+            for (const ij::PathRequestId request : requests)
+            {
+                std::optional<ij::FoundPath> result;
+                while (!result)
+                {
+                    uncached.ProcessRequests(1000);
+                    result = uncached.TakeResult(request);
+                }
+                found += result->IsFound;
+            }
+            return found;
+        };
+
+        std::vector<ij::UInt32> costs;
+        BENCHMARK("100 paths on " + tiles + " with A* on tiles (legacy)")
+        {
+            size_t found = 0;
+            for (const Query &query : queries)
+            {
+                found += findPathLegacy(map, query.first, query.second, costs);
+            }
+            return found;
+        };
+    }
+} // namespace
+
+TEST_CASE("Find paths on large maps", "[benchmark][path]")
+{
+    benchmarkMap(500);
+    benchmarkMap(2000);
+}
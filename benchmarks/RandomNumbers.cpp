@@ -0,0 +1,77 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/FastRandomNumberGenerator.h>
+#include <vector>
+
+TEST_CASE("Generate the tiles of a map", "[benchmark][random]")
+{
+    constexpr size_t numberOfTiles = (500 * 500);
+    std::vector<ij::Int32> tiles(numberOfTiles);
+
+    BENCHMARK("StandardRandomNumberGenerator")
+    {
+        ij::StandardRandomNumberGenerator random(1);
+        ij::RandomNumberGenerator &virtualRandom = random;
+        for (ij::Int32 &tile : tiles)
+        {
+            tile = virtualRandom.GenerateInt32(0, 3);
+        }
+        return tiles.back();
+    };
+
+    BENCHMARK("FastRandomNumberGenerator through the interface")
+    {
+        ij::FastRandomNumberGenerator random(1);
+        ij::RandomNumberGenerator &virtualRandom = random;
+        for (ij::Int32 &tile : tiles)
+        {
+            tile = virtualRandom.GenerateInt32(0, 3);
+        }
+        return tiles.back();
+    };
+
+    BENCHMARK("Xoshiro256")
+    {
+        ij::Xoshiro256 random(1);
+        for (ij::Int32 &tile : tiles)
+        {
+            tile = random.GenerateInt32(0, 3);
+        }
+        return tiles.back();
+    };
+
+    BENCHMARK("BatchRandomNumberGenerator")
+    {
+        ij::BatchRandomNumberGenerator random(1);
+        random.FillInt32(tiles, 0, 3);
+        return tiles.back();
+    };
+}
+
+TEST_CASE("Generate the random numbers of a tick of bots", "[benchmark][random]")
+{
+    constexpr size_t numberOfBots = 50'000;
+
+    BENCHMARK("CounterBasedRandomNumberGenerator through the interface")
+    {
+        ij::Int32 sum = 0;
+        for (size_t i = 0; i < numberOfBots; ++i)
+        {
+            ij::CounterBasedRandomNumberGenerator random(1, 2, i);
+            ij::RandomNumberGenerator &virtualRandom = random;
+            sum += virtualRandom.GenerateInt32(0, 1999);
+        }
+        return sum;
+    };
+
+    BENCHMARK("CounterBasedRandomNumberGenerator")
+    {
+        ij::Int32 sum = 0;
+        for (size_t i = 0; i < numberOfBots; ++i)
+        {
+            ij::CounterBasedRandomNumberGenerator random(1, 2, i);
+            sum += random.GenerateInt32(0, 1999);
+        }
+        return sum;
+    };
+}
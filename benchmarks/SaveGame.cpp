@@ -0,0 +1,46 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/NullTextureLoader.h>
+#include <ij/SaveGame.h>
+#include <iostream>
+
+TEST_CASE("Save a game", "[benchmark][save]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    ij::Game game(ij::GameSettings{}, *enemies, ij::TextureId(0));
+    std::vector<std::uint8_t> &isDirty = game.SimulatedWorld.enemies.IsDirty;
+    std::cout << game.SimulatedWorld.enemies.GetCount() << " enemies\n";
+
+    // the cost on the simulation thread
+    BENCHMARK("snapshot of every enemy")
+    {
+        std::ranges::fill(isDirty, std::uint8_t(true));
+        return ij::TakeSaveGameSnapshot(game).Enemies.size();
+    };
+
+    BENCHMARK("snapshot without changes")
+    {
+        return ij::TakeSaveGameSnapshot(game).Enemies.size();
+    };
+
+    const std::filesystem::path file = (std::filesystem::temp_directory_path() / "ij_benchmark_save_game.sqlite");
+    std::filesystem::remove(file);
+    const std::unique_ptr<ij::SaveGameWriter> writer = ij::OpenSaveGame(file);
+    REQUIRE(writer);
+
+    // the cost on the writer thread
+    BENCHMARK("write every enemy")
+    {
+        std::ranges::fill(isDirty, std::uint8_t(true));
+        writer->Submit(ij::TakeSaveGameSnapshot(game));
+        writer->WaitUntilWritten();
+    };
+
+    const ij::SaveGameStatistics statistics = writer->GetStatistics();
+    const double seconds = std::chrono::duration<double>(statistics.TimeSpentWriting).count();
+    std::cout << statistics.RowsWritten << " rows in " << statistics.Transactions << " transactions, "
+              << (ij::AssertCast<double>(statistics.RowsWritten) / seconds) << " rows/s while writing\n";
+}
@@ -0,0 +1,43 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/Game.h>
+#include <ij/NullTextureLoader.h>
+#include <iostream>
+
+TEST_CASE("Move an infinite world along with the player", "[benchmark][streaming]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    ij::GameSettings settings;
+    settings.IsWorldInfinite = true;
+    ij::Game game(settings, *enemies, ij::TextureId(0));
+
+    BENCHMARK("generate a chunk")
+    {
+        ij::ChunkTiles tiles;
+        ij::GenerateChunk(1, ij::ChunkCoordinates{2, 3}, tiles);
+        return tiles[0];
+    };
+
+    // every iteration moves the map by one chunk, so it measures evicting a column of chunks and their enemies,
+    // building the new map and spawning the enemies of the new column
+    BENCHMARK("recenter after walking one chunk to the right")
+    {
+        game.Player.Logic.Position.x += ij::ChunkSizeInPixels;
+        game.Streaming->Update(game.SimulatedWorld, game.Player.Logic, game.CurrentInput.selectedEnemy);
+        return game.SimulatedWorld.enemies.GetCount();
+    };
+
+    BENCHMARK("update without recentering")
+    {
+        game.Streaming->Update(game.SimulatedWorld, game.Player.Logic, game.CurrentInput.selectedEnemy);
+        return game.SimulatedWorld.enemies.GetCount();
+    };
+
+    const ij::StreamingStatistics &statistics = game.Streaming->Statistics;
+    std::cout << statistics.Recenterings << " recenterings, " << statistics.ChunksGeneratedOnDemand
+              << " chunks generated on demand, " << statistics.ChunksGeneratedInBackground << " in the background, "
+              << game.Streaming->GetNumberOfLoadedChunks() << " loaded, " << game.SimulatedWorld.enemies.GetCount()
+              << " enemies\n";
+}
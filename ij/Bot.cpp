@@ -1,97 +1,101 @@
 #include "Bot.h"
 #include "Normalize.h"
 #include "Unreachable.h"
+#include "World.h"
 
-void ij::Bot::update(LogicEntity &object, LogicEntity &player, World &world, const TimeSpan deltaTime,
-                     RandomNumberGenerator &random)
+void ij::UpdateBot(EnemyStore &enemies, const size_t enemy, const LogicEntity &player,
+                   const FlowField &towardsPlayer, const TimeSpan deltaTime, CounterBasedRandomNumberGenerator &random,
+                   CommandBuffer &commands)
 {
-    (void)world;
-    if (isDead(object))
+    if (enemies.IsDead(enemy))
     {
         return;
     }
-    switch (_state)
+    Bot &bot = enemies.Bots[enemy];
+    Vector2f &position = enemies.Positions[enemy];
+    Vector2f &direction = enemies.Directions[enemy];
+    switch (bot.CurrentState)
     {
-    case State::MovingAround:
-        if (isWithinDistance(object.Position, player.Position, 400) && !isDead(player))
+    case Bot::State::MovingAround:
+        if (isWithinDistance(position, player.Position, BotNoticeDistance) && !isDead(player))
         {
-            _state = State::Chasing;
-            _target = &player;
+            bot.CurrentState = Bot::State::Chasing;
+            bot.HasTarget = true;
             break;
         }
-        if (object.HasBumpedIntoWall || (random.GenerateInt32(0, 1999) < 10))
+        // ten in 2000 per tick at the normal frame rate, more likely if more time has passed since the last update
+        if (enemies.HasBumpedIntoWall[enemy] ||
+            (random.GenerateInt32(0, 1999) <
+             AssertCast<Int32>(((10 * deltaTime.Milliseconds * FrameRate) + 500) / 1000)))
         {
-            switch (object.GetActivity())
+            switch (enemies.Activities[enemy])
             {
             case ObjectActivity::Standing:
-                object.SetActivity(ObjectActivity::Walking);
+                enemies.SetActivity(enemy, ObjectActivity::Walking);
                 break;
             case ObjectActivity::Walking:
             case ObjectActivity::Attacking:
             case ObjectActivity::Dead:
-                object.SetActivity(ObjectActivity::Standing);
+                enemies.SetActivity(enemy, ObjectActivity::Standing);
                 break;
             }
-            object.Direction = normalize(Vector2f(
+            direction = normalize(Vector2f(
                 AssertCast<float>(random.GenerateInt32(0, 9) - 5), AssertCast<float>(random.GenerateInt32(0, 9) - 5)));
         }
         break;
 
-    case State::Chasing:
-        assert(_target);
-        if (isDead(*_target))
+    case Bot::State::Chasing:
+        assert(bot.HasTarget);
+        if (isDead(player))
         {
-            object.SetActivity(ObjectActivity::Standing);
-            _state = State::MovingAround;
-            _target = nullptr;
+            enemies.SetActivity(enemy, ObjectActivity::Standing);
+            bot.CurrentState = Bot::State::MovingAround;
+            bot.HasTarget = false;
         }
-        else if (isWithinDistance(object.Position, _target->Position, 40))
+        else if (isWithinDistance(position, player.Position, 40))
         {
-            _state = State::Attacking;
-            object.SetActivity(ObjectActivity::Standing);
+            bot.CurrentState = Bot::State::Attacking;
+            enemies.SetActivity(enemy, ObjectActivity::Standing);
         }
-        else if (isWithinDistance(object.Position, _target->Position, 600))
+        else if (isWithinDistance(position, player.Position, BotChaseDistance))
         {
-            object.SetActivity(ObjectActivity::Walking);
-            object.Direction = normalize(_target->Position - object.Position);
+            enemies.SetActivity(enemy, ObjectActivity::Walking);
+            // straight ahead within the tile of the player or when walls block every path nearby
+            const std::optional<Vector2f> flow = towardsPlayer.GetDirection(position);
+            direction = (flow ? *flow : normalize(player.Position - position));
         }
         else
         {
-            object.SetActivity(ObjectActivity::Standing);
-            _state = State::MovingAround;
-            _target = nullptr;
+            enemies.SetActivity(enemy, ObjectActivity::Standing);
+            bot.CurrentState = Bot::State::MovingAround;
+            bot.HasTarget = false;
         }
         break;
 
-    case State::Attacking:
-        if (!isWithinDistance(object.Position, _target->Position, 60))
+    case Bot::State::Attacking:
+        if (!isWithinDistance(position, player.Position, 60))
         {
-            _state = State::Chasing;
-            object.SetActivity(ObjectActivity::Standing);
+            bot.CurrentState = Bot::State::Chasing;
+            enemies.SetActivity(enemy, ObjectActivity::Standing);
             break;
         }
-        _sinceLastAttack += deltaTime;
+        bot.SinceLastAttack += deltaTime;
         const TimeSpan attackDelay = TimeSpan::FromMilliseconds(1000);
-        while (_sinceLastAttack >= attackDelay)
+        while (bot.SinceLastAttack >= attackDelay)
         {
-            object.SetActivity(ObjectActivity::Attacking);
-            InflictDamage(player, world, 1, random);
-            _sinceLastAttack -= attackDelay;
+            enemies.SetActivity(enemy, ObjectActivity::Attacking);
+            commands.AttacksOnPlayer.push_back(CommandBuffer::Attack{enemy, 1});
+            bot.SinceLastAttack -= attackDelay;
         }
         if (isDead(player))
         {
-            _state = State::MovingAround;
-            object.SetActivity(ObjectActivity::Standing);
+            bot.CurrentState = Bot::State::MovingAround;
+            enemies.SetActivity(enemy, ObjectActivity::Standing);
         }
         break;
     }
     // acknowledged
-    object.HasBumpedIntoWall = false;
-}
-
-ij::Bot::State ij::Bot::GetState() const
-{
-    return _state;
+    enemies.HasBumpedIntoWall[enemy] = false;
 }
 
 const char *ij::Bot::GetStateName(const State state)
@@ -107,8 +111,3 @@ const char *ij::Bot::GetStateName(const State state)
     }
     IJ_UNREACHABLE();
 }
-
-ij::LogicEntity *ij::Bot::GetTarget() const
-{
-    return _target;
-}
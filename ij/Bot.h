@@ -1,15 +1,15 @@
 #pragma once
+#include "CommandBuffer.h"
+#include "FlowField.h"
 #include "LogicEntity.h"
 #include "RandomNumberGenerator.h"
-#include "World.h"
 
 namespace ij
 {
-    struct Bot final : ObjectBehavior
+    // The state of an enemy AI. Kept free of pointers and virtual functions so that it can be stored in a plain array
+    // next to the other enemy components.
+    struct Bot final
     {
-        void update(LogicEntity &object, LogicEntity &player, World &world, TimeSpan deltaTime,
-                    RandomNumberGenerator &random) override;
-
         enum class State
         {
             MovingAround,
@@ -17,13 +17,23 @@ namespace ij
             Attacking
         };
 
-        [[nodiscard]] State GetState() const;
-        [[nodiscard]] static const char *GetStateName(State state);
-        [[nodiscard]] LogicEntity *GetTarget() const;
+        State CurrentState = State::MovingAround;
+        // the only thing a bot can target is the player
+        bool HasTarget = false;
+        TimeSpan SinceLastAttack = TimeSpan::FromMilliseconds(0);
 
-    private:
-        State _state = State::MovingAround;
-        LogicEntity *_target = nullptr;
-        TimeSpan _sinceLastAttack = TimeSpan::FromMilliseconds(0);
+        [[nodiscard]] static const char *GetStateName(State state);
     };
+
+    // bots start chasing the player within this distance
+    constexpr float BotNoticeDistance = 400;
+    // and give up beyond this one
+    constexpr float BotChaseDistance = 600;
+
+    struct EnemyStore;
+
+    // Only changes the given enemy, so different enemies can be updated in parallel. Effects on the player are
+    // recorded in the command buffer. Chasing bots follow the flow field towards the player where it has a path.
+    void UpdateBot(EnemyStore &enemies, size_t enemy, const LogicEntity &player, const FlowField &towardsPlayer,
+                   TimeSpan deltaTime, CounterBasedRandomNumberGenerator &random, CommandBuffer &commands);
 } // namespace ij
@@ -46,6 +46,11 @@ ij::Vector2f ij::Text::GetPosition()
     return _canvas->GetTextPosition(_id);
 }
 
+ij::TextId ij::Text::GetId() const
+{
+    return _id;
+}
+
 void ij::Text::Draw()
 {
     assert(_canvas);
@@ -1,14 +1,18 @@
 #pragma once
+#include "SlotMap.h"
 #include "Sprite.h"
 #include "TextureCutter.h"
-#include <string>
+#include <span>
+#include <string_view>
 
 namespace ij
 {
-    using TextId = size_t;
+    using TextId = SlotHandle;
     using FontId = size_t;
 
     struct Canvas;
+    struct DrawCommand;
+    struct TileChunkRenderer;
 
     struct Text
     {
@@ -19,11 +23,12 @@ namespace ij
         Text &operator=(Text &&other) noexcept;
         void SetPosition(const Vector2f &position);
         Vector2f GetPosition();
+        [[nodiscard]] TextId GetId() const;
         void Draw();
 
     private:
         Canvas *_canvas = nullptr;
-        TextId _id = 0;
+        TextId _id;
     };
 
     struct Canvas
@@ -34,13 +39,23 @@ namespace ij
         virtual void DrawRectangle(const Vector2i &topLeft, const Vector2u &size, Color outline, Color fill,
                                    float outlineThickness) = 0;
         virtual void DrawSprite(const Sprite &sprite) = 0;
-        [[nodiscard]] virtual Text CreateText(const std::string &content, FontId font, const Vector2f &position,
+        [[nodiscard]] virtual Text CreateText(std::string_view content, FontId font, const Vector2f &position,
                                               Color fillColor, Color outlineColor, float outlineThickness) = 0;
         virtual void SetTextPosition(TextId id, const Vector2f &position) = 0;
         [[nodiscard]] virtual Vector2f GetTextPosition(TextId id) = 0;
         virtual void DeleteText(TextId id) = 0;
         virtual void DrawText(TextId id) = 0;
+        // Draws all the commands in their order, like the functions for single primitives would. This is how the
+        // world is drawn every frame, so canvases can batch here without a virtual call per primitive.
+        virtual void Submit(std::span<const DrawCommand> commands) = 0;
         virtual void SetView(const Rectangle<float> &view) = 0;
+        // Canvases may collect what is drawn and draw it later in batches. This draws everything collected so far, for
+        // example before the user interface is drawn on top.
+        virtual void Flush() = 0;
+        // how often the canvas has called the graphics library to draw something so far, for measuring batching
+        [[nodiscard]] virtual UInt64 GetDrawCallCount() = 0;
+        // nullptr if the canvas can only draw tiles one by one as sprites
+        [[nodiscard]] virtual TileChunkRenderer *GetTileChunkRenderer() = 0;
     };
 
 } // namespace ij
@@ -0,0 +1,70 @@
+#include "Checksum.h"
+#include <type_traits>
+
+namespace ij
+{
+    namespace
+    {
+        struct Fnv1a final
+        {
+            UInt64 State;
+
+            void AddBytes(const std::byte *const data, const size_t size)
+            {
+                constexpr UInt64 prime = 1099511628211ull;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    State = ((State ^ static_cast<UInt64>(data[i])) * prime);
+                }
+            }
+
+            template <class T>
+            void Add(const T &value)
+            {
+                // padding bytes would make the checksum random
+                static_assert(std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>);
+                AddBytes(reinterpret_cast<const std::byte *>(&value), sizeof(value));
+            }
+
+            template <class T>
+            void Add(const Vector2<T> &value)
+            {
+                Add(value.x);
+                Add(value.y);
+            }
+
+            template <class T>
+            void AddAll(const std::vector<T> &values)
+            {
+                Add(values.size());
+                for (const T &value : values)
+                {
+                    Add(value);
+                }
+            }
+        };
+    } // namespace
+} // namespace ij
+
+ij::UInt64 ij::UpdateChecksum(const UInt64 checksum, const World &world, const LogicEntity &player)
+{
+    Fnv1a hash{checksum};
+    hash.Add(world.SimulatedTicks);
+    hash.Add(player.Position);
+    hash.Add(player.Direction);
+    hash.Add(player.GetCurrentHealth());
+    hash.Add(player.GetActivity());
+    const EnemyStore &enemies = world.enemies;
+    hash.AddAll(enemies.Positions);
+    hash.AddAll(enemies.Directions);
+    hash.AddAll(enemies.CurrentHealth);
+    hash.AddAll(enemies.Activities);
+    hash.AddAll(enemies.SimulatedTicks);
+    for (const Bot &bot : enemies.Bots)
+    {
+        hash.Add(bot.CurrentState);
+        hash.Add(bot.HasTarget);
+        hash.Add(bot.SinceLastAttack.Milliseconds);
+    }
+    return hash.State;
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "World.h"
+
+namespace ij
+{
+    // FNV-1a offset basis
+    constexpr UInt64 InitialChecksum = 14695981039346656037ull;
+
+    // Continues the checksum with the simulated state of the world and the player. Visuals are not included because
+    // they depend on the frame rate. Two games with the same input recording have identical checksums after every
+    // tick.
+    [[nodiscard]] UInt64 UpdateChecksum(UInt64 checksum, const World &world, const LogicEntity &player);
+} // namespace ij
@@ -0,0 +1,9 @@
+#include "CommandBuffer.h"
+
+void ij::CommandBuffer::Clear()
+{
+    AttacksOnPlayer.clear();
+    GridMoves.clear();
+    Counts = LevelOfDetailCounts();
+    Movements.Clear();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "LevelOfDetail.h"
+#include "LogicEntity.h"
+#include "WalkabilityMap.h"
+#include <vector>
+
+namespace ij
+{
+    // Effects of enemies on shared parts of the world. The enemies are updated in parallel, so these effects are
+    // collected per group of enemies and applied afterwards in a fixed order. That makes the result independent from
+    // the number of threads.
+    struct CommandBuffer final
+    {
+        struct GridMove final
+        {
+            size_t Enemy;
+            Vector2f From;
+        };
+
+        struct Attack final
+        {
+            size_t Enemy;
+            Health Damage;
+        };
+
+        // attacks on the player in the order of the enemies
+        std::vector<Attack> AttacksOnPlayer;
+        // enemies which may have moved to another cell of World::EnemyGrid
+        std::vector<GridMove> GridMoves;
+        // statistics are summed up in the same way
+        LevelOfDetailCounts Counts;
+        // not an effect on the shared world, only collected so that all the walls can be checked in one go
+        MovementBatch Movements;
+
+        void Clear();
+    };
+} // namespace ij
@@ -0,0 +1,153 @@
+#include "DepthOrder.h"
+#include "AssertCast.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+
+namespace ij
+{
+    namespace
+    {
+        // in DepthOrder::_elementOfPrevious for objects which are gone
+        constexpr UInt32 noElement = (std::numeric_limits<UInt32>::max)();
+        // Repairing is allowed to move each element this many places on average. A nearly sorted order takes far
+        // fewer moves, while the radix sort costs a few passes over all elements.
+        constexpr size_t maximumMovesPerElement = 8;
+        // when more of the elements are new, they are sorted from scratch because they all start at the end
+        constexpr size_t maximumNewElementsPerElement = 4;
+        constexpr unsigned radixBits = 8;
+        constexpr UInt32 radixMask = ((1u << radixBits) - 1);
+
+        // the same order as the signed keys
+        [[nodiscard]] UInt32 toUnsignedKey(const Int32 key)
+        {
+            return (std::bit_cast<UInt32>(key) ^ 0x8000'0000u);
+        }
+    } // namespace
+} // namespace ij
+
+void ij::DepthOrder::Add(const UInt64 object, const Int32 key)
+{
+    assert(_objects.empty() || (object > _objects.back()));
+    _objects.push_back(object);
+    _keys.push_back(key);
+}
+
+std::span<const ij::UInt32> ij::DepthOrder::Sort()
+{
+    assert(_objects.size() < noElement);
+    startFromPreviousOrder();
+    if (tryToRepair())
+    {
+        ++Statistics.Repairs;
+    }
+    else
+    {
+        radixSort();
+        ++Statistics.RadixSorts;
+        Statistics.MovesLastFrame = 0;
+    }
+    _previousObjects.swap(_objects);
+    _previousOrder.swap(_order);
+    _objects.clear();
+    _keys.clear();
+    return _previousOrder;
+}
+
+void ij::DepthOrder::startFromPreviousOrder()
+{
+    // both lists of objects are ascending, so they can be matched like in a merge
+    _elementOfPrevious.assign(_previousObjects.size(), noElement);
+    _newElements.clear();
+    size_t element = 0;
+    for (size_t previous = 0; previous < _previousObjects.size(); ++previous)
+    {
+        for (; (element < _objects.size()) && (_objects[element] < _previousObjects[previous]); ++element)
+        {
+            _newElements.push_back(AssertCast<UInt32>(element));
+        }
+        if ((element < _objects.size()) && (_objects[element] == _previousObjects[previous]))
+        {
+            _elementOfPrevious[previous] = AssertCast<UInt32>(element);
+            ++element;
+        }
+    }
+    for (; element < _objects.size(); ++element)
+    {
+        _newElements.push_back(AssertCast<UInt32>(element));
+    }
+
+    _order.clear();
+    for (const UInt32 previous : _previousOrder)
+    {
+        if (const UInt32 current = _elementOfPrevious[previous]; current != noElement)
+        {
+            _order.push_back(current);
+        }
+    }
+    _order.insert(_order.end(), _newElements.begin(), _newElements.end());
+    assert(_order.size() == _objects.size());
+}
+
+bool ij::DepthOrder::tryToRepair()
+{
+    const size_t count = _order.size();
+    if ((_newElements.size() * maximumNewElementsPerElement) > count)
+    {
+        return false;
+    }
+    const size_t maximumMoves = (maximumMovesPerElement * count);
+    size_t moves = 0;
+    for (size_t i = 1; i < count; ++i)
+    {
+        const UInt32 element = _order[i];
+        const Int32 key = _keys[element];
+        size_t destination = i;
+        // strictly greater, so that equal keys keep their order
+        for (; (destination > 0) && (_keys[_order[destination - 1]] > key); --destination)
+        {
+            _order[destination] = _order[destination - 1];
+        }
+        _order[destination] = element;
+        moves += (i - destination);
+        if (moves > maximumMoves)
+        {
+            // the order is still complete, so the radix sort can continue from here
+            return false;
+        }
+    }
+    Statistics.MovesLastFrame = moves;
+    return true;
+}
+
+void ij::DepthOrder::radixSort()
+{
+    // least significant digit first, and every pass is stable
+    _radixBuffer.resize(_order.size());
+    for (unsigned shift = 0; shift < 32; shift += radixBits)
+    {
+        std::array<size_t, (radixMask + 1)> starts = {};
+        for (const Int32 key : _keys)
+        {
+            ++starts[(toUnsignedKey(key) >> shift) & radixMask];
+        }
+        // the usual case for the upper digits of coordinates
+        if (std::ranges::find(starts, _keys.size()) != starts.end())
+        {
+            continue;
+        }
+        size_t start = 0;
+        for (size_t &digitStart : starts)
+        {
+            const size_t numberOfKeys = digitStart;
+            digitStart = start;
+            start += numberOfKeys;
+        }
+        for (const UInt32 element : _order)
+        {
+            _radixBuffer[starts[(toUnsignedKey(_keys[element]) >> shift) & radixMask]++] = element;
+        }
+        _order.swap(_radixBuffer);
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "Int.h"
+#include <span>
+#include <vector>
+
+namespace ij
+{
+    struct DepthOrderStatistics final
+    {
+        // how often the order of the previous call only had to be repaired
+        UInt64 Repairs = 0;
+        // how often repairing took too long, so that the order was sorted from scratch
+        UInt64 RadixSorts = 0;
+        // the places by which the last repair moved the elements in total, or 0 after a radix sort
+        size_t MovesLastFrame = 0;
+    };
+
+    // Sorts the objects which are drawn in a frame by an integer key, usually the bottom edge of their sprite. Objects
+    // move only a little from frame to frame, so the order of the previous frame is almost right. It is repaired by an
+    // insertion sort which gives up after too many moves, and then a radix sort takes over. Objects with the same key
+    // stay in the previous order either way, so that overlapping sprites do not flicker.
+    struct DepthOrder final
+    {
+        DepthOrderStatistics Statistics;
+
+        // The object identifies the element from one call of Sort to the next and has to be larger than the objects
+        // added before it. Identifying the wrong object only costs time.
+        void Add(UInt64 object, Int32 key);
+        // Returns the indices of the elements in the order of Add, from the lowest key to the highest, and starts the
+        // next frame. The result stays valid until the next call.
+        [[nodiscard]] std::span<const UInt32> Sort();
+
+    private:
+        std::vector<UInt64> _objects;
+        std::vector<Int32> _keys;
+        // from the previous call
+        std::vector<UInt64> _previousObjects;
+        std::vector<UInt32> _previousOrder;
+        std::vector<UInt32> _order;
+        // reused by Sort
+        std::vector<UInt32> _elementOfPrevious;
+        std::vector<UInt32> _newElements;
+        std::vector<UInt32> _radixBuffer;
+
+        // puts the elements into the previous order and the new ones at the end
+        void startFromPreviousOrder();
+        [[nodiscard]] bool tryToRepair();
+        void radixSort();
+    };
+} // namespace ij
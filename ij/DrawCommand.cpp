@@ -0,0 +1,34 @@
+#include "DrawCommand.h"
+
+namespace ij
+{
+    namespace
+    {
+        const Color noColor(0, 0, 0, 0);
+    } // namespace
+} // namespace ij
+
+ij::DrawCommand ij::CreateSpriteCommand(const Sprite &sprite)
+{
+    return DrawCommand{DrawCommandType::Sprite, sprite.Texture.Value, sprite.Position, sprite.TextureSize,
+                       sprite.TextureTopLeft, sprite.ColorMultiplier, noColor, 0};
+}
+
+ij::DrawCommand ij::CreateRectangleCommand(const Vector2i &topLeft, const Vector2u &size, const Color outline,
+                                           const Color fill, const float outlineThickness)
+{
+    return DrawCommand{
+        DrawCommandType::Rectangle, SlotHandle(), topLeft, size, Vector2u(0, 0), outline, fill, outlineThickness};
+}
+
+ij::DrawCommand ij::CreateDotCommand(const Vector2i &position, const Color color)
+{
+    return DrawCommand{
+        DrawCommandType::Dot, SlotHandle(), position, Vector2u(0, 0), Vector2u(0, 0), color, noColor, 0};
+}
+
+ij::DrawCommand ij::CreateTextCommand(const TextId text)
+{
+    return DrawCommand{
+        DrawCommandType::Text, text, Vector2i(0, 0), Vector2u(0, 0), Vector2u(0, 0), noColor, noColor, 0};
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Canvas.h"
+#include <span>
+#include <type_traits>
+
+namespace ij
+{
+    enum class DrawCommandType : std::uint8_t
+    {
+        Sprite,
+        Rectangle,
+        Dot,
+        Text
+    };
+
+    // One primitive for Canvas::Submit. Which of the fields are used depends on the type.
+    struct DrawCommand final
+    {
+        DrawCommandType Type;
+        // the TextureId of a sprite or the TextId of a text
+        SlotHandle Handle;
+        // the top left corner of a sprite or rectangle or the position of a dot
+        Vector2i Position;
+        // of a sprite or rectangle
+        Vector2u Size;
+        Vector2u TextureTopLeft;
+        // the color multiplier of a sprite, the outline of a rectangle or the color of a dot
+        Color FirstColor;
+        // the fill of a rectangle
+        Color SecondColor;
+        float OutlineThickness;
+    };
+
+    static_assert(std::is_trivially_copyable_v<DrawCommand>);
+
+    [[nodiscard]] DrawCommand CreateSpriteCommand(const Sprite &sprite);
+    [[nodiscard]] DrawCommand CreateRectangleCommand(const Vector2i &topLeft, const Vector2u &size, Color outline,
+                                                     Color fill, float outlineThickness);
+    [[nodiscard]] DrawCommand CreateDotCommand(const Vector2i &position, Color color);
+    [[nodiscard]] DrawCommand CreateTextCommand(TextId text);
+
+    // Passes the commands to the functions for single primitives. Canvases which are final can use this in Submit,
+    // so that the calls are not virtual.
+    template <class CanvasType>
+    void SubmitOneByOne(CanvasType &canvas, const std::span<const DrawCommand> commands)
+    {
+        for (const DrawCommand &command : commands)
+        {
+            switch (command.Type)
+            {
+            case DrawCommandType::Sprite:
+                canvas.CanvasType::DrawSprite(Sprite(TextureId(command.Handle), command.Position, command.FirstColor,
+                                                     command.TextureTopLeft, command.Size));
+                break;
+            case DrawCommandType::Rectangle:
+                canvas.CanvasType::DrawRectangle(command.Position, command.Size, command.FirstColor,
+                                                 command.SecondColor, command.OutlineThickness);
+                break;
+            case DrawCommandType::Dot:
+                canvas.CanvasType::DrawDot(command.Position, command.FirstColor);
+                break;
+            case DrawCommandType::Text:
+                canvas.CanvasType::DrawText(command.Handle);
+                break;
+            }
+        }
+    }
+} // namespace ij
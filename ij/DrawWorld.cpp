@@ -1,6 +1,9 @@
 #include "DrawWorld.h"
 #include "Camera.h"
 #include "Input.h"
+#include "TileChunks.h"
+#include <algorithm>
+#include <charconv>
 
 namespace ij
 {
@@ -11,133 +14,240 @@ namespace ij
             return Vector2i(RoundDown<Int32>(position.x / TileSize), RoundDown<Int32>(position.y / TileSize));
         }
 
-        float bottomOfSprite(const Sprite &sprite)
+        // identifies the sprites in WorldPresentation::SpriteOrder
+        constexpr UInt64 playerObject = 0;
+
+        [[nodiscard]] UInt64 getEnemyObject(const size_t enemy)
+        {
+            return (AssertCast<UInt64>(enemy) + 1);
+        }
+
+        [[nodiscard]] Int32 bottomOfSprite(const Sprite &sprite)
         {
-            return (AssertCast<float>(sprite.Position.y) + AssertCast<float>(sprite.TextureSize.y));
+            return (sprite.Position.y + AssertCast<Int32>(sprite.TextureSize.y));
         }
 
-        void drawHealthBar(Canvas &canvas, const Object &object)
+        void drawHealthBar(std::vector<DrawCommand> &drawCommands, const Vector2f &position, const Vector2f &direction,
+                           const VisualEntity &visuals, const Health currentHealth, const Health maximumHealth)
         {
-            if (object.Logic.GetCurrentHealth() == object.Logic.GetMaximumHealth())
+            if (currentHealth == maximumHealth)
             {
                 return;
             }
             constexpr UInt32 width = 24;
             constexpr UInt32 height = 4;
-            const Int32 x = RoundDown<Int32>(object.Logic.Position.x) - AssertCast<Int32>(width / 2);
-            const Int32 y = RoundDown<Int32>(object.Logic.Position.y) -
-                            AssertCast<Int32>(object.Visuals.GetTextureRect(object.Logic.Direction).Size.y);
-            const UInt32 greenPortion =
-                RoundDown<UInt32>(AssertCast<float>(object.Logic.GetCurrentHealth()) /
-                                  AssertCast<float>(object.Logic.GetMaximumHealth()) * AssertCast<float>(width));
+            const Int32 x = RoundDown<Int32>(position.x) - AssertCast<Int32>(width / 2);
+            const Int32 y =
+                RoundDown<Int32>(position.y) - AssertCast<Int32>(visuals.GetTextureRect(direction).Size.y);
+            const UInt32 greenPortion = RoundDown<UInt32>(AssertCast<float>(currentHealth) /
+                                                          AssertCast<float>(maximumHealth) * AssertCast<float>(width));
             const Color green(0, 255, 0, 255);
-            canvas.DrawRectangle(Vector2i(x, y), Vector2u(greenPortion, height), green, green, 1);
+            drawCommands.push_back(
+                CreateRectangleCommand(Vector2i(x, y), Vector2u(greenPortion, height), green, green, 1));
             const Color red(255, 0, 0, 255);
-            canvas.DrawRectangle(Vector2i(x + AssertCast<Int32>(greenPortion), y),
-                                 Vector2u((width - greenPortion), height), red, red, 1);
+            drawCommands.push_back(CreateRectangleCommand(Vector2i(x + AssertCast<Int32>(greenPortion), y),
+                                                          Vector2u((width - greenPortion), height), red, red, 1));
+        }
+
+        void createDamageTexts(Canvas &canvas, const RenderSnapshot &snapshot, WorldPresentation &presentation)
+        {
+            constexpr size_t floatingTextLimit = 1000;
+            std::vector<FloatingText> &texts = presentation.FloatingTexts;
+            const auto createText = [&canvas, &snapshot, &texts](const SimulationEvent &event) {
+                if (event.Type != SimulationEventType::Damage)
+                {
+                    return;
+                }
+                // only the look depends on these numbers, so they do not have to come from the simulation
+                CounterBasedRandomNumberGenerator random(snapshot.SimulationSeed, event.Tick, event.Entity);
+                if (texts.size() >= floatingTextLimit)
+                {
+                    const size_t erased = random.GenerateSize(0, (texts.size() - 1));
+                    texts[erased] = std::move(texts.back());
+                    texts.pop_back();
+                }
+                // formatted without allocating memory
+                std::array<char, 12> digits = {};
+                const std::to_chars_result formatted =
+                    std::to_chars(digits.data(), (digits.data() + digits.size()), event.Amount);
+                assert(formatted.ec == std::errc());
+                texts.emplace_back(canvas,
+                                   std::string_view(digits.data(), AssertCast<size_t>(formatted.ptr - digits.data())),
+                                   event.Position, snapshot.Font, random);
+            };
+            (void)snapshot.Events.Consume(presentation.EventsShownAsText, createText);
+        }
+
+        // the texts stay where they are in the world when an infinite world moves the map, see ReplaceMap
+        void followShiftOfWorld(const RenderSnapshot &snapshot, WorldPresentation &presentation)
+        {
+            const Vector2f shift = (snapshot.TotalShift - presentation.TotalShift);
+            if ((shift.x == 0) && (shift.y == 0))
+            {
+                return;
+            }
+            for (FloatingText &text : presentation.FloatingTexts)
+            {
+                text.VisualItem.SetPosition(text.VisualItem.GetPosition() + shift);
+            }
+            presentation.TotalShift = snapshot.TotalShift;
         }
     } // namespace
 } // namespace ij
 
-void ij::DrawWorld(Canvas &canvas, const Camera &camera, const Input &input, Debugging &debugging, World &world,
-                   Object &player, const TextureId grassTexture, const TimeSpan timeSinceLastDraw)
+ij::WorldPresentation::WorldPresentation(const RenderSnapshot &firstSnapshot)
+    : EventsShownAsText(firstSnapshot.Events.GetEnd())
+    , TotalShift(firstSnapshot.TotalShift)
+{
+}
+
+void ij::DrawWorld(Canvas &canvas, const Camera &camera, const Input &input, Debugging &debugging,
+                   const RenderSnapshot &snapshot, const float interpolation, WorldPresentation &presentation,
+                   const TextureId grassTexture, const TimeSpan timeSinceLastDraw,
+                   std::vector<DrawCommand> &drawCommands)
 {
+    drawCommands.clear();
     const Vector2u windowSize = canvas.GetSize();
     const Vector2i topLeft = findTileByCoordinates(camera.getWorldFromScreenCoordinates(windowSize, Vector2i(0, 0)));
     const Vector2i bottomRight =
         findTileByCoordinates(camera.getWorldFromScreenCoordinates(windowSize, AssertCastVector<Int32>(windowSize)));
 
     debugging.tilesDrawnLastFrame = 0;
-    for (size_t y = AssertCast<size_t>((std::max)(0, topLeft.y)),
-                yStop = AssertCast<size_t>(
-                    (std::min<ptrdiff_t>)(bottomRight.y, AssertCast<ptrdiff_t>(world.map.GetHeight() - 1)));
-         y <= yStop; ++y)
+    debugging.TileChunksDrawnLastFrame = 0;
+    debugging.TileChunkHitsLastFrame = 0;
+    TileChunkRenderer *const tileChunks = canvas.GetTileChunkRenderer();
+    const Map &map = snapshot.map;
+    const size_t firstX = AssertCast<size_t>((std::max)(0, topLeft.x));
+    const size_t firstY = AssertCast<size_t>((std::max)(0, topLeft.y));
+    const size_t lastX =
+        AssertCast<size_t>((std::min<ptrdiff_t>)(bottomRight.x, AssertCast<ptrdiff_t>(map.Width - 1)));
+    const size_t lastY =
+        AssertCast<size_t>((std::min<ptrdiff_t>)(bottomRight.y, AssertCast<ptrdiff_t>(map.GetHeight() - 1)));
+    for (size_t chunkY = (firstY / Map::ChunkSize); (firstY <= lastY) && (chunkY <= (lastY / Map::ChunkSize));
+         ++chunkY)
     {
-        for (size_t x = AssertCast<size_t>((std::max)(0, topLeft.x)),
-                    xStop = AssertCast<size_t>(
-                        (std::min<ptrdiff_t>)(bottomRight.x, AssertCast<ptrdiff_t>(world.map.Width - 1)));
-             x <= xStop; ++x)
+        for (size_t chunkX = (firstX / Map::ChunkSize); (firstX <= lastX) && (chunkX <= (lastX / Map::ChunkSize));
+             ++chunkX)
         {
-            const int tile = world.map.GetTileAt(x, y);
-            if (tile == NoTile)
+            const std::span<const Tile, Map::TilesPerChunk> chunk = map.GetChunk(chunkX, chunkY);
+            if (map.IsChunkUniform(chunkX, chunkY) && (chunk[0] == NoTile))
             {
                 continue;
             }
-            canvas.DrawSprite(Sprite(grassTexture,
-                                     Vector2i(AssertCast<Int32>(x) * TileSize, AssertCast<Int32>(y) * TileSize),
-                                     Color(255, 255, 255, 255), Vector2u(AssertCast<UInt32>(tile) * TileSize, 160),
-                                     Vector2u(TileSize, TileSize)));
-            ++debugging.tilesDrawnLastFrame;
+            const size_t chunkLeft = (chunkX * Map::ChunkSize);
+            const size_t chunkTop = (chunkY * Map::ChunkSize);
+            if (tileChunks)
+            {
+                if (tileChunks->DrawTileChunk(chunk, grassTexture,
+                                              Vector2i(AssertCast<Int32>(chunkLeft) * TileSize,
+                                                       AssertCast<Int32>(chunkTop) * TileSize)))
+                {
+                    ++debugging.TileChunkHitsLastFrame;
+                }
+                ++debugging.TileChunksDrawnLastFrame;
+                continue;
+            }
+            for (size_t y = (std::max)(firstY, chunkTop), yStop = (std::min)(lastY, chunkTop + Map::ChunkSize - 1);
+                 y <= yStop; ++y)
+            {
+                for (size_t x = (std::max)(firstX, chunkLeft),
+                            xStop = (std::min)(lastX, chunkLeft + Map::ChunkSize - 1);
+                     x <= xStop; ++x)
+                {
+                    const Tile tile = chunk[((y - chunkTop) * Map::ChunkSize) + (x - chunkLeft)];
+                    if (tile == NoTile)
+                    {
+                        continue;
+                    }
+                    drawCommands.push_back(CreateSpriteCommand(
+                        CreateTileSprite(grassTexture, tile,
+                                         Vector2i(AssertCast<Int32>(x) * TileSize, AssertCast<Int32>(y) * TileSize))));
+                    ++debugging.tilesDrawnLastFrame;
+                }
+            }
         }
     }
 
-    std::vector<const Object *> visibleEnemies;
-    std::vector<Sprite> spritesToDrawInZOrder;
-    updateVisuals(player.Logic, player.Visuals, timeSinceLastDraw);
-    spritesToDrawInZOrder.emplace_back(CreateSpriteForVisualEntity(player.Logic, player.Visuals));
+    std::vector<VisibleEnemy> &visibleEnemies = presentation.VisibleEnemies;
+    visibleEnemies.clear();
+    std::vector<Sprite> &spritesToDrawInZOrder = presentation.SpritesToDrawInZOrder;
+    spritesToDrawInZOrder.clear();
+    const Vector2f playerPosition =
+        InterpolatePosition(snapshot.PlayerPreviousPosition, snapshot.PlayerPosition, interpolation);
+    spritesToDrawInZOrder.emplace_back(
+        CreateSpriteForVisualEntity(playerPosition, snapshot.PlayerDirection, snapshot.PlayerVisuals));
+    presentation.SpriteOrder.Add(playerObject, bottomOfSprite(spritesToDrawInZOrder.back()));
 
     debugging.enemiesDrawnLastFrame = 0;
-    for (Object &enemy : world.enemies)
+    for (const EnemySnapshot &enemy : snapshot.Enemies)
     {
-        updateVisuals(enemy.Logic, enemy.Visuals, timeSinceLastDraw);
-        Sprite sprite = CreateSpriteForVisualEntity(enemy.Logic, enemy.Visuals);
-        if (camera.canSee(windowSize, enemy.Logic.Position, enemy.Visuals))
+        const Vector2f position = InterpolatePosition(enemy.PreviousPosition, enemy.Position, interpolation);
+        if (camera.canSee(windowSize, position, enemy.Visuals))
         {
-            visibleEnemies.push_back(&enemy);
-            spritesToDrawInZOrder.emplace_back(sprite);
+            visibleEnemies.push_back(VisibleEnemy{&enemy, position});
+            spritesToDrawInZOrder.emplace_back(CreateSpriteForVisualEntity(position, enemy.Direction, enemy.Visuals));
+            // the snapshot has the enemies in ascending order
+            presentation.SpriteOrder.Add(getEnemyObject(enemy.Index), bottomOfSprite(spritesToDrawInZOrder.back()));
             ++debugging.enemiesDrawnLastFrame;
         }
     }
 
-    for (size_t i = 0; i < world.FloatingTexts.size();)
+    followShiftOfWorld(snapshot, presentation);
+    createDamageTexts(canvas, snapshot, presentation);
+    std::vector<FloatingText> &floatingTexts = presentation.FloatingTexts;
+    for (size_t i = 0; i < floatingTexts.size();)
     {
-        world.FloatingTexts[i].Update(timeSinceLastDraw);
-        if (world.FloatingTexts[i].HasExpired())
+        floatingTexts[i].Update(timeSinceLastDraw);
+        if (floatingTexts[i].HasExpired())
         {
-            if ((i + 1) < world.FloatingTexts.size())
+            if ((i + 1) < floatingTexts.size())
             {
-                world.FloatingTexts[i] = std::move(world.FloatingTexts.back());
+                floatingTexts[i] = std::move(floatingTexts.back());
             }
-            world.FloatingTexts.pop_back();
+            floatingTexts.pop_back();
         }
         else
         {
             ++i;
         }
     }
+    debugging.FloatingTextsLastFrame = floatingTexts.size();
 
-    std::ranges::sort(spritesToDrawInZOrder, [](const Sprite &left, const Sprite &right) -> bool {
-        return (bottomOfSprite(left) < bottomOfSprite(right));
-    });
-    for (const Sprite &sprite : spritesToDrawInZOrder)
+    for (const UInt32 sprite : presentation.SpriteOrder.Sort())
     {
-        canvas.DrawSprite(sprite);
+        drawCommands.push_back(CreateSpriteCommand(spritesToDrawInZOrder[sprite]));
     }
+    debugging.SpriteOrder = presentation.SpriteOrder.Statistics;
 
-    for (FloatingText &floatingText : world.FloatingTexts)
+    for (const FloatingText &floatingText : floatingTexts)
     {
-        floatingText.VisualItem.Draw();
+        drawCommands.push_back(CreateTextCommand(floatingText.VisualItem.GetId()));
     }
 
-    drawHealthBar(canvas, player);
-    for (const Object *const enemy : visibleEnemies)
+    drawHealthBar(drawCommands, playerPosition, snapshot.PlayerDirection, snapshot.PlayerVisuals,
+                  snapshot.PlayerCurrentHealth, snapshot.PlayerMaximumHealth);
+    for (const VisibleEnemy &enemy : visibleEnemies)
     {
-        drawHealthBar(canvas, *enemy);
+        drawHealthBar(drawCommands, enemy.Position, enemy.Snapshot->Direction, enemy.Snapshot->Visuals,
+                      enemy.Snapshot->CurrentHealth, enemy.Snapshot->MaximumHealth);
     }
 
     if (input.isDebugModeOn)
     {
-        canvas.DrawDot(RoundDown<Int32>(player.Logic.Position), Color(0, 255, 0, 255));
+        drawCommands.push_back(CreateDotCommand(RoundDown<Int32>(playerPosition), Color(0, 255, 0, 255)));
 
-        for (const Object *const enemy : visibleEnemies)
+        for (const VisibleEnemy &enemy : visibleEnemies)
         {
-            canvas.DrawDot(RoundDown<Int32>(enemy->Logic.Position), Color(255, 0, 0, 255));
+            drawCommands.push_back(CreateDotCommand(RoundDown<Int32>(enemy.Position), Color(255, 0, 0, 255)));
 
-            if (enemy == input.selectedEnemy)
+            if (enemy.Snapshot->Index == input.selectedEnemy)
             {
-                canvas.DrawRectangle(RoundDown<Int32>(enemy->Visuals.GetTopLeftPosition(enemy->Logic.Position)),
-                                     enemy->Visuals.SpriteSize, Color(255, 255, 255, 255), Color(0, 0, 0, 0), 1);
+                const VisualEntity &visuals = enemy.Snapshot->Visuals;
+                drawCommands.push_back(
+                    CreateRectangleCommand(RoundDown<Int32>(visuals.GetTopLeftPosition(enemy.Position)),
+                                           visuals.SpriteSize, Color(255, 255, 255, 255), Color(0, 0, 0, 0), 1));
             }
         }
     }
+    canvas.Submit(drawCommands);
 }
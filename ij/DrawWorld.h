@@ -1,6 +1,12 @@
 #pragma once
+#include "DepthOrder.h"
+#include "DrawCommand.h"
+#include "FloatingText.h"
+#include "RenderSnapshot.h"
+#include "Sprite.h"
 #include "World.h"
 #include <array>
+#include <vector>
 
 namespace ij
 {
@@ -11,12 +17,56 @@ namespace ij
     struct Debugging
     {
         size_t enemiesDrawnLastFrame = 0;
+        // tiles which were drawn one by one, which only happens when the canvas has no TileChunkRenderer
         size_t tilesDrawnLastFrame = 0;
+        size_t TileChunksDrawnLastFrame = 0;
+        // chunks which did not have to be drawn into a texture first
+        size_t TileChunkHitsLastFrame = 0;
+        size_t FloatingTextsLastFrame = 0;
+        // of WorldPresentation::SpriteOrder
+        DepthOrderStatistics SpriteOrder;
+        // by the canvas for the world, without the user interface
+        UInt64 DrawCallsLastFrame = 0;
         std::array<float, 5 *FrameRate> FrameTimes = {};
         size_t NextFrameTime = 0;
         bool IsZoomedOut = false;
+        // position in RenderSnapshot::Events
+        UInt64 EventsCounted = 0;
+        SimulationEventCounts EventsLastFrame;
     };
 
-    void DrawWorld(Canvas &canvas, const Camera &camera, const Input &input, Debugging &debugging, World &world,
-                   Object &player, const TextureId grassTexture, const TimeSpan timeSinceLastDraw);
+    struct VisibleEnemy final
+    {
+        const EnemySnapshot *Snapshot;
+        // where the enemy is drawn in this frame
+        Vector2f Position;
+    };
+
+    // What is drawn from frame to frame without being part of the simulation.
+    struct WorldPresentation final
+    {
+        // created from the damage events
+        std::vector<FloatingText> FloatingTexts;
+        // position in RenderSnapshot::Events
+        UInt64 EventsShownAsText;
+        // RenderSnapshot::TotalShift when the floating texts were last moved along with the world
+        Vector2f TotalShift;
+        // the player and the visible enemies from the lowest bottom edge of their sprites to the highest
+        DepthOrder SpriteOrder;
+        // buffers for a single frame which are reused so that drawing does not allocate memory
+        std::vector<VisibleEnemy> VisibleEnemies;
+        // indexed by the elements of SpriteOrder
+        std::vector<Sprite> SpritesToDrawInZOrder;
+
+        // starts after the events which already happened before the first snapshot
+        explicit WorldPresentation(const RenderSnapshot &firstSnapshot);
+    };
+
+    // Records what is visible into drawCommands and submits them to the canvas at once. drawCommands is only a buffer
+    // which is reused from frame to frame, so that recording does not allocate memory. The player and the enemies are
+    // drawn between their positions before and after the last tick, see InterpolatePosition.
+    void DrawWorld(Canvas &canvas, const Camera &camera, const Input &input, Debugging &debugging,
+                   const RenderSnapshot &snapshot, float interpolation, WorldPresentation &presentation,
+                   const TextureId grassTexture, const TimeSpan timeSinceLastDraw,
+                   std::vector<DrawCommand> &drawCommands);
 } // namespace ij
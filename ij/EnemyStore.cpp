@@ -0,0 +1,94 @@
+#include "EnemyStore.h"
+
+namespace ij
+{
+    namespace
+    {
+        template <class T>
+        void removeElements(std::vector<T> &elements, const std::span<const std::uint8_t> isRemoved)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < elements.size(); ++i)
+            {
+                if (!isRemoved[i])
+                {
+                    elements[kept] = std::move(elements[i]);
+                    ++kept;
+                }
+            }
+            elements.erase(elements.begin() + AssertCast<ptrdiff_t>(kept), elements.end());
+        }
+    } // namespace
+} // namespace ij
+
+void ij::EnemyStore::Add(const VisualEntity &visuals, const Vector2f &position, const Vector2f &direction,
+                         const Health currentHealth, const Health maximumHealth, const ObjectActivity activity)
+{
+    Positions.push_back(position);
+    PreviousPositions.push_back(position);
+    Directions.push_back(direction);
+    CurrentHealth.push_back(currentHealth);
+    MaximumHealth.push_back(maximumHealth);
+    Activities.push_back(activity);
+    HasBumpedIntoWall.push_back(false);
+    Bots.emplace_back();
+    SimulatedTicks.push_back(0);
+    Visuals.push_back(visuals);
+    IsDirty.push_back(true);
+}
+
+size_t ij::EnemyStore::GetCount() const
+{
+    return Positions.size();
+}
+
+bool ij::EnemyStore::IsDead(const size_t enemy) const
+{
+    return (CurrentHealth[enemy] == 0);
+}
+
+void ij::EnemyStore::SetActivity(const size_t enemy, const ObjectActivity activity)
+{
+    if (IsDead(enemy))
+    {
+        Activities[enemy] = ObjectActivity::Dead;
+        return;
+    }
+    Activities[enemy] = activity;
+}
+
+bool ij::EnemyStore::InflictDamage(const size_t enemy, const Health damage)
+{
+    Health &health = CurrentHealth[enemy];
+    if (health == 0)
+    {
+        return false;
+    }
+    IsDirty[enemy] = true;
+    health -= damage;
+    if (health < 0)
+    {
+        health = 0;
+    }
+    if (IsDead(enemy))
+    {
+        SetActivity(enemy, ObjectActivity::Dead);
+    }
+    return true;
+}
+
+void ij::EnemyStore::Remove(const std::span<const std::uint8_t> isRemoved)
+{
+    assert(isRemoved.size() == GetCount());
+    removeElements(Positions, isRemoved);
+    removeElements(PreviousPositions, isRemoved);
+    removeElements(Directions, isRemoved);
+    removeElements(CurrentHealth, isRemoved);
+    removeElements(MaximumHealth, isRemoved);
+    removeElements(Activities, isRemoved);
+    removeElements(HasBumpedIntoWall, isRemoved);
+    removeElements(Bots, isRemoved);
+    removeElements(SimulatedTicks, isRemoved);
+    removeElements(Visuals, isRemoved);
+    removeElements(IsDirty, isRemoved);
+}
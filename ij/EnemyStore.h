@@ -0,0 +1,41 @@
+#pragma once
+#include "Bot.h"
+#include "VisualEntity.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ij
+{
+    // All enemies as a structure of arrays. The simulation loops only touch the arrays they need and walk through them
+    // linearly. An enemy is identified by its index which only changes when enemies are removed.
+    struct EnemyStore final
+    {
+        std::vector<Vector2f> Positions;
+        // the positions before the last update of each enemy, for drawing between the ticks. Only valid when
+        // SimulatedTicks is the current tick because mid range and dormant enemies are not updated every tick.
+        std::vector<Vector2f> PreviousPositions;
+        std::vector<Vector2f> Directions;
+        std::vector<Health> CurrentHealth;
+        std::vector<Health> MaximumHealth;
+        std::vector<ObjectActivity> Activities;
+        // not std::vector<bool> so that the elements can be written independently from each other
+        std::vector<std::uint8_t> HasBumpedIntoWall;
+        std::vector<Bot> Bots;
+        // how far an enemy has been simulated, see World::SimulatedTicks. Far away enemies are not updated every tick.
+        std::vector<UInt64> SimulatedTicks;
+        std::vector<VisualEntity> Visuals;
+        // Set whenever the saved state of an enemy may have changed, cleared by TakeSaveGameSnapshot. Dormant enemies
+        // stay clean, so a save only has to copy the enemies near the player.
+        std::vector<std::uint8_t> IsDirty;
+
+        void Add(const VisualEntity &visuals, const Vector2f &position, const Vector2f &direction, Health currentHealth,
+                 Health maximumHealth, ObjectActivity activity);
+        [[nodiscard]] size_t GetCount() const;
+        [[nodiscard]] bool IsDead(size_t enemy) const;
+        void SetActivity(size_t enemy, ObjectActivity activity);
+        [[nodiscard]] bool InflictDamage(size_t enemy, Health damage);
+        // removes the enemies for which isRemoved is set and keeps the order of the others
+        void Remove(std::span<const std::uint8_t> isRemoved);
+    };
+} // namespace ij
@@ -23,6 +23,8 @@ namespace ij
     };
 
     std::optional<std::vector<EnemyTemplate>> LoadEnemies(TextureLoader &textures, const std::filesystem::path &assets);
+    void SpawnEnemy(World &world, const EnemyTemplate &enemyTemplate, const Vector2f &position,
+                    const Vector2f &direction);
     void SpawnEnemies(World &world, size_t numberOfEnemies, const std::vector<EnemyTemplate> &enemies,
                       RandomNumberGenerator &randomNumberGenerator);
 } // namespace ij
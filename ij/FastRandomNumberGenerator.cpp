@@ -0,0 +1,90 @@
+#include "FastRandomNumberGenerator.h"
+#include <algorithm>
+
+namespace ij
+{
+    namespace
+    {
+        // the recommended way to initialize the state of xoshiro from a single number
+        [[nodiscard]] UInt64 generateSplitMix64(UInt64 &state) noexcept
+        {
+            state += 0x9e3779b97f4a7c15u;
+            return MixBits(state);
+        }
+    } // namespace
+} // namespace ij
+
+ij::Xoshiro256::Xoshiro256(UInt64 seed) noexcept
+{
+    for (UInt64 &element : _state)
+    {
+        element = generateSplitMix64(seed);
+    }
+}
+
+size_t ij::Xoshiro256::GenerateSize(const size_t minimum, const size_t maximum) noexcept
+{
+    assert(minimum <= maximum);
+    const UInt64 range = AssertCast<UInt64>(maximum - minimum) + 1;
+    const UInt64 generated = GenerateUInt64();
+    if (range == 0)
+    {
+        // the whole range of UInt64
+        return AssertCast<size_t>(generated);
+    }
+    return (minimum + AssertCast<size_t>(generated % range));
+}
+
+ij::BatchRandomNumberGenerator::BatchRandomNumberGenerator(UInt64 seed) noexcept
+{
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        for (std::array<UInt64, Lanes> &element : _state)
+        {
+            element[lane] = generateSplitMix64(seed);
+        }
+    }
+}
+
+void ij::BatchRandomNumberGenerator::FillInt32(const std::span<Int32> destination, const Int32 minimum,
+                                               const Int32 maximum) noexcept
+{
+    assert(minimum <= maximum);
+    const UInt64 range = static_cast<UInt64>(static_cast<Int64>(maximum) - minimum) + 1;
+    // local copies so that the compiler knows that the output does not overlap with the state
+    std::array<UInt64, Lanes> s0 = _state[0];
+    std::array<UInt64, Lanes> s1 = _state[1];
+    std::array<UInt64, Lanes> s2 = _state[2];
+    std::array<UInt64, Lanes> s3 = _state[3];
+    const auto step = [&](Int32 *const output) {
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            // xoshiro256+ has no multiplication which SIMD instruction sets lack for 64 bit integers. Its lowest bits
+            // are weak, but only the upper half is used.
+            const UInt64 result = (s0[lane] + s3[lane]);
+            const UInt64 shifted = (s1[lane] << 17u);
+            s2[lane] ^= s0[lane];
+            s3[lane] ^= s1[lane];
+            s1[lane] ^= s2[lane];
+            s0[lane] ^= s3[lane];
+            s2[lane] ^= shifted;
+            s3[lane] = RotateLeft(s3[lane], 45);
+            // same as ScaleToInt32, but written as a 32 by 32 bit multiplication which SIMD instruction sets have
+            const UInt64 offset = ((static_cast<UInt64>(static_cast<UInt32>(result >> 32u)) * range) >> 32u);
+            output[lane] = static_cast<Int32>(static_cast<UInt32>(minimum) + static_cast<UInt32>(offset));
+        }
+    };
+    const size_t fullSteps = (destination.size() / Lanes);
+    for (size_t i = 0; i < fullSteps; ++i)
+    {
+        step(destination.data() + (i * Lanes));
+    }
+    const size_t rest = (destination.size() % Lanes);
+    if (rest > 0)
+    {
+        std::array<Int32, Lanes> last;
+        step(last.data());
+        std::copy_n(last.begin(), rest, destination.end() - AssertCast<std::ptrdiff_t>(rest));
+    }
+    _state = {s0, s1, s2, s3};
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "RandomNumberGenerator.h"
+#include <array>
+#include <span>
+
+namespace ij
+{
+    [[nodiscard]] constexpr UInt64 RotateLeft(const UInt64 value, const unsigned bits) noexcept
+    {
+        return ((value << bits) | (value >> (64u - bits)));
+    }
+
+    // xoshiro256++ by Blackman and Vigna. Much faster than std::default_random_engine with
+    // std::uniform_int_distribution and cheap enough to be called for every entity. Not virtual; use
+    // RandomNumberGeneratorAdapter where the interface is needed.
+    struct Xoshiro256 final
+    {
+        explicit Xoshiro256(UInt64 seed) noexcept;
+
+        [[nodiscard]] UInt64 GenerateUInt64() noexcept
+        {
+            const UInt64 result = RotateLeft(_state[0] + _state[3], 23) + _state[0];
+            const UInt64 shifted = (_state[1] << 17u);
+            _state[2] ^= _state[0];
+            _state[3] ^= _state[1];
+            _state[1] ^= _state[2];
+            _state[0] ^= _state[3];
+            _state[2] ^= shifted;
+            _state[3] = RotateLeft(_state[3], 45);
+            return result;
+        }
+
+        [[nodiscard]] Int32 GenerateInt32(const Int32 minimum, const Int32 maximum) noexcept
+        {
+            assert(minimum <= maximum);
+            return ScaleToInt32(GenerateUInt64(), minimum, maximum);
+        }
+
+        [[nodiscard]] size_t GenerateSize(size_t minimum, size_t maximum) noexcept;
+
+    private:
+        std::array<UInt64, 4> _state;
+    };
+
+    // Several independent xoshiro256+ generators which advance in lock step. Each step of the loop over the lanes does
+    // the same operations on separate state, so the compiler turns it into SIMD instructions without any intrinsics.
+    // Use this when a lot of numbers are needed at once, for example to generate a map.
+    struct BatchRandomNumberGenerator final
+    {
+        static constexpr size_t Lanes = 8;
+
+        explicit BatchRandomNumberGenerator(UInt64 seed) noexcept;
+
+        // The numbers depend on how the output is divided into calls because unused lanes of the last step are
+        // discarded.
+        void FillInt32(std::span<Int32> destination, Int32 minimum, Int32 maximum) noexcept;
+
+    private:
+        // structure of arrays for the vectorizer
+        std::array<std::array<UInt64, Lanes>, 4> _state;
+    };
+
+    // Makes a non-virtual generator usable as a RandomNumberGenerator, for example in code which is also called with
+    // StandardRandomNumberGenerator from tests.
+    template <class Generator>
+    struct RandomNumberGeneratorAdapter final : RandomNumberGenerator
+    {
+        Generator Engine;
+
+        explicit RandomNumberGeneratorAdapter(const UInt64 seed) noexcept
+            : Engine(seed)
+        {
+        }
+
+        Int32 GenerateInt32(const Int32 minimum, const Int32 maximum) override
+        {
+            return Engine.GenerateInt32(minimum, maximum);
+        }
+
+        size_t GenerateSize(const size_t minimum, const size_t maximum) override
+        {
+            return Engine.GenerateSize(minimum, maximum);
+        }
+    };
+
+    using FastRandomNumberGenerator = RandomNumberGeneratorAdapter<Xoshiro256>;
+} // namespace ij
@@ -1,7 +1,7 @@
 #include "FloatingText.h"
 #include "AssertCast.h"
 
-ij::FloatingText::FloatingText(Canvas &canvas, const std::string &text, const Vector2f &position, FontId font,
+ij::FloatingText::FloatingText(Canvas &canvas, const std::string_view text, const Vector2f &position, FontId font,
                                RandomNumberGenerator &random)
     : VisualItem(canvas.CreateText(text, font,
                                    position + Vector2f(AssertCast<float>(20 - random.GenerateInt32(0, 39)),
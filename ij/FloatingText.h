@@ -11,7 +11,7 @@ namespace ij
         TimeSpan Age;
         TimeSpan MaxAge;
 
-        explicit FloatingText(Canvas &canvas, const std::string &text, const Vector2f &position, FontId font,
+        explicit FloatingText(Canvas &canvas, std::string_view text, const Vector2f &position, FontId font,
                               RandomNumberGenerator &random);
         void Update(TimeSpan deltaTime);
         [[nodiscard]] bool HasExpired() const;
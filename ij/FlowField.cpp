@@ -0,0 +1,189 @@
+#include "FlowField.h"
+#include "Normalize.h"
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace ij
+{
+    namespace
+    {
+        struct Step final
+        {
+            Int32 X;
+            Int32 Y;
+            UInt32 Cost;
+        };
+
+        // the opposite of a step is the step with the index ^ 1
+        constexpr std::array<Step, 8> steps = {Step{1, 0, 10},   Step{-1, 0, 10}, Step{0, 1, 10},  Step{0, -1, 10},
+                                               Step{1, 1, 14},   Step{-1, -1, 14}, Step{1, -1, 14}, Step{-1, 1, 14}};
+        constexpr std::uint8_t noStep = steps.size();
+        constexpr UInt32 unreachable = (std::numeric_limits<UInt32>::max)();
+        static_assert(FlowField::MaximumStepCost == 14);
+
+        [[nodiscard]] Int32 toTile(const float pixel)
+        {
+            return static_cast<Int32>(std::floor(pixel / TileSize));
+        }
+
+        [[nodiscard]] float toTileCenter(const Int32 tile)
+        {
+            return ((AssertCast<float>(tile) + 0.5f) * TileSize);
+        }
+    } // namespace
+} // namespace ij
+
+ij::FlowField::FlowField(const size_t radius)
+    : _radius(AssertCast<Int32>(radius))
+    , _side((2 * radius) + 1)
+    , _costs(_side * _side, unreachable)
+    , _next(_side * _side, noStep)
+{
+}
+
+bool ij::FlowField::Update(const WalkabilityMap &walkability, const Vector2f &goal)
+{
+    const Int32 goalColumn = toTile(goal.x);
+    const Int32 goalRow = toTile(goal.y);
+    if (_isValid && (goalColumn == _goalColumn) && (goalRow == _goalRow))
+    {
+        return false;
+    }
+    _isValid = true;
+    _goalColumn = goalColumn;
+    _goalRow = goalRow;
+
+    // looked up once per tile instead of once per neighbour
+    _isWalkable.resize(_costs.size());
+    const Int32 left = (goalColumn - _radius);
+    const Int32 top = (goalRow - _radius);
+    for (size_t row = 0; row < _side; ++row)
+    {
+        for (size_t column = 0; column < _side; ++column)
+        {
+            _isWalkable[(row * _side) + column] =
+                walkability.IsWalkablePoint(toTileCenter(left + AssertCast<Int32>(column)),
+                                            toTileCenter(top + AssertCast<Int32>(row)));
+        }
+    }
+
+    // Dijkstra from the goal outwards. The step which reaches a tile with the lowest cost is the opposite of the
+    // direction from that tile towards the goal. Steps cost at most MaximumStepCost, so a ring of buckets indexed by
+    // the cost works as the priority queue.
+    std::ranges::fill(_costs, unreachable);
+    std::ranges::fill(_next, noStep);
+    for (std::vector<UInt32> &bucket : _buckets)
+    {
+        bucket.clear();
+    }
+    const size_t goalIndex = ((AssertCast<size_t>(_radius) * _side) + AssertCast<size_t>(_radius));
+    _costs[goalIndex] = 0;
+    _buckets[0].push_back(AssertCast<UInt32>(goalIndex));
+    size_t queued = 1;
+    const Int32 side = AssertCast<Int32>(_side);
+    const auto isWalkable = [this, side](const Int32 column, const Int32 row) {
+        return (column >= 0) && (row >= 0) && (column < side) && (row < side) &&
+               _isWalkable[AssertCast<size_t>((row * side) + column)];
+    };
+    for (UInt32 cost = 0; queued > 0; ++cost)
+    {
+        std::vector<UInt32> &bucket = _buckets[cost % _buckets.size()];
+        // steps cost more than nothing and less than there are buckets, so this one does not grow in the loop
+        for (const UInt32 index : bucket)
+        {
+            --queued;
+            // a cheaper path was found after this one was queued
+            if (_costs[index] != cost)
+            {
+                continue;
+            }
+            const Int32 column = AssertCast<Int32>(index % _side);
+            const Int32 row = AssertCast<Int32>(index / _side);
+            for (size_t i = 0; i < steps.size(); ++i)
+            {
+                const Step &step = steps[i];
+                const Int32 neighbourColumn = (column + step.X);
+                const Int32 neighbourRow = (row + step.Y);
+                if (!isWalkable(neighbourColumn, neighbourRow))
+                {
+                    continue;
+                }
+                // diagonal steps would get stuck on the corner of a wall
+                if ((step.X != 0) && (step.Y != 0) &&
+                    (!isWalkable(neighbourColumn, row) || !isWalkable(column, neighbourRow)))
+                {
+                    continue;
+                }
+                const size_t neighbour = AssertCast<size_t>((neighbourRow * side) + neighbourColumn);
+                const UInt32 neighbourCost = (cost + step.Cost);
+                if (neighbourCost >= _costs[neighbour])
+                {
+                    continue;
+                }
+                _costs[neighbour] = neighbourCost;
+                _next[neighbour] = AssertCast<std::uint8_t>(i ^ 1u);
+                _buckets[neighbourCost % _buckets.size()].push_back(AssertCast<UInt32>(neighbour));
+                ++queued;
+            }
+        }
+        bucket.clear();
+    }
+    return true;
+}
+
+void ij::FlowField::Invalidate()
+{
+    _isValid = false;
+}
+
+std::optional<ij::Vector2f> ij::FlowField::GetDirection(const Vector2f &position) const
+{
+    const std::optional<FieldTile> tile = findTile(position);
+    if (!tile || (_next[tile->Index] == noStep))
+    {
+        return std::nullopt;
+    }
+    const Step &step = steps[_next[tile->Index]];
+    const Int32 column = (_goalColumn - _radius + tile->Column + step.X);
+    const Int32 row = (_goalRow - _radius + tile->Row + step.Y);
+    return normalize(Vector2f(toTileCenter(column), toTileCenter(row)) - position);
+}
+
+std::optional<ij::UInt32> ij::FlowField::GetCost(const Vector2f &position) const
+{
+    const std::optional<FieldTile> tile = findTile(position);
+    if (!tile || (_costs[tile->Index] == unreachable))
+    {
+        return std::nullopt;
+    }
+    return _costs[tile->Index];
+}
+
+std::optional<ij::FlowField::FieldTile> ij::FlowField::findTile(const Vector2f &position) const
+{
+    if (!_isValid)
+    {
+        return std::nullopt;
+    }
+    // in floating point so that positions far away can not overflow
+    constexpr float tilesPerPixel = (1.0f / TileSize);
+    const float column = ((position.x * tilesPerPixel) - AssertCast<float>(_goalColumn - _radius));
+    const float row = ((position.y * tilesPerPixel) - AssertCast<float>(_goalRow - _radius));
+    const float side = AssertCast<float>(_side);
+    if (!(column >= 0) || !(row >= 0) || !(column < side) || !(row < side))
+    {
+        return std::nullopt;
+    }
+    // truncating is rounding down for positive numbers
+    const Int32 wholeColumn = static_cast<Int32>(column);
+    const Int32 wholeRow = static_cast<Int32>(row);
+    return FieldTile{wholeColumn, wholeRow,
+                     ((static_cast<size_t>(wholeRow) * _side) + static_cast<size_t>(wholeColumn))};
+}
+
+size_t ij::GetFlowFieldRadius(const float distance)
+{
+    // the tile of a position within the distance can be one further away than the distance itself
+    return (static_cast<size_t>(std::ceil(distance / TileSize)) + 1);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "WalkabilityMap.h"
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace ij
+{
+    // Shortest paths from every tile in a square around a goal to the goal, shared by everything that wants to get
+    // there. The integration field holds the cost of the path from each tile, the direction field the next tile on it.
+    // Paths move to the eight neighbours of a tile, but never diagonally past the corner of a wall.
+    struct FlowField final
+    {
+        // of a diagonal step, a straight step costs 10
+        static constexpr UInt32 MaximumStepCost = 14;
+
+        // the field covers radius tiles in every direction from the goal
+        explicit FlowField(size_t radius);
+
+        // Recomputes the field if the goal is in a different tile than before and returns whether it did. Positions
+        // within the goal tile share the same field.
+        bool Update(const WalkabilityMap &walkability, const Vector2f &goal);
+        // the next Update recomputes the field, for example because the map changed
+        void Invalidate();
+        // Towards the center of the next tile on the path, normalized. Nothing if the position is in the goal tile,
+        // outside of the field or there is no path within the field.
+        [[nodiscard]] std::optional<Vector2f> GetDirection(const Vector2f &position) const;
+        // the length of the path to the goal in steps, weighted by their cost, nothing without a path
+        [[nodiscard]] std::optional<UInt32> GetCost(const Vector2f &position) const;
+
+    private:
+        const Int32 _radius;
+        const size_t _side;
+        bool _isValid = false;
+        Int32 _goalColumn = 0;
+        Int32 _goalRow = 0;
+        // integration field, row by row
+        std::vector<UInt32> _costs;
+        // direction field, indices into the neighbour offsets
+        std::vector<std::uint8_t> _next;
+        // of the square around the goal
+        std::vector<std::uint8_t> _isWalkable;
+        // the priority queue of the last update indexed by the cost modulo the size, kept for its memory
+        std::array<std::vector<UInt32>, (MaximumStepCost + 1)> _buckets;
+
+        struct FieldTile final
+        {
+            // relative to the top left corner of the square
+            Int32 Column;
+            Int32 Row;
+            // into the fields
+            size_t Index;
+        };
+
+        // nothing outside of the square
+        [[nodiscard]] std::optional<FieldTile> findTile(const Vector2f &position) const;
+    };
+
+    // the radius of a FlowField which covers every position within distance of the goal
+    [[nodiscard]] size_t GetFlowFieldRadius(float distance);
+} // namespace ij
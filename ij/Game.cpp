@@ -0,0 +1,104 @@
+#include "Game.h"
+#include "FastRandomNumberGenerator.h"
+#include "PlayerCharacter.h"
+#include <limits>
+
+namespace ij
+{
+    namespace
+    {
+        [[nodiscard]] UInt64 generateSimulationSeed(RandomNumberGenerator &random)
+        {
+            return AssertCast<UInt64>(random.GenerateSize(0, (std::numeric_limits<size_t>::max)()));
+        }
+
+        [[nodiscard]] size_t calculateNumberOfEnemies(const Map &map, const float enemiesPerTile)
+        {
+            return static_cast<size_t>(AssertCast<float>(map.GetNumberOfTiles()) * enemiesPerTile);
+        }
+
+        [[nodiscard]] std::unique_ptr<StreamedWorld> createStreaming(const GameSettings &settings,
+                                                                     const std::vector<EnemyTemplate> &enemies,
+                                                                     RandomNumberGenerator &random)
+        {
+            if (!settings.IsWorldInfinite)
+            {
+                return nullptr;
+            }
+            StreamingSettings streaming;
+            streaming.EnemiesPerTile = settings.EnemiesPerTile;
+            return std::make_unique<StreamedWorld>(generateSimulationSeed(random), streaming, enemies);
+        }
+
+        // the map has to be generated before the simulation seed
+        [[nodiscard]] World createWorld(const GameSettings &settings, std::optional<Map> map,
+                                        StreamedWorld *const streaming, RandomNumberGenerator &random)
+        {
+            if (streaming)
+            {
+                assert(!map);
+                map = streaming->CreateMap();
+            }
+            else if (!map)
+            {
+                map = GenerateRandomMap(random, settings.MapWidth, settings.MapHeight);
+            }
+            const UInt64 simulationSeed = generateSimulationSeed(random);
+            World world(0, std::move(*map), simulationSeed);
+            world.TimeStep = GetSimulationTimeStep(settings.TicksPerSecond);
+            return world;
+        }
+    } // namespace
+} // namespace ij
+
+ij::Game::Game(const GameSettings &settings, const std::vector<EnemyTemplate> &enemies, const TextureId playerTexture,
+               std::optional<Map> map)
+    : Game(settings, enemies, playerTexture, std::move(map), FastRandomNumberGenerator(settings.Seed))
+{
+}
+
+ij::Game::Game(const GameSettings &settings, const std::vector<EnemyTemplate> &enemies, const TextureId playerTexture,
+               std::optional<Map> map, RandomNumberGenerator &&random)
+    : Settings(settings)
+    , Streaming(createStreaming(settings, enemies, random))
+    , SimulatedWorld(createWorld(settings, std::move(map), Streaming.get(), random))
+    , Player(VisualEntity(playerTexture, Vector2u(64, 64), 0, TimeSpan::FromMilliseconds(0), CutWolfTexture,
+                          ObjectAnimation::Standing),
+             LogicEntity(std::make_unique<PlayerCharacter>(CurrentInput.isDirectionKeyPressed,
+                                                           CurrentInput.isAttackPressed),
+                         Vector2f(0, 0), Vector2f(0, 0), true, false, 100, 100, ObjectActivity::Standing))
+{
+    if (Streaming)
+    {
+        Streaming->SpawnAllEnemies(SimulatedWorld);
+    }
+    else
+    {
+        SpawnEnemies(SimulatedWorld, calculateNumberOfEnemies(SimulatedWorld.map, settings.EnemiesPerTile), enemies,
+                     random);
+    }
+    Player.Logic.Position = GenerateRandomPointForSpawning(SimulatedWorld, random);
+    Player.Logic.PreviousPosition = Player.Logic.Position;
+    if (Streaming)
+    {
+        // puts the player into the center
+        Streaming->Update(SimulatedWorld, Player.Logic, CurrentInput.selectedEnemy);
+    }
+}
+
+void ij::UpdateGame(Game &game, TimeSpan &remainingSimulationTime, WorkerPool &workers)
+{
+    if (!game.Streaming)
+    {
+        UpdateWorld(remainingSimulationTime, game.Player.Logic, game.SimulatedWorld, workers);
+        return;
+    }
+    const TimeSpan simulationTimeStep = game.SimulatedWorld.TimeStep;
+    while (remainingSimulationTime >= simulationTimeStep)
+    {
+        remainingSimulationTime -= simulationTimeStep;
+        TimeSpan tick = simulationTimeStep;
+        UpdateWorld(tick, game.Player.Logic, game.SimulatedWorld, workers);
+        game.Streaming->Update(game.SimulatedWorld, game.Player.Logic, game.CurrentInput.selectedEnemy);
+    }
+}
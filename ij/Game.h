@@ -0,0 +1,46 @@
+#pragma once
+#include "EnemyTemplate.h"
+#include "Input.h"
+#include "StreamedWorld.h"
+#include <memory>
+
+namespace ij
+{
+    // Everything needed to set up a game. The same settings always result in the same initial world.
+    struct GameSettings final
+    {
+        UInt32 Seed = 0;
+        size_t MapWidth = 500;
+        size_t MapHeight = 500;
+        float EnemiesPerTile = 0.02f;
+        // streams the world around the player instead of generating a map of MapWidth x MapHeight, see StreamedWorld
+        bool IsWorldInfinite = false;
+        // Fewer ticks save processor time. Drawing interpolates between the ticks, so the motion stays smooth.
+        unsigned TicksPerSecond = FrameRate;
+    };
+
+    // The simulated state of a game. Shared by the windowed game, the benchmark and the replay of input recordings.
+    struct Game final
+    {
+        const GameSettings Settings;
+        Input CurrentInput;
+        // only for infinite worlds
+        std::unique_ptr<StreamedWorld> Streaming;
+        World SimulatedWorld;
+        Object Player;
+
+        // A given map replaces the generated one, for example a map from LoadMapFile. MapWidth and MapHeight are
+        // ignored then.
+        Game(const GameSettings &settings, const std::vector<EnemyTemplate> &enemies, TextureId playerTexture,
+             std::optional<Map> map = std::nullopt);
+        Game(const Game &) = delete;
+        Game &operator=(const Game &) = delete;
+
+    private:
+        Game(const GameSettings &settings, const std::vector<EnemyTemplate> &enemies, TextureId playerTexture,
+             std::optional<Map> map, RandomNumberGenerator &&random);
+    };
+
+    // Like UpdateWorld, but also moves an infinite world along with the player after every tick.
+    void UpdateGame(Game &game, TimeSpan &remainingSimulationTime, WorkerPool &workers);
+} // namespace ij
@@ -0,0 +1,96 @@
+#include "GlyphAtlas.h"
+#include "AssertCast.h"
+#include <algorithm>
+
+namespace ij
+{
+    namespace
+    {
+        void appendQuad(const AtlasGlyph &glyph, const Vector2f &pen, const Color color,
+                        std::vector<TexturedVertex> &vertices)
+        {
+            if ((glyph.TextureSize.x == 0) || (glyph.TextureSize.y == 0))
+            {
+                return;
+            }
+            AppendQuad((pen + glyph.Offset), AssertCastVector<float>(glyph.TextureSize),
+                       AssertCastVector<float>(glyph.TextureTopLeft), color, vertices);
+        }
+    } // namespace
+} // namespace ij
+
+ij::PackedRectangles ij::PackRectangles(const std::span<const Vector2u> sizes, const UInt32 width)
+{
+    PackedRectangles packed;
+    packed.TopLeft.reserve(sizes.size());
+    UInt32 x = 1;
+    UInt32 y = 1;
+    UInt32 rowHeight = 0;
+    for (const Vector2u &size : sizes)
+    {
+        assert((size.x + 2) <= width);
+        if ((x + size.x + 1) > width)
+        {
+            x = 1;
+            y += (rowHeight + 1);
+            rowHeight = 0;
+        }
+        packed.TopLeft.emplace_back(x, y);
+        x += (size.x + 1);
+        rowHeight = (std::max)(rowHeight, size.y);
+    }
+    packed.Height = (y + rowHeight + 1);
+    return packed;
+}
+
+ij::TextId ij::AtlasTexts::Create(const std::string_view content, const Vector2f &position, const Color fillColor,
+                                  const Color outlineColor)
+{
+    Slot slot{{}, (std::min)(content.size(), MaximumAtlasTextLength), position, fillColor, outlineColor};
+    std::copy_n(content.begin(), slot.Length, slot.Characters.begin());
+    return _slots.Add(slot);
+}
+
+void ij::AtlasTexts::SetPosition(const TextId id, const Vector2f &position)
+{
+    _slots.Get(id).Position = position;
+}
+
+ij::Vector2f ij::AtlasTexts::GetPosition(const TextId id) const
+{
+    return _slots.Get(id).Position;
+}
+
+void ij::AtlasTexts::Delete(const TextId id)
+{
+    _slots.Remove(id);
+}
+
+void ij::AtlasTexts::AppendVertices(const TextId id, const GlyphAtlas &atlas,
+                                    std::vector<TexturedVertex> &vertices) const
+{
+    const Slot &slot = _slots.Get(id);
+    assert(atlas.Fills.size() == AtlasCharacterCount);
+    assert(atlas.Outlines.size() == AtlasCharacterCount);
+    assert(atlas.Advances.size() == AtlasCharacterCount);
+    const std::span<const char> characters(slot.Characters.data(), slot.Length);
+    const auto getGlyphIndex = [](const char character) {
+        // there is no glyph for the others
+        const char drawn = ((character >= FirstAtlasCharacter) && (character <= LastAtlasCharacter)) ? character : '?';
+        return AssertCast<size_t>(drawn - FirstAtlasCharacter);
+    };
+    Vector2f pen = slot.Position;
+    for (const char character : characters)
+    {
+        const size_t glyph = getGlyphIndex(character);
+        appendQuad(atlas.Outlines[glyph], pen, slot.OutlineColor, vertices);
+        pen.x += atlas.Advances[glyph];
+    }
+    pen = slot.Position;
+    for (const char character : characters)
+    {
+        const size_t glyph = getGlyphIndex(character);
+        appendQuad(atlas.Fills[glyph], pen, slot.FillColor, vertices);
+        pen.x += atlas.Advances[glyph];
+    }
+}
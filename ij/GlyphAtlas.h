@@ -0,0 +1,70 @@
+#pragma once
+#include "Canvas.h"
+#include "VertexBatch.h"
+#include <array>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ij
+{
+    // the characters which canvases rasterize into their glyph atlas, all the printable ASCII characters
+    constexpr char FirstAtlasCharacter = ' ';
+    constexpr char LastAtlasCharacter = '~';
+    constexpr size_t AtlasCharacterCount = ((LastAtlasCharacter - FirstAtlasCharacter) + 1);
+    // longer texts are cut off
+    constexpr size_t MaximumAtlasTextLength = 16;
+
+    struct AtlasGlyph final
+    {
+        // in pixels
+        Vector2u TextureTopLeft;
+        Vector2u TextureSize;
+        // from the pen position at the top of the line to the top left corner of the glyph
+        Vector2f Offset;
+    };
+
+    // Where the glyphs of one font and size are in an atlas texture. Outlines are separate glyphs which are drawn below
+    // the fills, so that both can be colored by the vertices. Indexed by the character minus FirstAtlasCharacter.
+    struct GlyphAtlas final
+    {
+        std::vector<AtlasGlyph> Fills;
+        std::vector<AtlasGlyph> Outlines;
+        std::vector<float> Advances;
+    };
+
+    struct PackedRectangles final
+    {
+        std::vector<Vector2u> TopLeft;
+        UInt32 Height = 0;
+    };
+
+    // Places rectangles in rows from left to right and top to bottom of a texture with the given width. There is a gap
+    // of one pixel around every rectangle so that filtering does not mix neighbours.
+    [[nodiscard]] PackedRectangles PackRectangles(std::span<const Vector2u> sizes, UInt32 width);
+
+    // The texts of a canvas which draws them with the glyphs of an atlas. Once there are enough slots, creating a text
+    // only copies the characters. Handles of deleted texts are detected by the SlotMap.
+    struct AtlasTexts final
+    {
+        [[nodiscard]] TextId Create(std::string_view content, const Vector2f &position, Color fillColor,
+                                    Color outlineColor);
+        void SetPosition(TextId id, const Vector2f &position);
+        [[nodiscard]] Vector2f GetPosition(TextId id) const;
+        void Delete(TextId id);
+        // Appends two triangles for the outline and two for the fill of every character.
+        void AppendVertices(TextId id, const GlyphAtlas &atlas, std::vector<TexturedVertex> &vertices) const;
+
+    private:
+        struct Slot final
+        {
+            std::array<char, MaximumAtlasTextLength> Characters;
+            size_t Length;
+            Vector2f Position;
+            Color FillColor;
+            Color OutlineColor;
+        };
+
+        SlotMap<Slot> _slots;
+    };
+} // namespace ij
@@ -1,6 +1,7 @@
 #pragma once
 #include "World.h"
 #include <array>
+#include <optional>
 
 namespace ij
 {
@@ -8,7 +9,7 @@ namespace ij
     {
         std::array<bool, 4> isDirectionKeyPressed = {};
         bool isAttackPressed = false;
-        Object *selectedEnemy = nullptr;
+        std::optional<size_t> selectedEnemy;
         bool isDebugModeOn = false;
     };
 } // namespace ij
@@ -0,0 +1,353 @@
+#include "InputRecording.h"
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace ij
+{
+    namespace
+    {
+        constexpr std::array<char, 4> magic = {'I', 'J', 'I', 'R'};
+        constexpr std::uint8_t formatVersion = 3;
+        // a generated map has fewer walkable tiles than tiles, so there is no room for more enemies
+        constexpr float maximumEnemiesPerTile = 1.0f;
+
+        // layout of the first byte of a run
+        constexpr std::uint8_t attackFlag = (1u << 4u);
+        constexpr std::uint8_t selectionFlag = (1u << 5u);
+        constexpr std::uint8_t levelOfDetailFlag = (1u << 6u);
+
+        void writeByte(std::ostream &output, const std::uint8_t value)
+        {
+            output.put(static_cast<char>(value));
+        }
+
+        // LEB128 because most numbers in a recording are small
+        void writeVariableLength(std::ostream &output, UInt64 value)
+        {
+            while (value >= 0x80u)
+            {
+                writeByte(output, static_cast<std::uint8_t>(value | 0x80u));
+                value >>= 7u;
+            }
+            writeByte(output, static_cast<std::uint8_t>(value));
+        }
+
+        void writeFloat(std::ostream &output, const float value)
+        {
+            const UInt32 bits = std::bit_cast<UInt32>(value);
+            for (unsigned i = 0; i < 4; ++i)
+            {
+                writeByte(output, static_cast<std::uint8_t>(bits >> (i * 8u)));
+            }
+        }
+
+        [[nodiscard]] std::optional<std::uint8_t> readByte(std::istream &input)
+        {
+            const std::istream::int_type value = input.get();
+            if (value == std::istream::traits_type::eof())
+            {
+                return std::nullopt;
+            }
+            return static_cast<std::uint8_t>(value);
+        }
+
+        [[nodiscard]] std::optional<UInt64> readVariableLength(std::istream &input)
+        {
+            UInt64 result = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                const std::optional<std::uint8_t> byte = readByte(input);
+                if (!byte)
+                {
+                    return std::nullopt;
+                }
+                result |= (static_cast<UInt64>(*byte & 0x7fu) << shift);
+                if ((*byte & 0x80u) == 0)
+                {
+                    return result;
+                }
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]] std::optional<float> readFloat(std::istream &input)
+        {
+            UInt32 bits = 0;
+            for (unsigned i = 0; i < 4; ++i)
+            {
+                const std::optional<std::uint8_t> byte = readByte(input);
+                if (!byte)
+                {
+                    return std::nullopt;
+                }
+                bits |= (static_cast<UInt32>(*byte) << (i * 8u));
+            }
+            return std::bit_cast<float>(bits);
+        }
+
+        void writeSettings(std::ostream &output, const GameSettings &settings)
+        {
+            output.write(magic.data(), magic.size());
+            writeByte(output, formatVersion);
+            writeVariableLength(output, settings.Seed);
+            writeVariableLength(output, settings.MapWidth);
+            writeVariableLength(output, settings.MapHeight);
+            writeFloat(output, settings.EnemiesPerTile);
+            writeByte(output, settings.IsWorldInfinite);
+            writeVariableLength(output, settings.TicksPerSecond);
+        }
+
+        [[nodiscard]] std::optional<GameSettings> readSettings(std::istream &input)
+        {
+            std::array<char, 4> actualMagic = {};
+            if (!input.read(actualMagic.data(), actualMagic.size()) || (actualMagic != magic))
+            {
+                return std::nullopt;
+            }
+            if (readByte(input) != formatVersion)
+            {
+                return std::nullopt;
+            }
+            const std::optional<UInt64> seed = readVariableLength(input);
+            const std::optional<UInt64> width = readVariableLength(input);
+            const std::optional<UInt64> height = readVariableLength(input);
+            const std::optional<float> enemiesPerTile = readFloat(input);
+            const std::optional<std::uint8_t> isWorldInfinite = readByte(input);
+            const std::optional<UInt64> ticksPerSecond = readVariableLength(input);
+            // the map is generated from these settings, so they get the same limits as a map file
+            if (!seed || (*seed > (std::numeric_limits<UInt32>::max)()) || !width || (*width == 0) ||
+                (*width > Map::MaximumSideLength) || !height || (*height == 0) || (*height > Map::MaximumSideLength) ||
+                !enemiesPerTile || !std::isfinite(*enemiesPerTile) || (*enemiesPerTile < 0) ||
+                (*enemiesPerTile > maximumEnemiesPerTile) || !isWorldInfinite || (*isWorldInfinite > 1) ||
+                !ticksPerSecond || (*ticksPerSecond == 0) || (*ticksPerSecond > MaximumTicksPerSecond))
+            {
+                return std::nullopt;
+            }
+            GameSettings settings;
+            settings.Seed = static_cast<UInt32>(*seed);
+            settings.MapWidth = AssertCast<size_t>(*width);
+            settings.MapHeight = AssertCast<size_t>(*height);
+            settings.EnemiesPerTile = *enemiesPerTile;
+            settings.IsWorldInfinite = (*isWorldInfinite != 0);
+            settings.TicksPerSecond = AssertCast<unsigned>(*ticksPerSecond);
+            return settings;
+        }
+
+        // The level of detail settings rarely change, so they are only written when they differ from the previous run.
+        void writeRun(std::ostream &output, const InputRun &run, LevelOfDetailSettings &previousLevelOfDetail)
+        {
+            std::uint8_t flags = 0;
+            for (size_t i = 0; i < run.Input.IsDirectionKeyPressed.size(); ++i)
+            {
+                if (run.Input.IsDirectionKeyPressed[i])
+                {
+                    flags |= static_cast<std::uint8_t>(1u << i);
+                }
+            }
+            if (run.Input.IsAttackPressed)
+            {
+                flags |= attackFlag;
+            }
+            if (run.Input.SelectedEnemy)
+            {
+                flags |= selectionFlag;
+            }
+            const bool hasLevelOfDetailChanged = (run.Input.LevelOfDetail != previousLevelOfDetail);
+            if (hasLevelOfDetailChanged)
+            {
+                flags |= levelOfDetailFlag;
+            }
+            writeByte(output, flags);
+            writeVariableLength(output, run.Ticks);
+            if (run.Input.SelectedEnemy)
+            {
+                writeVariableLength(output, *run.Input.SelectedEnemy);
+            }
+            if (hasLevelOfDetailChanged)
+            {
+                writeFloat(output, run.Input.LevelOfDetail.NearRadius);
+                writeFloat(output, run.Input.LevelOfDetail.MidRadius);
+                writeVariableLength(output,
+                                    AssertCast<UInt64>(run.Input.LevelOfDetail.MidUpdateInterval.Milliseconds));
+                previousLevelOfDetail = run.Input.LevelOfDetail;
+            }
+        }
+
+        [[nodiscard]] std::optional<InputRun> readRun(std::istream &input, LevelOfDetailSettings &previousLevelOfDetail)
+        {
+            const std::optional<std::uint8_t> flags = readByte(input);
+            if (!flags)
+            {
+                return std::nullopt;
+            }
+            InputRun run;
+            for (size_t i = 0; i < run.Input.IsDirectionKeyPressed.size(); ++i)
+            {
+                run.Input.IsDirectionKeyPressed[i] = ((*flags & (1u << i)) != 0);
+            }
+            run.Input.IsAttackPressed = ((*flags & attackFlag) != 0);
+            const std::optional<UInt64> ticks = readVariableLength(input);
+            if (!ticks)
+            {
+                return std::nullopt;
+            }
+            run.Ticks = *ticks;
+            if (*flags & selectionFlag)
+            {
+                const std::optional<UInt64> selectedEnemy = readVariableLength(input);
+                if (!selectedEnemy)
+                {
+                    return std::nullopt;
+                }
+                run.Input.SelectedEnemy = AssertCast<size_t>(*selectedEnemy);
+            }
+            if (*flags & levelOfDetailFlag)
+            {
+                const std::optional<float> nearRadius = readFloat(input);
+                const std::optional<float> midRadius = readFloat(input);
+                const std::optional<UInt64> midUpdateInterval = readVariableLength(input);
+                if (!nearRadius || !midRadius || !midUpdateInterval ||
+                    (*midUpdateInterval > AssertCast<UInt64>((std::numeric_limits<Int64>::max)())))
+                {
+                    return std::nullopt;
+                }
+                previousLevelOfDetail = LevelOfDetailSettings{
+                    *nearRadius, *midRadius, TimeSpan::FromMilliseconds(AssertCast<Int64>(*midUpdateInterval))};
+            }
+            run.Input.LevelOfDetail = previousLevelOfDetail;
+            return run;
+        }
+    } // namespace
+} // namespace ij
+
+ij::RecordedInput ij::CaptureInput(const Input &input, const World &world)
+{
+    return RecordedInput{input.isDirectionKeyPressed, input.isAttackPressed, input.selectedEnemy, world.LevelOfDetail};
+}
+
+void ij::ApplyInput(const RecordedInput &recorded, Input &input, World &world)
+{
+    input.isDirectionKeyPressed = recorded.IsDirectionKeyPressed;
+    input.isAttackPressed = recorded.IsAttackPressed;
+    input.selectedEnemy = recorded.SelectedEnemy;
+    world.LevelOfDetail = recorded.LevelOfDetail;
+}
+
+ij::UInt64 ij::InputRecording::GetNumberOfTicks() const
+{
+    UInt64 sum = 0;
+    for (const InputRun &run : Runs)
+    {
+        sum += run.Ticks;
+    }
+    return sum;
+}
+
+ij::InputRecorder::InputRecorder(std::ostream &output, const GameSettings &settings)
+    : _output(output)
+{
+    writeSettings(_output, settings);
+}
+
+ij::InputRecorder::~InputRecorder()
+{
+    Finish();
+}
+
+void ij::InputRecorder::Record(const RecordedInput &input, const UInt64 ticks)
+{
+    if (ticks == 0)
+    {
+        return;
+    }
+    if (input == _currentRun.Input)
+    {
+        _currentRun.Ticks += ticks;
+        return;
+    }
+    Finish();
+    _currentRun = InputRun{input, ticks};
+}
+
+void ij::InputRecorder::Finish()
+{
+    if (_currentRun.Ticks == 0)
+    {
+        return;
+    }
+    writeRun(_output, _currentRun, _lastWrittenLevelOfDetail);
+    _output.flush();
+    _currentRun.Ticks = 0;
+}
+
+std::optional<ij::InputRecording> ij::ReadInputRecording(std::istream &input)
+{
+    const std::optional<GameSettings> settings = readSettings(input);
+    if (!settings)
+    {
+        return std::nullopt;
+    }
+    InputRecording recording{*settings, {}};
+    LevelOfDetailSettings levelOfDetail;
+    // a run which was cut off at the end is ignored
+    for (;;)
+    {
+        std::optional<InputRun> run = readRun(input, levelOfDetail);
+        if (!run)
+        {
+            break;
+        }
+        recording.Runs.push_back(*run);
+    }
+    return recording;
+}
+
+ij::InputPlayback::InputPlayback(const InputRecording &recording)
+    : _recording(recording)
+{
+}
+
+bool ij::InputPlayback::IsFinished() const
+{
+    if (_ticksLeftInRun > 0)
+    {
+        return false;
+    }
+    for (size_t i = _currentRun; i < _recording.Runs.size(); ++i)
+    {
+        if (_recording.Runs[i].Ticks > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ij::InputPlayback::ApplyNextTick(Input &input, World &world)
+{
+    while (_ticksLeftInRun == 0)
+    {
+        assert(_currentRun < _recording.Runs.size());
+        _ticksLeftInRun = _recording.Runs[_currentRun].Ticks;
+        ++_currentRun;
+    }
+    ApplyInput(_recording.Runs[_currentRun - 1].Input, input, world);
+    --_ticksLeftInRun;
+}
+
+void ij::ReplayInputRecording(Game &game, const InputRecording &recording, WorkerPool &workers,
+                              const std::function<void(UInt64 tick)> &afterTick)
+{
+    const TimeSpan simulationTimeStep = game.SimulatedWorld.TimeStep;
+    InputPlayback playback(recording);
+    UInt64 tick = 0;
+    while (!playback.IsFinished())
+    {
+        playback.ApplyNextTick(game.CurrentInput, game.SimulatedWorld);
+        TimeSpan remainingSimulationTime = simulationTimeStep;
+        UpdateGame(game, remainingSimulationTime, workers);
+        ++tick;
+        afterTick(tick);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Game.h"
+#include <functional>
+#include <istream>
+#include <ostream>
+
+namespace ij
+{
+    // The input of one tick, reduced to what the simulation depends on plus the selection.
+    struct RecordedInput final
+    {
+        std::array<bool, 4> IsDirectionKeyPressed = {};
+        bool IsAttackPressed = false;
+        std::optional<size_t> SelectedEnemy;
+        // can be changed in the debug window while playing
+        LevelOfDetailSettings LevelOfDetail;
+
+        bool operator==(const RecordedInput &other) const = default;
+    };
+
+    [[nodiscard]] RecordedInput CaptureInput(const Input &input, const World &world);
+    void ApplyInput(const RecordedInput &recorded, Input &input, World &world);
+
+    // the same input for a number of consecutive ticks
+    struct InputRun final
+    {
+        RecordedInput Input;
+        UInt64 Ticks = 0;
+    };
+
+    struct InputRecording final
+    {
+        GameSettings Settings;
+        std::vector<InputRun> Runs;
+
+        [[nodiscard]] UInt64 GetNumberOfTicks() const;
+    };
+
+    // Writes the input of a session to a stream as it is played. Consecutive ticks with the same input are stored as a
+    // single run, so a typical session needs a few bytes per key press. Everything before the last change of the input
+    // is written immediately, so a recording is still readable if the game crashes.
+    struct InputRecorder final
+    {
+        InputRecorder(std::ostream &output, const GameSettings &settings);
+        InputRecorder(const InputRecorder &) = delete;
+        InputRecorder &operator=(const InputRecorder &) = delete;
+        ~InputRecorder();
+
+        void Record(const RecordedInput &input, UInt64 ticks);
+        void Finish();
+
+    private:
+        std::ostream &_output;
+        InputRun _currentRun;
+        LevelOfDetailSettings _lastWrittenLevelOfDetail;
+    };
+
+    // Reads everything an InputRecorder has written. Returns nothing if the stream is not an input recording.
+    [[nodiscard]] std::optional<InputRecording> ReadInputRecording(std::istream &input);
+
+    // Steps through a recording one tick at a time.
+    struct InputPlayback final
+    {
+        explicit InputPlayback(const InputRecording &recording);
+
+        [[nodiscard]] bool IsFinished() const;
+        // Has to be called before every tick.
+        void ApplyNextTick(Input &input, World &world);
+
+    private:
+        const InputRecording &_recording;
+        size_t _currentRun = 0;
+        UInt64 _ticksLeftInRun = 0;
+    };
+
+    // Simulates the recorded ticks as fast as possible. The game has to be created from the settings of the recording.
+    // afterTick is called with the number of ticks simulated so far after every tick.
+    void ReplayInputRecording(Game &game, const InputRecording &recording, WorkerPool &workers,
+                              const std::function<void(UInt64 tick)> &afterTick);
+} // namespace ij
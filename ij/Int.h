@@ -6,4 +6,5 @@ namespace ij
     using Int32 = std::int32_t;
     using UInt32 = std::uint32_t;
     using Int64 = std::int64_t;
+    using UInt64 = std::uint64_t;
 } // namespace ij
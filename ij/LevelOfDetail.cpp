@@ -0,0 +1,69 @@
+#include "LevelOfDetail.h"
+#include "Normalize.h"
+#include "World.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void ij::LevelOfDetailCounts::Add(const LevelOfDetailCounts &other)
+{
+    Near += other.Near;
+    Mid += other.Mid;
+    Dormant += other.Dormant;
+    CaughtUp += other.CaughtUp;
+}
+
+ij::UInt64 ij::GetMidTickInterval(const LevelOfDetailSettings &settings, const TimeSpan timeStep)
+{
+    assert(timeStep.Milliseconds > 0);
+    const Int64 interval = settings.MidUpdateInterval.Milliseconds;
+    const Int64 rounded = ((interval + (timeStep.Milliseconds / 2)) / timeStep.Milliseconds);
+    return AssertCast<UInt64>((std::max)(Int64(1), rounded));
+}
+
+ij::SimulationTier ij::ChooseSimulationTier(const LevelOfDetailSettings &settings, const Vector2f &enemy,
+                                            const Vector2f &player)
+{
+    if (isWithinDistance(enemy, player, settings.NearRadius))
+    {
+        return SimulationTier::Near;
+    }
+    if (isWithinDistance(enemy, player, settings.MidRadius))
+    {
+        return SimulationTier::Mid;
+    }
+    return SimulationTier::Dormant;
+}
+
+void ij::CatchUpDormantEnemy(EnemyStore &enemies, const size_t enemy, const TimeSpan dormantTime, const World &world,
+                             CounterBasedRandomNumberGenerator &random)
+{
+    // The player was far away the whole time, so any chase has ended long ago.
+    enemies.Bots[enemy] = Bot();
+    enemies.HasBumpedIntoWall[enemy] = false;
+
+    // A wandering bot walks about half of the time and changes its mind every 3.2 seconds on average. That is a random
+    // walk, so the expected distance from the start only grows with the square root of the number of decisions.
+    constexpr float averageMillisecondsBetweenDecisions = 3200;
+    const float milliseconds = AssertCast<float>(dormantTime.Milliseconds);
+    const float decisions = (std::max)(1.0f, (milliseconds / averageMillisecondsBetweenDecisions));
+    const float distance = (WalkingVelocity * milliseconds * 0.5f / std::sqrt(decisions));
+    const Vector2f direction = normalize(
+        Vector2f(AssertCast<float>(random.GenerateInt32(0, 9) - 5), AssertCast<float>(random.GenerateInt32(0, 9) - 5)));
+    // MoveWithCollisionDetection only checks the destination, so the walk is split into steps which cannot jump over
+    // a wall or a gap in the map. Like a wandering bot, the enemy stops at the first wall it bumps into.
+    constexpr float maximumStep = (TileSize / 4.0f);
+    const size_t steps = AssertCast<size_t>(std::ceil(distance / maximumStep));
+    const Vector2f step = direction * (distance / AssertCast<float>((std::max)(steps, size_t(1))));
+    for (size_t i = 0; i < steps; ++i)
+    {
+        if (MoveWithCollisionDetection(enemies.Positions[enemy], true, step, world))
+        {
+            enemies.HasBumpedIntoWall[enemy] = true;
+            break;
+        }
+    }
+    enemies.Directions[enemy] = direction;
+    enemies.SetActivity(enemy,
+                        (random.GenerateInt32(0, 1) == 0) ? ObjectActivity::Standing : ObjectActivity::Walking);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "RandomNumberGenerator.h"
+#include "TimeSpan.h"
+#include "Vector2.h"
+
+namespace ij
+{
+    struct EnemyStore;
+    struct World;
+
+    enum class SimulationTier
+    {
+        // updated every tick
+        Near,
+        // updated every few ticks with the accumulated time, see LevelOfDetailSettings::MidUpdateInterval
+        Mid,
+        // not updated at all until the player comes closer again
+        Dormant
+    };
+
+    struct LevelOfDetailSettings final
+    {
+        // has to be larger than the distance from which bots start chasing the player
+        float NearRadius = 1000;
+        float MidRadius = 2000;
+        // in simulated time, so that the tick rate does not change how often mid range enemies are updated
+        TimeSpan MidUpdateInterval = TimeSpan::FromMilliseconds(64);
+
+        bool operator==(const LevelOfDetailSettings &other) const = default;
+    };
+
+    struct LevelOfDetailCounts final
+    {
+        size_t Near = 0;
+        size_t Mid = 0;
+        size_t Dormant = 0;
+        // enemies which woke up in the last tick
+        size_t CaughtUp = 0;
+
+        void Add(const LevelOfDetailCounts &other);
+    };
+
+    // the number of ticks between two updates of a mid range enemy, rounded to the nearest tick and at least one
+    [[nodiscard]] UInt64 GetMidTickInterval(const LevelOfDetailSettings &settings, TimeSpan timeStep);
+    [[nodiscard]] SimulationTier ChooseSimulationTier(const LevelOfDetailSettings &settings, const Vector2f &enemy,
+                                                      const Vector2f &player);
+    // Approximates what a wandering enemy would have done while it was dormant instead of simulating every tick.
+    void CatchUpDormantEnemy(EnemyStore &enemies, size_t enemy, TimeSpan dormantTime, const World &world,
+                             CounterBasedRandomNumberGenerator &random);
+} // namespace ij
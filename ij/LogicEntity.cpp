@@ -1,6 +1,5 @@
 #include "LogicEntity.h"
 #include "World.h"
-#include <cmath>
 
 bool ij::isDead(const LogicEntity &entity)
 {
@@ -14,6 +13,7 @@ ij::LogicEntity::LogicEntity(std::unique_ptr<ObjectBehavior> behavior, const Vec
                              Health currentHealth, Health maximumHealth, ObjectActivity activity)
     : Behavior(std::move(behavior))
     , Position(position)
+    , PreviousPosition(position)
     , Direction(direction)
     , HasCollisionWithWalls(hasCollisionWithWalls)
     , HasBumpedIntoWall(hasBumpedIntoWall)
@@ -68,62 +68,43 @@ ij::Health ij::LogicEntity::GetMaximumHealth() const
 
 [[nodiscard]] bool ij::IsWalkablePoint(const Vector2f &point, const World &world)
 {
-    const Vector2<ptrdiff_t> tileIndex(
-        AssertCast<ptrdiff_t>(std::floor(point.x / TileSize)), AssertCast<ptrdiff_t>(std::floor(point.y / TileSize)));
-    if ((tileIndex.x < 0) || (tileIndex.y < 0))
-    {
-        return false;
-    }
-    if ((tileIndex.x >= AssertCast<ptrdiff_t>(world.map.Width)) ||
-        (tileIndex.y >= AssertCast<ptrdiff_t>(world.map.GetHeight())))
-    {
-        return false;
-    }
-    const int tile = world.map.GetTileAt(AssertCast<size_t>(tileIndex.x), AssertCast<size_t>(tileIndex.y));
-    return (tile != NoTile);
+    return world.Walkability.IsWalkablePoint(point.x, point.y);
 }
 
 [[nodiscard]] bool ij::IsWalkable(const Vector2f &point, const Vector2f &entityDimensions, const World &world)
 {
     const Vector2f halfDimensions = entityDimensions / 2.0f;
-    // current heuristic: check the four corners of the bounding box around the entity in addition to the center
-    return
-        // top left
-        IsWalkablePoint(point - halfDimensions, world) &&
-        // bottom right
-        IsWalkablePoint(point + halfDimensions, world) &&
-        // bottom left
-        IsWalkablePoint(point + Vector2f(-halfDimensions.x, halfDimensions.y), world) &&
-        // top right
-        IsWalkablePoint(point + Vector2f(halfDimensions.x, -halfDimensions.y), world) &&
-        // center
-        IsWalkablePoint(point, world);
+    return world.Walkability.IsWalkable(point.x, point.y, halfDimensions.x, halfDimensions.y);
 }
 
-void ij::MoveWithCollisionDetection(LogicEntity &entity, const Vector2f &desiredChange, const World &world)
+bool ij::MoveWithCollisionDetection(Vector2f &position, const bool hasCollisionWithWalls,
+                                    const Vector2f &desiredChange, const World &world)
 {
-    const Vector2f desiredDestination = (entity.Position + desiredChange);
-    if (!entity.HasCollisionWithWalls || IsWalkable(desiredDestination, DefaultEntityDimensions, world))
+    const Vector2f desiredDestination = (position + desiredChange);
+    if (!hasCollisionWithWalls || IsWalkable(desiredDestination, DefaultEntityDimensions, world))
     {
-        entity.Position = desiredDestination;
-        entity.HasBumpedIntoWall = false;
-    }
-    else if (const Vector2f horizontalAlternative = (entity.Position + Vector2f(desiredChange.x, 0));
-             IsWalkable(horizontalAlternative, DefaultEntityDimensions, world))
-    {
-        entity.Position = horizontalAlternative;
-        entity.HasBumpedIntoWall = true;
+        position = desiredDestination;
+        return false;
     }
-    else if (const Vector2f verticalAlternative = (entity.Position + Vector2f(0, desiredChange.y));
-             IsWalkable(verticalAlternative, DefaultEntityDimensions, world))
+    if (const Vector2f horizontalAlternative = (position + Vector2f(desiredChange.x, 0));
+        IsWalkable(horizontalAlternative, DefaultEntityDimensions, world))
     {
-        entity.Position = verticalAlternative;
-        entity.HasBumpedIntoWall = true;
+        position = horizontalAlternative;
+        return true;
     }
-    else
+    if (const Vector2f verticalAlternative = (position + Vector2f(0, desiredChange.y));
+        IsWalkable(verticalAlternative, DefaultEntityDimensions, world))
     {
-        entity.HasBumpedIntoWall = true;
+        position = verticalAlternative;
+        return true;
     }
+    return true;
+}
+
+void ij::MoveWithCollisionDetection(LogicEntity &entity, const Vector2f &desiredChange, const World &world)
+{
+    entity.HasBumpedIntoWall =
+        MoveWithCollisionDetection(entity.Position, entity.HasCollisionWithWalls, desiredChange, world);
 }
 
 void ij::updateLogic(LogicEntity &entity, LogicEntity &player, World &world, const TimeSpan deltaTime,
@@ -139,8 +120,7 @@ void ij::updateLogic(LogicEntity &entity, LogicEntity &player, World &world, con
         break;
 
     case ObjectActivity::Walking: {
-        constexpr float velocity = 0.08f;
-        const Vector2f change = entity.Direction * (AssertCast<float>(deltaTime.Milliseconds) * velocity);
+        const Vector2f change = entity.Direction * (AssertCast<float>(deltaTime.Milliseconds) * WalkingVelocity);
         MoveWithCollisionDetection(entity, change, world);
         break;
     }
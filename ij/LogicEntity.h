@@ -42,6 +42,8 @@ namespace ij
 
         std::unique_ptr<ObjectBehavior> Behavior;
         Vector2f Position;
+        // the position before the last tick, for drawing between the ticks
+        Vector2f PreviousPosition;
         Vector2f Direction;
         bool HasCollisionWithWalls = true;
         bool HasBumpedIntoWall = false;
@@ -54,9 +56,14 @@ namespace ij
 
     constexpr int TileSize = 32;
     const Vector2f DefaultEntityDimensions(8, 8);
+    // pixels per millisecond
+    constexpr float WalkingVelocity = 0.08f;
 
     [[nodiscard]] bool IsWalkablePoint(const Vector2f &point, const World &world);
     [[nodiscard]] bool IsWalkable(const Vector2f &point, const Vector2f &entityDimensions, const World &world);
+    // returns whether the entity bumped into a wall
+    [[nodiscard]] bool MoveWithCollisionDetection(Vector2f &position, bool hasCollisionWithWalls,
+                                                  const Vector2f &desiredChange, const World &world);
     void MoveWithCollisionDetection(LogicEntity &entity, const Vector2f &desiredChange, const World &world);
     void updateLogic(LogicEntity &entity, LogicEntity &player, World &world, TimeSpan deltaTime,
                      RandomNumberGenerator &random);
@@ -1,22 +1,205 @@
 #include "Map.h"
+#include "AssertCast.h"
+#include "FastRandomNumberGenerator.h"
+#include <algorithm>
+#include <limits>
+
+namespace ij
+{
+    namespace
+    {
+        constexpr UInt32 noUniformChunk = (std::numeric_limits<UInt32>::max)();
+
+        [[nodiscard]] size_t countChunks(const size_t tiles)
+        {
+            return ((tiles + Map::ChunkSize - 1) / Map::ChunkSize);
+        }
+    } // namespace
+} // namespace ij
+
+ij::Map::Map(const size_t width, const size_t height, const std::span<const UInt32> chunkIndex,
+             const std::span<const Tile> chunkTiles, std::shared_ptr<const void> storage)
+    : Width(width)
+    , _height(height)
+    , _widthInChunks(countChunks(width))
+    , _chunkIndex(chunkIndex)
+    , _chunkTiles(chunkTiles)
+    , _storage(std::move(storage))
+{
+    assert(_chunkIndex.size() == (_widthInChunks * countChunks(height)));
+    assert((_chunkTiles.size() % TilesPerChunk) == 0);
+}
 
 size_t ij::Map::GetHeight() const
 {
-    return Tiles.size() / Width;
+    return _height;
 }
 
-int ij::Map::GetTileAt(const size_t x, const size_t y) const
+size_t ij::Map::GetNumberOfTiles() const
 {
-    return Tiles[(y * Width) + x];
+    return (Width * _height);
 }
 
-[[nodiscard]] ij::Map ij::GenerateRandomMap(RandomNumberGenerator &random)
+size_t ij::Map::GetWidthInChunks() const
+{
+    return _widthInChunks;
+}
+
+size_t ij::Map::GetHeightInChunks() const
+{
+    return countChunks(_height);
+}
+
+std::span<const ij::Tile, ij::Map::TilesPerChunk> ij::Map::GetChunk(const size_t chunkX, const size_t chunkY) const
+{
+    assert(chunkX < _widthInChunks);
+    assert(chunkY < GetHeightInChunks());
+    const UInt32 chunk = (_chunkIndex[(chunkY * _widthInChunks) + chunkX] & ~UniformChunkFlag);
+    return _chunkTiles.subspan(chunk * TilesPerChunk).first<TilesPerChunk>();
+}
+
+bool ij::Map::IsChunkUniform(const size_t chunkX, const size_t chunkY) const
+{
+    assert(chunkX < _widthInChunks);
+    assert(chunkY < GetHeightInChunks());
+    return (_chunkIndex[(chunkY * _widthInChunks) + chunkX] & UniformChunkFlag) != 0;
+}
+
+std::span<const ij::UInt32> ij::Map::GetChunkIndex() const
+{
+    return _chunkIndex;
+}
+
+std::span<const ij::Tile> ij::Map::GetChunkTiles() const
+{
+    return _chunkTiles;
+}
+
+size_t ij::Map::GetMemoryUsage() const
+{
+    return (_chunkIndex.size_bytes() + _chunkTiles.size_bytes());
+}
+
+struct ij::MapBuilder::Storage final
+{
+    std::vector<UInt32> ChunkIndex;
+    std::vector<Tile> ChunkTiles;
+};
+
+ij::MapBuilder::MapBuilder(const size_t width, const size_t height)
+    : _width(width)
+    , _height(height)
+    , _storage(std::make_shared<Storage>())
 {
-    Map result;
-    result.Width = 500;
-    for (size_t i = 0; i < (500 * result.Width); ++i)
+    _storage->ChunkIndex.resize(countChunks(width) * countChunks(height), noUniformChunk);
+    _uniformChunks.fill(noUniformChunk);
+}
+
+size_t ij::MapBuilder::GetWidthInChunks() const
+{
+    return countChunks(_width);
+}
+
+size_t ij::MapBuilder::GetHeightInChunks() const
+{
+    return countChunks(_height);
+}
+
+void ij::MapBuilder::SetChunk(const size_t chunkX, const size_t chunkY,
+                              const std::span<const Tile, Map::TilesPerChunk> tiles)
+{
+    assert(chunkX < GetWidthInChunks());
+    assert(chunkY < GetHeightInChunks());
+    std::array<Tile, Map::TilesPerChunk> clipped;
+    std::ranges::copy(tiles, clipped.begin());
+    const size_t columns = (std::min)(Map::ChunkSize, (_width - (chunkX * Map::ChunkSize)));
+    const size_t rows = (std::min)(Map::ChunkSize, (_height - (chunkY * Map::ChunkSize)));
+    for (size_t y = 0; y < Map::ChunkSize; ++y)
+    {
+        for (size_t x = ((y < rows) ? columns : 0); x < Map::ChunkSize; ++x)
+        {
+            clipped[(y * Map::ChunkSize) + x] = static_cast<Tile>(NoTile);
+        }
+    }
+
+    UInt32 &indexEntry = _storage->ChunkIndex[(chunkY * GetWidthInChunks()) + chunkX];
+    assert(indexEntry == noUniformChunk);
+    const Tile first = clipped[0];
+    const bool isUniform = std::ranges::all_of(clipped, [first](const Tile tile) { return (tile == first); });
+    if (isUniform && (_uniformChunks[first] != noUniformChunk))
     {
-        result.Tiles.push_back(random.GenerateInt32(0, 3));
+        indexEntry = (_uniformChunks[first] | Map::UniformChunkFlag);
+        return;
     }
-    return result;
+    std::vector<Tile> &chunkTiles = _storage->ChunkTiles;
+    const UInt32 chunkNumber = AssertCast<UInt32>(chunkTiles.size() / Map::TilesPerChunk);
+    assert((chunkNumber & Map::UniformChunkFlag) == 0);
+    chunkTiles.insert(chunkTiles.end(), clipped.begin(), clipped.end());
+    indexEntry = chunkNumber;
+    if (isUniform)
+    {
+        _uniformChunks[first] = chunkNumber;
+        indexEntry |= Map::UniformChunkFlag;
+    }
+}
+
+ij::Map ij::MapBuilder::Build()
+{
+    assert(std::ranges::find(_storage->ChunkIndex, noUniformChunk) == _storage->ChunkIndex.end());
+    std::shared_ptr<Storage> storage = std::move(_storage);
+    const std::span<const UInt32> chunkIndex = storage->ChunkIndex;
+    const std::span<const Tile> chunkTiles = storage->ChunkTiles;
+    return Map(_width, _height, chunkIndex, chunkTiles, std::move(storage));
+}
+
+ij::Map ij::CreateMapFromTiles(const size_t width, const size_t height, const std::span<const Tile> tiles)
+{
+    assert(tiles.size() == (width * height));
+    MapBuilder builder(width, height);
+    std::array<Tile, Map::TilesPerChunk> chunk;
+    for (size_t chunkY = 0; chunkY < builder.GetHeightInChunks(); ++chunkY)
+    {
+        for (size_t chunkX = 0; chunkX < builder.GetWidthInChunks(); ++chunkX)
+        {
+            chunk.fill(static_cast<Tile>(NoTile));
+            for (size_t y = 0; y < Map::ChunkSize; ++y)
+            {
+                const size_t mapY = ((chunkY * Map::ChunkSize) + y);
+                for (size_t x = 0; x < Map::ChunkSize; ++x)
+                {
+                    const size_t mapX = ((chunkX * Map::ChunkSize) + x);
+                    if ((mapX < width) && (mapY < height))
+                    {
+                        chunk[(y * Map::ChunkSize) + x] = tiles[(mapY * width) + mapX];
+                    }
+                }
+            }
+            builder.SetChunk(chunkX, chunkY, chunk);
+        }
+    }
+    return builder.Build();
+}
+
+ij::Map ij::GenerateRandomMap(RandomNumberGenerator &random, const size_t width, const size_t height)
+{
+    MapBuilder builder(width, height);
+    BatchRandomNumberGenerator batch(AssertCast<UInt64>(random.GenerateSize(0, (std::numeric_limits<size_t>::max)())));
+    std::array<Int32, Map::TilesPerChunk> generated;
+    std::array<Tile, Map::TilesPerChunk> chunk;
+    for (size_t chunkY = 0; chunkY < builder.GetHeightInChunks(); ++chunkY)
+    {
+        for (size_t chunkX = 0; chunkX < builder.GetWidthInChunks(); ++chunkX)
+        {
+            batch.FillInt32(generated, 0, 3);
+            std::ranges::transform(
+                generated, chunk.begin(), [](const Int32 tile) { return static_cast<Tile>(tile); });
+            builder.SetChunk(chunkX, chunkY, chunk);
+        }
+    }
+    return builder.Build();
+}
+
+[[nodiscard]] ij::Map ij::GenerateRandomMap(RandomNumberGenerator &random)
+{
+    return GenerateRandomMap(random, 500, 500);
 }
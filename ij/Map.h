@@ -1,19 +1,90 @@
 #pragma once
 #include "RandomNumberGenerator.h"
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace ij
 {
+    using Tile = std::uint8_t;
     constexpr int NoTile = 3;
 
+    // The tiles are stored in square chunks of one byte per tile. Chunks in which all tiles are the same share their
+    // storage with all other chunks of that tile, so large uniform areas cost four bytes per chunk. Looking up a tile
+    // has no branches because uniform chunks are stored like any other chunk.
+    // A Map only refers to its storage, so copies are cheap and the storage can also be a file mapped into memory.
     struct Map final
     {
-        std::vector<int> Tiles;
-        size_t Width = 0;
+        static constexpr size_t ChunkSize = 32;
+        static constexpr size_t TilesPerChunk = (ChunkSize * ChunkSize);
+        // set in the chunk index for uniform chunks, the remaining bits are the number of the chunk in the tile storage
+        static constexpr UInt32 UniformChunkFlag = (UInt32(1) << 31u);
+        // the largest width or height of a map read from a file, which rules out overflows when tiles are counted
+        static constexpr size_t MaximumSideLength = (size_t(1) << 24u);
+
+        size_t Width;
+
+        // storage keeps chunkIndex and chunkTiles alive
+        Map(size_t width, size_t height, std::span<const UInt32> chunkIndex, std::span<const Tile> chunkTiles,
+            std::shared_ptr<const void> storage);
 
         [[nodiscard]] size_t GetHeight() const;
-        [[nodiscard]] int GetTileAt(size_t x, size_t y) const;
+        // inline because collision detection and rendering call it for many tiles
+        [[nodiscard]] int GetTileAt(const size_t x, const size_t y) const
+        {
+            assert(x < Width);
+            assert(y < _height);
+            const UInt32 chunk =
+                (_chunkIndex[((y / ChunkSize) * _widthInChunks) + (x / ChunkSize)] & ~UniformChunkFlag);
+            return _chunkTiles[(chunk * TilesPerChunk) + ((y % ChunkSize) * ChunkSize) + (x % ChunkSize)];
+        }
+        [[nodiscard]] size_t GetNumberOfTiles() const;
+        [[nodiscard]] size_t GetWidthInChunks() const;
+        [[nodiscard]] size_t GetHeightInChunks() const;
+        // row by row; the parts of chunks at the edges which are outside of the map are NoTile
+        [[nodiscard]] std::span<const Tile, TilesPerChunk> GetChunk(size_t chunkX, size_t chunkY) const;
+        [[nodiscard]] bool IsChunkUniform(size_t chunkX, size_t chunkY) const;
+        // the raw storage, for writing it to a file
+        [[nodiscard]] std::span<const UInt32> GetChunkIndex() const;
+        [[nodiscard]] std::span<const Tile> GetChunkTiles() const;
+        // bytes of tile data and index, which is the memory of the map unless it is shared
+        [[nodiscard]] size_t GetMemoryUsage() const;
+
+    private:
+        size_t _height;
+        size_t _widthInChunks;
+        std::span<const UInt32> _chunkIndex;
+        std::span<const Tile> _chunkTiles;
+        std::shared_ptr<const void> _storage;
+    };
+
+    // Creates a map chunk by chunk. Finds and deduplicates uniform chunks.
+    struct MapBuilder final
+    {
+        MapBuilder(size_t width, size_t height);
+
+        [[nodiscard]] size_t GetWidthInChunks() const;
+        [[nodiscard]] size_t GetHeightInChunks() const;
+        // Has to be called for every chunk before Build. The parts of chunks at the edges which are outside of the map
+        // are replaced with NoTile.
+        void SetChunk(size_t chunkX, size_t chunkY, std::span<const Tile, Map::TilesPerChunk> tiles);
+        [[nodiscard]] Map Build();
+
+    private:
+        struct Storage;
+
+        size_t _width;
+        size_t _height;
+        std::shared_ptr<Storage> _storage;
+        // the number of the chunk in the tile storage for every tile value which had a uniform chunk yet
+        std::array<UInt32, 256> _uniformChunks;
     };
 
+    // tiles row by row
+    [[nodiscard]] Map CreateMapFromTiles(size_t width, size_t height, std::span<const Tile> tiles);
+    [[nodiscard]] Map GenerateRandomMap(RandomNumberGenerator &random, size_t width, size_t height);
     [[nodiscard]] Map GenerateRandomMap(RandomNumberGenerator &random);
 } // namespace ij
@@ -0,0 +1,204 @@
+#include "MapFile.h"
+#include "AssertCast.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ij
+{
+    namespace
+    {
+        constexpr std::array<char, 4> magic = {'I', 'J', 'M', 'P'};
+        constexpr size_t headerSize = (magic.size() + sizeof(UInt32) + (4 * sizeof(UInt64)));
+
+        template <class Integer>
+        void writeInteger(std::ostream &output, const Integer value)
+        {
+            for (size_t i = 0; i < sizeof(value); ++i)
+            {
+                output.put(static_cast<char>(static_cast<unsigned char>(value >> (i * 8u))));
+            }
+        }
+
+        template <class Integer>
+        [[nodiscard]] Integer readInteger(const std::byte *const data)
+        {
+            Integer value = 0;
+            for (size_t i = 0; i < sizeof(value); ++i)
+            {
+                value |= static_cast<Integer>(std::to_integer<Integer>(data[i]) << (i * 8u));
+            }
+            return value;
+        }
+
+        [[nodiscard]] size_t alignUp(const size_t value, const size_t alignment)
+        {
+            return (((value + alignment - 1) / alignment) * alignment);
+        }
+
+        // a read only view of a whole file which stays valid until the object is destroyed
+        struct MappedFile final
+        {
+            const std::byte *Data = nullptr;
+            size_t Size = 0;
+
+            MappedFile() = default;
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            ~MappedFile()
+            {
+                if (!Data)
+                {
+                    return;
+                }
+#ifdef _WIN32
+                UnmapViewOfFile(Data);
+#else
+                munmap(const_cast<std::byte *>(Data), Size);
+#endif
+            }
+        };
+
+        [[nodiscard]] std::shared_ptr<const MappedFile> mapFile(const std::filesystem::path &file)
+        {
+            auto mapped = std::make_shared<MappedFile>();
+#ifdef _WIN32
+            const HANDLE handle = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                              FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == INVALID_HANDLE_VALUE)
+            {
+                return nullptr;
+            }
+            LARGE_INTEGER size = {};
+            if (!GetFileSizeEx(handle, &size) || (size.QuadPart == 0))
+            {
+                CloseHandle(handle);
+                return nullptr;
+            }
+            const HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(handle);
+            if (!mapping)
+            {
+                return nullptr;
+            }
+            // the view keeps the mapping alive
+            mapped->Data = static_cast<const std::byte *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+            if (!mapped->Data)
+            {
+                return nullptr;
+            }
+            mapped->Size = AssertCast<size_t>(size.QuadPart);
+#else
+            const int descriptor = open(file.c_str(), O_RDONLY);
+            if (descriptor < 0)
+            {
+                return nullptr;
+            }
+            struct stat status = {};
+            if ((fstat(descriptor, &status) != 0) || (status.st_size <= 0))
+            {
+                close(descriptor);
+                return nullptr;
+            }
+            const size_t size = AssertCast<size_t>(status.st_size);
+            void *const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            // the mapping stays valid without the descriptor
+            close(descriptor);
+            if (data == MAP_FAILED)
+            {
+                return nullptr;
+            }
+            mapped->Data = static_cast<const std::byte *>(data);
+            mapped->Size = size;
+#endif
+            return mapped;
+        }
+    } // namespace
+} // namespace ij
+
+bool ij::WriteMapFile(std::ostream &output, const Map &map)
+{
+    const std::span<const UInt32> chunkIndex = map.GetChunkIndex();
+    const std::span<const Tile> chunkTiles = map.GetChunkTiles();
+    const size_t tilesOffset = alignUp((headerSize + chunkIndex.size_bytes()), MapFileAlignment);
+    output.write(magic.data(), magic.size());
+    writeInteger(output, MapFileVersion);
+    writeInteger(output, AssertCast<UInt64>(map.Width));
+    writeInteger(output, AssertCast<UInt64>(map.GetHeight()));
+    writeInteger(output, AssertCast<UInt64>(chunkTiles.size() / Map::TilesPerChunk));
+    writeInteger(output, AssertCast<UInt64>(tilesOffset));
+    for (const UInt32 entry : chunkIndex)
+    {
+        writeInteger(output, entry);
+    }
+    for (size_t i = (headerSize + chunkIndex.size_bytes()); i < tilesOffset; ++i)
+    {
+        output.put(0);
+    }
+    output.write(reinterpret_cast<const char *>(chunkTiles.data()), AssertCast<std::streamsize>(chunkTiles.size()));
+    return !!output;
+}
+
+bool ij::SaveMapFile(const std::filesystem::path &file, const Map &map)
+{
+    std::ofstream output(file, std::ios::binary);
+    return output && WriteMapFile(output, map);
+}
+
+std::optional<ij::Map> ij::LoadMapFile(const std::filesystem::path &file)
+{
+    // the chunk index is used as it is in the file
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        return std::nullopt;
+    }
+    const std::shared_ptr<const MappedFile> mapped = mapFile(file);
+    if (!mapped || (mapped->Size < headerSize) || (std::memcmp(mapped->Data, magic.data(), magic.size()) != 0))
+    {
+        return std::nullopt;
+    }
+    const std::byte *const header = mapped->Data;
+    const UInt32 version = readInteger<UInt32>(header + 4);
+    const UInt64 width = readInteger<UInt64>(header + 8);
+    const UInt64 height = readInteger<UInt64>(header + 16);
+    const UInt64 storedChunks = readInteger<UInt64>(header + 24);
+    const UInt64 tilesOffset = readInteger<UInt64>(header + 32);
+    // limits which rule out overflows in the calculations below
+    if ((version != MapFileVersion) || (width == 0) || (height == 0) || (width > Map::MaximumSideLength) ||
+        (height > Map::MaximumSideLength) || (storedChunks > Map::UniformChunkFlag) || (tilesOffset > mapped->Size) ||
+        ((tilesOffset % MapFileAlignment) != 0))
+    {
+        return std::nullopt;
+    }
+    const size_t numberOfChunks = AssertCast<size_t>(((width + Map::ChunkSize - 1) / Map::ChunkSize) *
+                                                     ((height + Map::ChunkSize - 1) / Map::ChunkSize));
+    const size_t tilesSize = AssertCast<size_t>(storedChunks * Map::TilesPerChunk);
+    if (((headerSize + (numberOfChunks * sizeof(UInt32))) > tilesOffset) ||
+        (tilesSize > (mapped->Size - AssertCast<size_t>(tilesOffset))))
+    {
+        return std::nullopt;
+    }
+    const std::span<const UInt32> chunkIndex(reinterpret_cast<const UInt32 *>(header + headerSize), numberOfChunks);
+    for (const UInt32 entry : chunkIndex)
+    {
+        if ((entry & ~Map::UniformChunkFlag) >= storedChunks)
+        {
+            return std::nullopt;
+        }
+    }
+    const std::span<const Tile> chunkTiles(
+        reinterpret_cast<const Tile *>(mapped->Data + AssertCast<size_t>(tilesOffset)), tilesSize);
+    return Map(AssertCast<size_t>(width), AssertCast<size_t>(height), chunkIndex, chunkTiles, mapped);
+}
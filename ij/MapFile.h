@@ -0,0 +1,24 @@
+#pragma once
+#include "Map.h"
+#include <filesystem>
+#include <optional>
+#include <ostream>
+
+namespace ij
+{
+    // A map file is the storage of a Map as it is in memory, so that it can be used without reading or parsing it.
+    // All numbers are little endian:
+    //   "IJMP", UInt32 version, UInt64 width, UInt64 height, UInt64 number of stored chunks, UInt64 offset of the tiles
+    //   the chunk index, one UInt32 per chunk row by row, see Map::UniformChunkFlag
+    //   padding up to the offset of the tiles, which is a multiple of MapFileAlignment
+    //   the stored chunks with Map::TilesPerChunk tiles each
+    constexpr UInt32 MapFileVersion = 1;
+    // the size of a memory page on common systems, so that a chunk never spans two pages
+    constexpr size_t MapFileAlignment = 4096;
+
+    [[nodiscard]] bool WriteMapFile(std::ostream &output, const Map &map);
+    [[nodiscard]] bool SaveMapFile(const std::filesystem::path &file, const Map &map);
+    // Maps the file into memory and uses it as the storage of the Map without copying anything. The operating system
+    // reads the chunks when they are first accessed. Returns nothing if the file is not a valid map file.
+    [[nodiscard]] std::optional<Map> LoadMapFile(const std::filesystem::path &file);
+} // namespace ij
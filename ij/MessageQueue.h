@@ -0,0 +1,63 @@
+#pragma once
+#include "Int.h"
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace ij
+{
+    // A ring buffer of messages from exactly one sending thread to exactly one receiving thread. Neither of them takes
+    // a lock or allocates memory after construction. Each side only writes its own position, so synchronizing them
+    // takes one atomic load and one atomic store per message.
+    template <class T>
+    struct MessageQueue final
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        // the capacity has to be a power of two
+        explicit MessageQueue(const size_t capacity)
+            : _slots(capacity)
+        {
+            assert(std::has_single_bit(capacity));
+        }
+
+        MessageQueue(const MessageQueue &) = delete;
+        MessageQueue &operator=(const MessageQueue &) = delete;
+
+        // Only for the sender. Returns false without sending anything when the queue is full.
+        [[nodiscard]] bool TrySend(const T &message)
+        {
+            const UInt64 sent = _sent.load(std::memory_order_relaxed);
+            if ((sent - _received.load(std::memory_order_acquire)) == _slots.size())
+            {
+                return false;
+            }
+            _slots[sent & (_slots.size() - 1)] = message;
+            _sent.store((sent + 1), std::memory_order_release);
+            return true;
+        }
+
+        // Only for the receiver. Returns the oldest message which was not received yet.
+        [[nodiscard]] std::optional<T> TryReceive()
+        {
+            const UInt64 received = _received.load(std::memory_order_relaxed);
+            if (received == _sent.load(std::memory_order_acquire))
+            {
+                return std::nullopt;
+            }
+            const T message = *_slots[received & (_slots.size() - 1)];
+            _received.store((received + 1), std::memory_order_release);
+            return message;
+        }
+
+    private:
+        // optional so that messages do not need a default constructor
+        std::vector<std::optional<T>> _slots;
+        // the positions in the sequence of all messages, in separate cache lines because different threads write them
+        alignas(64) std::atomic<UInt64> _sent = 0;
+        alignas(64) std::atomic<UInt64> _received = 0;
+    };
+} // namespace ij
@@ -0,0 +1,70 @@
+#pragma once
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace ij
+{
+    // A binary heap which gives out the smallest element first, for the open lists of path searches. The positions in
+    // the heap are unsigned, unlike the distances of std::push_heap and std::pop_heap which make GCC warn about signed
+    // overflow at -O2.
+    template <class T>
+    struct MinHeap final
+    {
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return _elements.empty();
+        }
+
+        void Clear()
+        {
+            _elements.clear();
+        }
+
+        void Push(T element)
+        {
+            size_t position = _elements.size();
+            _elements.emplace_back(std::move(element));
+            while (position > 0)
+            {
+                const size_t parent = ((position - 1) / 2);
+                if (!(_elements[position] < _elements[parent]))
+                {
+                    break;
+                }
+                std::swap(_elements[position], _elements[parent]);
+                position = parent;
+            }
+        }
+
+        [[nodiscard]] T Pop()
+        {
+            assert(!_elements.empty());
+            T smallest = std::move(_elements.front());
+            _elements.front() = std::move(_elements.back());
+            _elements.pop_back();
+            const size_t count = _elements.size();
+            size_t position = 0;
+            for (;;)
+            {
+                const size_t left = ((2 * position) + 1);
+                if (left >= count)
+                {
+                    break;
+                }
+                const size_t right = (left + 1);
+                const size_t child = (((right < count) && (_elements[right] < _elements[left])) ? right : left);
+                if (!(_elements[child] < _elements[position]))
+                {
+                    break;
+                }
+                std::swap(_elements[position], _elements[child]);
+                position = child;
+            }
+            return smallest;
+        }
+
+    private:
+        std::vector<T> _elements;
+    };
+} // namespace ij
@@ -0,0 +1,86 @@
+#include "NullCanvas.h"
+#include "DrawCommand.h"
+
+ij::Vector2u ij::NullCanvas::GetSize()
+{
+    return Vector2u(1200, 800);
+}
+
+void ij::NullCanvas::DrawDot(const Vector2i &position, const Color color)
+{
+    (void)position;
+    (void)color;
+}
+
+void ij::NullCanvas::DrawRectangle(const Vector2i &topLeft, const Vector2u &size, const Color outline,
+                                   const Color fill, const float outlineThickness)
+{
+    (void)topLeft;
+    (void)size;
+    (void)outline;
+    (void)fill;
+    (void)outlineThickness;
+}
+
+void ij::NullCanvas::DrawSprite(const Sprite &sprite)
+{
+    (void)sprite;
+}
+
+ij::Text ij::NullCanvas::CreateText(const std::string_view content, const FontId font, const Vector2f &position,
+                                    const Color fillColor, const Color outlineColor, const float outlineThickness)
+{
+    (void)content;
+    (void)font;
+    (void)position;
+    (void)fillColor;
+    (void)outlineColor;
+    (void)outlineThickness;
+    return Text(*this, TextId());
+}
+
+void ij::NullCanvas::SetTextPosition(const TextId id, const Vector2f &position)
+{
+    (void)id;
+    (void)position;
+}
+
+ij::Vector2f ij::NullCanvas::GetTextPosition(const TextId id)
+{
+    (void)id;
+    return Vector2f(0, 0);
+}
+
+void ij::NullCanvas::DeleteText(const TextId id)
+{
+    (void)id;
+}
+
+void ij::NullCanvas::DrawText(const TextId id)
+{
+    (void)id;
+}
+
+void ij::NullCanvas::Submit(const std::span<const DrawCommand> commands)
+{
+    SubmitOneByOne(*this, commands);
+}
+
+void ij::NullCanvas::SetView(const Rectangle<float> &view)
+{
+    (void)view;
+}
+
+void ij::NullCanvas::Flush()
+{
+}
+
+ij::UInt64 ij::NullCanvas::GetDrawCallCount()
+{
+    return 0;
+}
+
+ij::TileChunkRenderer *ij::NullCanvas::GetTileChunkRenderer()
+{
+    return nullptr;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "Canvas.h"
+
+namespace ij
+{
+    // Draws nothing. Lets the simulation run without a window, for example in benchmarks.
+    struct NullCanvas final : Canvas
+    {
+        [[nodiscard]] Vector2u GetSize() override;
+        void DrawDot(const Vector2i &position, Color color) override;
+        void DrawRectangle(const Vector2i &topLeft, const Vector2u &size, Color outline, Color fill,
+                           float outlineThickness) override;
+        void DrawSprite(const Sprite &sprite) override;
+        [[nodiscard]] Text CreateText(std::string_view content, FontId font, const Vector2f &position,
+                                      Color fillColor, Color outlineColor, float outlineThickness) override;
+        void SetTextPosition(TextId id, const Vector2f &position) override;
+        [[nodiscard]] Vector2f GetTextPosition(TextId id) override;
+        void DeleteText(TextId id) override;
+        void DrawText(TextId id) override;
+        void Submit(std::span<const DrawCommand> commands) override;
+        void SetView(const Rectangle<float> &view) override;
+        void Flush() override;
+        [[nodiscard]] UInt64 GetDrawCallCount() override;
+        [[nodiscard]] TileChunkRenderer *GetTileChunkRenderer() override;
+    };
+} // namespace ij
@@ -0,0 +1,9 @@
+#include "NullTextureLoader.h"
+
+std::optional<ij::TextureId> ij::NullTextureLoader::LoadFromFile(const std::filesystem::path &textureFile)
+{
+    (void)textureFile;
+    const TextureId result(_nextId);
+    ++_nextId;
+    return result;
+}
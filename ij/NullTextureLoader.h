@@ -0,0 +1,14 @@
+#pragma once
+#include "EnemyTemplate.h"
+
+namespace ij
+{
+    // Hands out texture IDs without loading anything, for running the game without a window.
+    struct NullTextureLoader final : TextureLoader
+    {
+        [[nodiscard]] std::optional<TextureId> LoadFromFile(const std::filesystem::path &textureFile) override;
+
+    private:
+        UInt32 _nextId = 0;
+    };
+} // namespace ij
@@ -0,0 +1,556 @@
+#include "PathFinder.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace ij
+{
+    namespace
+    {
+        struct Step final
+        {
+            Int32 X;
+            Int32 Y;
+            UInt32 Cost;
+        };
+
+        // the same as in FlowField
+        constexpr std::array<Step, 8> steps = {Step{1, 0, 10},   Step{-1, 0, 10}, Step{0, 1, 10},  Step{0, -1, 10},
+                                               Step{1, 1, 14},   Step{-1, -1, 14}, Step{1, -1, 14}, Step{-1, 1, 14}};
+        constexpr UInt32 straightStepCost = 10;
+        constexpr UInt32 unreachable = (std::numeric_limits<UInt32>::max)();
+
+        [[nodiscard]] UInt32 getDistance(const UInt32 from, const UInt32 to)
+        {
+            return ((from > to) ? (from - to) : (to - from));
+        }
+
+        // the cost of the path without walls, which is never more than the real cost
+        [[nodiscard]] UInt32 estimateCost(const TilePosition &from, const TilePosition &to)
+        {
+            const UInt32 x = getDistance(from.x, to.x);
+            const UInt32 y = getDistance(from.y, to.y);
+            return ((straightStepCost * (x + y)) - (6 * (std::min)(x, y)));
+        }
+
+        [[nodiscard]] bool isSameTile(const TilePosition &first, const TilePosition &second)
+        {
+            return (first.x == second.x) && (first.y == second.y);
+        }
+
+        [[nodiscard]] bool contains(const Rectangle<UInt32> &bounds, const Int64 x, const Int64 y)
+        {
+            return (x >= bounds.Position.x) && (y >= bounds.Position.y) &&
+                   (x < (Int64(bounds.Position.x) + bounds.Size.x)) && (y < (Int64(bounds.Position.y) + bounds.Size.y));
+        }
+
+        [[nodiscard]] Rectangle<UInt32> unite(const Rectangle<UInt32> &first, const Rectangle<UInt32> &second)
+        {
+            const UInt32 left = (std::min)(first.Position.x, second.Position.x);
+            const UInt32 top = (std::min)(first.Position.y, second.Position.y);
+            const UInt32 right = (std::max)((first.Position.x + first.Size.x), (second.Position.x + second.Size.x));
+            const UInt32 bottom = (std::max)((first.Position.y + first.Size.y), (second.Position.y + second.Size.y));
+            return Rectangle<UInt32>(Vector2u(left, top), Vector2u((right - left), (bottom - top)));
+        }
+    } // namespace
+} // namespace ij
+
+ij::PathFinder::PathFinder(Map map, const size_t cacheCapacity)
+    : _map(std::move(map))
+    , _widthInChunks(_map.GetWidthInChunks())
+    , _chunkNodes(_map.GetWidthInChunks() * _map.GetHeightInChunks())
+    , _isChunkPrepared(_chunkNodes.size(), 0)
+    , _cacheCapacity(cacheCapacity)
+    , _localBounds(Vector2u(0, 0), Vector2u(0, 0))
+{
+    constexpr UInt32 chunkSize = Map::ChunkSize;
+    const UInt32 width = AssertCast<UInt32>(_map.Width);
+    const UInt32 height = AssertCast<UInt32>(_map.GetHeight());
+    for (UInt32 chunkY = 0; chunkY < _map.GetHeightInChunks(); ++chunkY)
+    {
+        for (UInt32 chunkX = 0; chunkX < _widthInChunks; ++chunkX)
+        {
+            const UInt32 chunk = AssertCast<UInt32>((chunkY * _widthInChunks) + chunkX);
+            const UInt32 left = (chunkX * chunkSize);
+            const UInt32 top = (chunkY * chunkSize);
+            const UInt32 right = (std::min)((left + chunkSize), width);
+            const UInt32 bottom = (std::min)((top + chunkSize), height);
+            if (right < width)
+            {
+                addEntrances(chunk, (chunk + 1), TilePosition((right - 1), top), TilePosition(0, 1), (bottom - top),
+                             TilePosition(1, 0));
+            }
+            if (bottom < height)
+            {
+                addEntrances(chunk, AssertCast<UInt32>(chunk + _widthInChunks), TilePosition(left, (bottom - 1)),
+                             TilePosition(1, 0), (right - left), TilePosition(0, 1));
+            }
+        }
+    }
+    _edges.resize(_nodes.size());
+}
+
+size_t ij::PathFinder::GetNumberOfNodes() const
+{
+    return _nodes.size();
+}
+
+ij::FoundPath ij::PathFinder::FindPath(const TilePosition &start, const TilePosition &goal)
+{
+    const PathRequestId request = RequestPath(start, goal);
+    for (;;)
+    {
+        ProcessRequests((std::numeric_limits<size_t>::max)());
+        std::optional<FoundPath> result = TakeResult(request);
+        if (result)
+        {
+            return std::move(*result);
+        }
+    }
+}
+
+ij::PathRequestId ij::PathFinder::RequestPath(const TilePosition &start, const TilePosition &goal)
+{
+    assert(start.x < _map.Width);
+    assert(start.y < _map.GetHeight());
+    assert(goal.x < _map.Width);
+    assert(goal.y < _map.GetHeight());
+    const PathRequestId id = _nextRequest++;
+    _requests.push_back(Request{id, start, goal});
+    return id;
+}
+
+void ij::PathFinder::ProcessRequests(size_t budget)
+{
+    while (budget > 0)
+    {
+        if (!_search)
+        {
+            if (_requests.empty())
+            {
+                return;
+            }
+            const Request request = _requests.front();
+            _requests.pop_front();
+            ++Statistics.Searches;
+            std::optional<FoundPath> found = startSearch(request, budget);
+            if (found)
+            {
+                _results.emplace(request.Id, std::move(*found));
+                continue;
+            }
+        }
+        std::optional<FoundPath> found = continueSearch(budget);
+        if (!found)
+        {
+            return;
+        }
+        _results.emplace(_search->Searched.Id, std::move(*found));
+        _search.reset();
+    }
+}
+
+std::optional<ij::FoundPath> ij::PathFinder::TakeResult(const PathRequestId request)
+{
+    const auto found = _results.find(request);
+    if (found == _results.end())
+    {
+        return std::nullopt;
+    }
+    FoundPath result = std::move(found->second);
+    _results.erase(found);
+    return result;
+}
+
+std::vector<ij::TilePosition> ij::PathFinder::RefineSegment(const TilePosition &from, const TilePosition &to)
+{
+    const Rectangle<UInt32> bounds = unite(getChunkBounds(getChunk(from)), getChunkBounds(getChunk(to)));
+    (void)searchTiles(from, bounds, to);
+    if (!getTileCost(to))
+    {
+        return {};
+    }
+    std::vector<TilePosition> tiles;
+    TilePosition tile = to;
+    while (!isSameTile(tile, from))
+    {
+        tiles.push_back(tile);
+        const Step &step =
+            steps[_localSteps[((tile.y - bounds.Position.y) * bounds.Size.x) + (tile.x - bounds.Position.x)]];
+        tile = TilePosition(AssertCast<UInt32>(Int64(tile.x) - step.X), AssertCast<UInt32>(Int64(tile.y) - step.Y));
+    }
+    std::ranges::reverse(tiles);
+    return tiles;
+}
+
+bool ij::PathFinder::isWalkable(const UInt32 x, const UInt32 y) const
+{
+    return (_map.GetTileAt(x, y) != NoTile);
+}
+
+ij::UInt32 ij::PathFinder::getChunk(const TilePosition &tile) const
+{
+    return AssertCast<UInt32>(((tile.y / Map::ChunkSize) * _widthInChunks) + (tile.x / Map::ChunkSize));
+}
+
+ij::Rectangle<ij::UInt32> ij::PathFinder::getChunkBounds(const UInt32 chunk) const
+{
+    const UInt32 left = AssertCast<UInt32>((chunk % _widthInChunks) * Map::ChunkSize);
+    const UInt32 top = AssertCast<UInt32>((chunk / _widthInChunks) * Map::ChunkSize);
+    const UInt32 right = AssertCast<UInt32>((std::min)((left + Map::ChunkSize), _map.Width));
+    const UInt32 bottom = AssertCast<UInt32>((std::min)((top + Map::ChunkSize), _map.GetHeight()));
+    return Rectangle<UInt32>(Vector2u(left, top), Vector2u((right - left), (bottom - top)));
+}
+
+void ij::PathFinder::addEntrances(const UInt32 firstChunk, const UInt32 secondChunk, const TilePosition &first,
+                                  const TilePosition &step, const UInt32 length, const TilePosition &across)
+{
+    UInt32 runStart = 0;
+    for (UInt32 i = 0; i <= length; ++i)
+    {
+        const TilePosition tile = (first + (step * i));
+        const TilePosition other = (tile + across);
+        if ((i < length) && isWalkable(tile.x, tile.y) && isWalkable(other.x, other.y))
+        {
+            continue;
+        }
+        if (i > runStart)
+        {
+            const TilePosition middle = (first + (step * (runStart + ((i - runStart - 1) / 2))));
+            const UInt32 node = AssertCast<UInt32>(_nodes.size());
+            _nodes.push_back(Node{middle, firstChunk, (node + 1)});
+            _nodes.push_back(Node{(middle + across), secondChunk, node});
+            _chunkNodes[firstChunk].push_back(node);
+            _chunkNodes[secondChunk].push_back(node + 1);
+        }
+        runStart = (i + 1);
+    }
+}
+
+size_t ij::PathFinder::searchTiles(const TilePosition &origin, const Rectangle<UInt32> &bounds,
+                                   const std::optional<TilePosition> &target)
+{
+    assert(contains(bounds, origin.x, origin.y));
+    _localBounds = bounds;
+    _localCosts.assign((bounds.Size.x * bounds.Size.y), unreachable);
+    _localSteps.resize(_localCosts.size());
+    for (std::vector<UInt32> &bucket : _localBuckets)
+    {
+        bucket.clear();
+    }
+    const auto toIndex = [&bounds](const Int64 x, const Int64 y) {
+        return AssertCast<UInt32>(((y - bounds.Position.y) * bounds.Size.x) + (x - bounds.Position.x));
+    };
+    const UInt32 originIndex = toIndex(origin.x, origin.y);
+    _localCosts[originIndex] = 0;
+    _localBuckets[0].push_back(originIndex);
+    // no tile has this index
+    const UInt32 targetIndex = (target ? toIndex(target->x, target->y) : unreachable);
+    size_t queued = 1;
+    size_t expansions = 0;
+    // the same ring of buckets as in FlowField
+    for (UInt32 cost = 0; queued > 0; ++cost)
+    {
+        std::vector<UInt32> &bucket = _localBuckets[cost % _localBuckets.size()];
+        for (const UInt32 index : bucket)
+        {
+            --queued;
+            if (_localCosts[index] != cost)
+            {
+                continue;
+            }
+            if (index == targetIndex)
+            {
+                bucket.clear();
+                return expansions;
+            }
+            ++expansions;
+            const Int64 x = (bounds.Position.x + (index % bounds.Size.x));
+            const Int64 y = (bounds.Position.y + (index / bounds.Size.x));
+            const auto isWalkableInBounds = [this, &bounds](const Int64 column, const Int64 row) {
+                return contains(bounds, column, row) &&
+                       isWalkable(AssertCast<UInt32>(column), AssertCast<UInt32>(row));
+            };
+            for (size_t i = 0; i < steps.size(); ++i)
+            {
+                const Step &step = steps[i];
+                const Int64 neighbourX = (x + step.X);
+                const Int64 neighbourY = (y + step.Y);
+                if (!isWalkableInBounds(neighbourX, neighbourY))
+                {
+                    continue;
+                }
+                if ((step.X != 0) && (step.Y != 0) &&
+                    (!isWalkableInBounds(neighbourX, y) || !isWalkableInBounds(x, neighbourY)))
+                {
+                    continue;
+                }
+                const UInt32 neighbour = toIndex(neighbourX, neighbourY);
+                const UInt32 neighbourCost = (cost + step.Cost);
+                if (neighbourCost >= _localCosts[neighbour])
+                {
+                    continue;
+                }
+                _localCosts[neighbour] = neighbourCost;
+                _localSteps[neighbour] = AssertCast<std::uint8_t>(i);
+                _localBuckets[neighbourCost % _localBuckets.size()].push_back(neighbour);
+                ++queued;
+            }
+        }
+        bucket.clear();
+    }
+    return expansions;
+}
+
+std::optional<ij::UInt32> ij::PathFinder::getTileCost(const TilePosition &tile) const
+{
+    if (!contains(_localBounds, tile.x, tile.y))
+    {
+        return std::nullopt;
+    }
+    const UInt32 cost = _localCosts[((tile.y - _localBounds.Position.y) * _localBounds.Size.x) +
+                                    (tile.x - _localBounds.Position.x)];
+    if (cost == unreachable)
+    {
+        return std::nullopt;
+    }
+    return cost;
+}
+
+void ij::PathFinder::prepareChunk(const UInt32 chunk, size_t &budget)
+{
+    if (_isChunkPrepared[chunk])
+    {
+        return;
+    }
+    _isChunkPrepared[chunk] = true;
+    ++Statistics.PreparedChunks;
+    const Rectangle<UInt32> bounds = getChunkBounds(chunk);
+    const std::vector<UInt32> &nodes = _chunkNodes[chunk];
+    for (const UInt32 from : nodes)
+    {
+        const size_t expansions = searchTiles(_nodes[from].Tile, bounds, std::nullopt);
+        Statistics.Expansions += expansions;
+        budget -= (std::min)(budget, expansions);
+        for (const UInt32 to : nodes)
+        {
+            const std::optional<UInt32> cost = getTileCost(_nodes[to].Tile);
+            if ((to != from) && cost)
+            {
+                _edges[from].push_back(Edge{to, *cost});
+            }
+        }
+    }
+}
+
+std::optional<ij::FoundPath> ij::PathFinder::startSearch(const Request &request, size_t &budget)
+{
+    const TilePosition &start = request.Start;
+    const TilePosition &goal = request.Goal;
+    if (!isWalkable(start.x, start.y) || !isWalkable(goal.x, goal.y))
+    {
+        return FoundPath();
+    }
+    if (isSameTile(start, goal))
+    {
+        return FoundPath{true, {start}};
+    }
+    const UInt32 startChunk = getChunk(start);
+    const UInt32 goalChunk = getChunk(goal);
+    const Rectangle<UInt32> startBounds = getChunkBounds(startChunk);
+    if (startChunk == goalChunk)
+    {
+        const size_t expansions = searchTiles(start, startBounds, goal);
+        Statistics.Expansions += expansions;
+        budget -= (std::min)(budget, expansions);
+        // otherwise the path leaves the chunk
+        if (getTileCost(goal))
+        {
+            return FoundPath{true, {start, goal}};
+        }
+    }
+    const UInt64 cacheKey = ((UInt64(startChunk) << 32u) | goalChunk);
+    if (startChunk != goalChunk)
+    {
+        std::optional<FoundPath> cached = findCachedPath(request, cacheKey, budget);
+        if (cached)
+        {
+            return cached;
+        }
+    }
+
+    Search search{request, goalChunk, {}, {}};
+    // the costs between start or goal and the nodes of their chunks
+    const auto connect = [this, &budget](const TilePosition &tile, const UInt32 chunk, std::vector<Edge> &edges) {
+        const size_t expansions = searchTiles(tile, getChunkBounds(chunk), std::nullopt);
+        Statistics.Expansions += expansions;
+        budget -= (std::min)(budget, expansions);
+        for (const UInt32 node : _chunkNodes[chunk])
+        {
+            const std::optional<UInt32> cost = getTileCost(_nodes[node].Tile);
+            if (cost)
+            {
+                edges.push_back(Edge{node, *cost});
+            }
+        }
+    };
+    connect(start, startChunk, search.StartEdges);
+    connect(goal, goalChunk, search.GoalEdges);
+    if (search.StartEdges.empty() || search.GoalEdges.empty())
+    {
+        return FoundPath();
+    }
+
+    const UInt32 startNode = AssertCast<UInt32>(_nodes.size());
+    _costs.assign((_nodes.size() + 2), unreachable);
+    _parents.resize(_costs.size());
+    _costs[startNode] = 0;
+    _open.Clear();
+    _open.Push(std::make_pair(estimateCost(start, goal), startNode));
+    _search = std::move(search);
+    return std::nullopt;
+}
+
+std::optional<ij::FoundPath> ij::PathFinder::continueSearch(size_t &budget)
+{
+    assert(_search);
+    const Search &search = *_search;
+    const UInt32 startNode = AssertCast<UInt32>(_nodes.size());
+    const UInt32 goalNode = (startNode + 1);
+    const auto getTile = [this, &search, startNode](const UInt32 node) -> const TilePosition & {
+        if (node < startNode)
+        {
+            return _nodes[node].Tile;
+        }
+        return ((node == startNode) ? search.Searched.Start : search.Searched.Goal);
+    };
+    while (!_open.IsEmpty())
+    {
+        if (budget == 0)
+        {
+            return std::nullopt;
+        }
+        const auto [estimate, node] = _open.Pop();
+        const UInt32 cost = _costs[node];
+        // a cheaper path was found after this one was queued
+        if (estimate != (cost + estimateCost(getTile(node), search.Searched.Goal)))
+        {
+            continue;
+        }
+        if (node == goalNode)
+        {
+            FoundPath found{true, {}};
+            std::vector<UInt32> nodes;
+            for (UInt32 current = _parents[goalNode]; current != startNode; current = _parents[current])
+            {
+                nodes.push_back(current);
+            }
+            std::ranges::reverse(nodes);
+            found.Waypoints.push_back(search.Searched.Start);
+            for (const UInt32 waypoint : nodes)
+            {
+                found.Waypoints.push_back(_nodes[waypoint].Tile);
+            }
+            found.Waypoints.push_back(search.Searched.Goal);
+            const UInt32 startChunk = getChunk(search.Searched.Start);
+            // paths which leave the chunk and come back are rare and not worth a place in the cache
+            if (startChunk != search.GoalChunk)
+            {
+                addToCache(((UInt64(startChunk) << 32u) | search.GoalChunk), std::move(nodes));
+            }
+            return found;
+        }
+        ++Statistics.Expansions;
+        --budget;
+        const auto relax = [&](const UInt32 neighbour, const UInt32 edgeCost) {
+            const UInt32 neighbourCost = (cost + edgeCost);
+            if (neighbourCost >= _costs[neighbour])
+            {
+                return;
+            }
+            _costs[neighbour] = neighbourCost;
+            _parents[neighbour] = node;
+            _open.Push(
+                std::make_pair((neighbourCost + estimateCost(getTile(neighbour), search.Searched.Goal)), neighbour));
+        };
+        if (node == startNode)
+        {
+            for (const Edge &edge : search.StartEdges)
+            {
+                relax(edge.Node, edge.Cost);
+            }
+            continue;
+        }
+        const Node &current = _nodes[node];
+        prepareChunk(current.Chunk, budget);
+        for (const Edge &edge : _edges[node])
+        {
+            relax(edge.Node, edge.Cost);
+        }
+        relax(current.Across, straightStepCost);
+        if (current.Chunk == search.GoalChunk)
+        {
+            for (const Edge &edge : search.GoalEdges)
+            {
+                if (edge.Node == node)
+                {
+                    relax(goalNode, edge.Cost);
+                }
+            }
+        }
+    }
+    return FoundPath();
+}
+
+std::optional<ij::FoundPath> ij::PathFinder::findCachedPath(const Request &request, const UInt64 key,
+                                                            size_t &budget)
+{
+    const auto found = _cacheIndex.find(key);
+    if (found == _cacheIndex.end())
+    {
+        return std::nullopt;
+    }
+    const std::vector<UInt32> &nodes = found->second->Nodes;
+    // the cached path was found from another start to another goal in the same chunks
+    const TilePosition &first = _nodes[nodes.front()].Tile;
+    const TilePosition &last = _nodes[nodes.back()].Tile;
+    size_t expansions = searchTiles(request.Start, getChunkBounds(getChunk(request.Start)), first);
+    bool isConnected = getTileCost(first).has_value();
+    if (isConnected)
+    {
+        expansions += searchTiles(last, getChunkBounds(getChunk(request.Goal)), request.Goal);
+        isConnected = getTileCost(request.Goal).has_value();
+    }
+    Statistics.Expansions += expansions;
+    budget -= (std::min)(budget, expansions);
+    if (!isConnected)
+    {
+        return std::nullopt;
+    }
+    ++Statistics.CacheHits;
+    _cache.splice(_cache.begin(), _cache, found->second);
+    FoundPath path{true, {request.Start}};
+    for (const UInt32 node : nodes)
+    {
+        path.Waypoints.push_back(_nodes[node].Tile);
+    }
+    path.Waypoints.push_back(request.Goal);
+    return path;
+}
+
+void ij::PathFinder::addToCache(const UInt64 key, std::vector<UInt32> nodes)
+{
+    // a path between two chunks always passes at least one entrance
+    assert(!nodes.empty());
+    if ((_cacheCapacity == 0) || _cacheIndex.contains(key))
+    {
+        return;
+    }
+    if (_cache.size() == _cacheCapacity)
+    {
+        _cacheIndex.erase(_cache.back().Key);
+        _cache.pop_back();
+    }
+    _cache.push_front(CachedPath{key, std::move(nodes)});
+    _cacheIndex.emplace(key, _cache.begin());
+}
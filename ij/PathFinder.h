@@ -0,0 +1,149 @@
+#pragma once
+#include "Map.h"
+#include "MinHeap.h"
+#include "TextureCutter.h"
+#include <array>
+#include <deque>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace ij
+{
+    // column and row of a tile
+    using TilePosition = Vector2u;
+
+    using PathRequestId = UInt64;
+
+    struct FoundPath final
+    {
+        bool IsFound = false;
+        // From the start to the goal. Consecutive waypoints are in the same chunk or next to each other across the
+        // border of two chunks, so the tiles in between can be found cheaply by RefineSegment when they are needed.
+        std::vector<TilePosition> Waypoints;
+    };
+
+    struct PathFinderStatistics final
+    {
+        size_t Searches = 0;
+        size_t CacheHits = 0;
+        // tiles and nodes taken from a priority queue, which is what the budget of ProcessRequests limits
+        size_t Expansions = 0;
+        size_t PreparedChunks = 0;
+    };
+
+    // Hierarchical pathfinding (HPA*) with the chunks of a Map as clusters. Where two neighbouring chunks share a run
+    // of walkable tiles along their border, the middle of the run is an entrance with a node on either side. Searches
+    // run on the graph of these nodes and only look at single tiles in the chunks of the start and the goal. The costs
+    // between the nodes of a chunk are computed when a search first reaches the chunk, so large maps cost nothing for
+    // the parts which nobody walks through.
+    // Moves and costs are the same as in FlowField. Paths are shortest paths in the graph, which are usually a little
+    // longer than the shortest paths on the tiles.
+    struct PathFinder final
+    {
+        PathFinderStatistics Statistics;
+
+        // keeps the paths between cacheCapacity pairs of chunks, 0 for no cache
+        PathFinder(Map map, size_t cacheCapacity);
+
+        [[nodiscard]] size_t GetNumberOfNodes() const;
+        // Answers the queued requests first. Start and goal have to be on the map.
+        [[nodiscard]] FoundPath FindPath(const TilePosition &start, const TilePosition &goal);
+        // Queues a search for ProcessRequests. Requests are answered in order.
+        [[nodiscard]] PathRequestId RequestPath(const TilePosition &start, const TilePosition &goal);
+        // Works on the queued requests until about budget expansions were made. A search which does not fit continues
+        // in the next call, so it can be spread over several ticks.
+        void ProcessRequests(size_t budget);
+        // Nothing while the request is queued or being worked on. Returns each result only once.
+        [[nodiscard]] std::optional<FoundPath> TakeResult(PathRequestId request);
+        // The tiles after from up to and including to, for two consecutive waypoints. Empty if there is no path.
+        [[nodiscard]] std::vector<TilePosition> RefineSegment(const TilePosition &from, const TilePosition &to);
+
+    private:
+        struct Node final
+        {
+            TilePosition Tile;
+            UInt32 Chunk;
+            // the node on the other side of the entrance
+            UInt32 Across;
+        };
+
+        struct Edge final
+        {
+            UInt32 Node;
+            UInt32 Cost;
+        };
+
+        struct Request final
+        {
+            PathRequestId Id;
+            TilePosition Start;
+            TilePosition Goal;
+        };
+
+        struct Search final
+        {
+            Request Searched;
+            UInt32 GoalChunk;
+            // from the start to the nodes of its chunk
+            std::vector<Edge> StartEdges;
+            // from the nodes of the goal chunk to the goal
+            std::vector<Edge> GoalEdges;
+        };
+
+        struct CachedPath final
+        {
+            UInt64 Key;
+            // from the first node after the start to the last node before the goal
+            std::vector<UInt32> Nodes;
+        };
+
+        const Map _map;
+        const size_t _widthInChunks;
+        std::vector<Node> _nodes;
+        std::vector<std::vector<UInt32>> _chunkNodes;
+        // within a chunk, only valid for prepared chunks
+        std::vector<std::vector<Edge>> _edges;
+        std::vector<std::uint8_t> _isChunkPrepared;
+
+        // least recently used last
+        const size_t _cacheCapacity;
+        std::list<CachedPath> _cache;
+        std::unordered_map<UInt64, std::list<CachedPath>::iterator> _cacheIndex;
+
+        PathRequestId _nextRequest = 0;
+        std::deque<Request> _requests;
+        std::unordered_map<PathRequestId, FoundPath> _results;
+
+        // the search on the graph which is in progress, with the start and the goal as two extra nodes
+        std::optional<Search> _search;
+        std::vector<UInt32> _costs;
+        std::vector<UInt32> _parents;
+        // pairs of estimated total cost and node
+        MinHeap<std::pair<UInt32, UInt32>> _open;
+
+        // the search on tiles within a rectangle, indexed relative to the rectangle
+        Rectangle<UInt32> _localBounds;
+        std::vector<UInt32> _localCosts;
+        // indices of the steps which reached the tiles
+        std::vector<std::uint8_t> _localSteps;
+        std::array<std::vector<UInt32>, 15> _localBuckets;
+
+        [[nodiscard]] bool isWalkable(UInt32 x, UInt32 y) const;
+        [[nodiscard]] UInt32 getChunk(const TilePosition &tile) const;
+        [[nodiscard]] Rectangle<UInt32> getChunkBounds(UInt32 chunk) const;
+        void addEntrances(UInt32 firstChunk, UInt32 secondChunk, const TilePosition &first, const TilePosition &step,
+                          UInt32 length, const TilePosition &across);
+        // Dijkstra from origin over the tiles within bounds, until target is reached if there is one. Returns the
+        // number of expansions.
+        size_t searchTiles(const TilePosition &origin, const Rectangle<UInt32> &bounds,
+                           const std::optional<TilePosition> &target);
+        [[nodiscard]] std::optional<UInt32> getTileCost(const TilePosition &tile) const;
+        void prepareChunk(UInt32 chunk, size_t &budget);
+        [[nodiscard]] std::optional<FoundPath> startSearch(const Request &request, size_t &budget);
+        [[nodiscard]] std::optional<FoundPath> continueSearch(size_t &budget);
+        [[nodiscard]] std::optional<FoundPath> findCachedPath(const Request &request, UInt64 key, size_t &budget);
+        void addToCache(UInt64 key, std::vector<UInt32> nodes);
+    };
+} // namespace ij
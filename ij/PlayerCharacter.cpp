@@ -2,6 +2,16 @@
 #include "Normalize.h"
 #include <cassert>
 
+namespace ij
+{
+    namespace
+    {
+        // 120 damage per second to every enemy in reach
+        constexpr Int64 attackIntervalInMilliseconds = 50;
+        constexpr Health damagePerAttack = 6;
+    } // namespace
+} // namespace ij
+
 ij::PlayerCharacter::PlayerCharacter(const std::array<bool, 4> &isDirectionKeyPressed, bool &isAttackPressed)
     : isDirectionKeyPressed(isDirectionKeyPressed)
     , isAttackPressed(isAttackPressed)
@@ -13,7 +23,7 @@ void ij::PlayerCharacter::update(LogicEntity &object, LogicEntity &player, World
 {
     assert(&object == &player);
     (void)player;
-    (void)deltaTime;
+    (void)random;
 
     Vector2f direction(0, 0);
     for (size_t i = 0; i < 4; ++i)
@@ -28,10 +38,31 @@ void ij::PlayerCharacter::update(LogicEntity &object, LogicEntity &player, World
     {
         if (isAttackPressed && !isDead(object))
         {
+            const TimeSpan attackInterval = TimeSpan::FromMilliseconds(attackIntervalInMilliseconds);
+            if (object.GetActivity() == ObjectActivity::Attacking)
+            {
+                sinceLastAttack += deltaTime;
+            }
+            else
+            {
+                world.Events.Push(SimulationEvent{SimulationEventType::AttackStarted, PlayerEntity, object.Position, 0,
+                                                  world.SimulatedTicks});
+                // the first blow lands right away
+                sinceLastAttack = attackInterval;
+            }
             object.SetActivity(ObjectActivity::Attacking);
-            for (Object *const enemy : FindEnemiesInCircle(world, object.Position, 100.0f))
+            Health damage = 0;
+            while (sinceLastAttack >= attackInterval)
+            {
+                damage += damagePerAttack;
+                sinceLastAttack -= attackInterval;
+            }
+            if (damage > 0)
             {
-                InflictDamage(enemy->Logic, world, 2, random);
+                for (const size_t enemy : FindEnemiesInCircle(world, object.Position, 100.0f))
+                {
+                    InflictDamageOnEnemy(world, enemy, damage);
+                }
             }
         }
         else
@@ -9,6 +9,8 @@ namespace ij
     {
         const std::array<bool, 4> &isDirectionKeyPressed;
         bool &isAttackPressed;
+        // like Bot::SinceLastAttack, so that the damage per second does not depend on the tick rate
+        TimeSpan sinceLastAttack = TimeSpan::FromMilliseconds(0);
 
         explicit PlayerCharacter(const std::array<bool, 4> &isDirectionKeyPressed, bool &isAttackPressed);
         void update(LogicEntity &object, LogicEntity &player, World &world, TimeSpan deltaTime,
@@ -7,6 +7,11 @@ ij::StandardRandomNumberGenerator::StandardRandomNumberGenerator()
 {
 }
 
+ij::StandardRandomNumberGenerator::StandardRandomNumberGenerator(std::default_random_engine::result_type seed)
+    : engine(seed)
+{
+}
+
 ij::Int32 ij::StandardRandomNumberGenerator::GenerateInt32(Int32 minimum, Int32 maximum)
 {
     std::uniform_int_distribution<Int32> distribution(minimum, maximum);
@@ -18,3 +23,22 @@ size_t ij::StandardRandomNumberGenerator::GenerateSize(size_t minimum, size_t ma
     std::uniform_int_distribution<size_t> distribution(minimum, maximum);
     return distribution(engine);
 }
+
+ij::CounterBasedRandomNumberGenerator::CounterBasedRandomNumberGenerator(const UInt64 seed, const UInt64 tick,
+                                                                         const UInt64 stream) noexcept
+    : _key(MixBits(seed ^ MixBits(tick ^ MixBits(stream))))
+{
+}
+
+size_t ij::CounterBasedRandomNumberGenerator::GenerateSize(const size_t minimum, const size_t maximum)
+{
+    assert(minimum <= maximum);
+    const UInt64 range = AssertCast<UInt64>(maximum - minimum) + 1;
+    const UInt64 generated = GenerateUInt64();
+    if (range == 0)
+    {
+        // the whole range of UInt64
+        return AssertCast<size_t>(generated);
+    }
+    return (minimum + AssertCast<size_t>(generated % range));
+}
@@ -1,9 +1,28 @@
 #pragma once
+#include "AssertCast.h"
 #include "Int.h"
 #include <random>
 
 namespace ij
 {
+    // the finalizer of SplitMix64
+    [[nodiscard]] constexpr UInt64 MixBits(UInt64 value) noexcept
+    {
+        value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9u;
+        value = (value ^ (value >> 27u)) * 0x94d049bb133111ebu;
+        return (value ^ (value >> 31u));
+    }
+
+    // Maps the upper half of the random bits to [minimum, maximum] with a multiplication and a shift instead of a
+    // division, see Lemire: Fast Random Integer Generation in an Interval. The bias is negligible for small ranges.
+    [[nodiscard]] constexpr Int32 ScaleToInt32(const UInt64 randomBits, const Int32 minimum,
+                                               const Int32 maximum) noexcept
+    {
+        const UInt64 range = static_cast<UInt64>(static_cast<Int64>(maximum) - minimum) + 1;
+        const UInt64 offset = ((randomBits >> 32u) * range) >> 32u;
+        return static_cast<Int32>(minimum + static_cast<Int64>(offset));
+    }
+
     struct RandomNumberGenerator
     {
         virtual ~RandomNumberGenerator();
@@ -17,7 +36,35 @@ namespace ij
         std::default_random_engine engine;
 
         StandardRandomNumberGenerator();
+        explicit StandardRandomNumberGenerator(std::default_random_engine::result_type seed);
+        Int32 GenerateInt32(Int32 minimum, Int32 maximum) override;
+        size_t GenerateSize(size_t minimum, size_t maximum) override;
+    };
+
+    // The n-th number of a stream only depends on the seed, the stream and n. Every entity can have its own stream
+    // which makes the results independent from the order in which the entities are simulated.
+    // The simulation uses this type directly instead of the interface so that the hot functions can be inlined.
+    struct CounterBasedRandomNumberGenerator final : RandomNumberGenerator
+    {
+        CounterBasedRandomNumberGenerator(UInt64 seed, UInt64 tick, UInt64 stream) noexcept;
         Int32 GenerateInt32(Int32 minimum, Int32 maximum) override;
         size_t GenerateSize(size_t minimum, size_t maximum) override;
+        [[nodiscard]] UInt64 GenerateUInt64() noexcept;
+
+    private:
+        UInt64 _key;
+        UInt64 _counter = 0;
     };
+
+    inline Int32 CounterBasedRandomNumberGenerator::GenerateInt32(const Int32 minimum, const Int32 maximum)
+    {
+        assert(minimum <= maximum);
+        return ScaleToInt32(GenerateUInt64(), minimum, maximum);
+    }
+
+    inline UInt64 CounterBasedRandomNumberGenerator::GenerateUInt64() noexcept
+    {
+        ++_counter;
+        return MixBits(_key + (_counter * 0x9e3779b97f4a7c15u));
+    }
 } // namespace ij
@@ -0,0 +1,111 @@
+#include "RenderSnapshot.h"
+#include "Camera.h"
+#include "Game.h"
+
+namespace ij
+{
+    namespace
+    {
+        // sprites extend from the logical position of an enemy, so the candidates can be slightly outside of the window
+        [[nodiscard]] Rectangle<float> getCandidateArea(const World &world, const Vector2f &player,
+                                                        const Vector2u &windowSize)
+        {
+            const Vector2f largestSprite = AssertCastVector<float>(world.LargestEnemySprite);
+            return Rectangle<float>(Camera{player}.getWorldFromScreenCoordinates(windowSize, Vector2i(0, 0)) -
+                                        largestSprite,
+                                    AssertCastVector<float>(windowSize) + (largestSprite * 2.0f));
+        }
+    } // namespace
+} // namespace ij
+
+ij::RenderSnapshot::RenderSnapshot(const Game &game)
+    : Font(game.SimulatedWorld.Font)
+    , SimulationSeed(game.SimulatedWorld.SimulationSeed)
+    , map(game.SimulatedWorld.map)
+    , TotalShift(game.SimulatedWorld.TotalShift)
+    , PlayerPosition(game.Player.Logic.Position)
+    , PlayerPreviousPosition(game.Player.Logic.PreviousPosition)
+    , PlayerDirection(game.Player.Logic.Direction)
+    , PlayerCurrentHealth(game.Player.Logic.GetCurrentHealth())
+    , PlayerMaximumHealth(game.Player.Logic.GetMaximumHealth())
+    , PlayerVisuals(game.Player.Visuals)
+    , Events(game.SimulatedWorld.Events)
+{
+}
+
+void ij::AnimateVisibleObjects(Game &game, const Vector2u &windowSize, const TimeSpan timeSinceLastCall)
+{
+    Object &player = game.Player;
+    updateVisuals(player.Logic.GetActivity(), player.Visuals, timeSinceLastCall);
+    World &world = game.SimulatedWorld;
+    const Camera camera{player.Logic.Position};
+    // enemies outside of the view are not animated because nobody can see the difference
+    for (const size_t enemy : FindEnemiesInRectangle(world, getCandidateArea(world, player.Logic.Position, windowSize)))
+    {
+        VisualEntity &visuals = world.enemies.Visuals[enemy];
+        if (camera.canSee(windowSize, world.enemies.Positions[enemy], visuals))
+        {
+            updateVisuals(world.enemies.Activities[enemy], visuals, timeSinceLastCall);
+        }
+    }
+}
+
+void ij::UpdateRenderSnapshot(RenderSnapshot &snapshot, const Game &game, const Vector2u &windowSize)
+{
+    const World &world = game.SimulatedWorld;
+    const LogicEntity &player = game.Player.Logic;
+    snapshot.SimulatedTicks = world.SimulatedTicks;
+    snapshot.map = world.map;
+    // ReplaceMap also moved the events which are already in the copy
+    if ((snapshot.TotalShift.x == world.TotalShift.x) && (snapshot.TotalShift.y == world.TotalShift.y))
+    {
+        snapshot.Events.CopyNewEvents(world.Events);
+    }
+    else
+    {
+        snapshot.Events = world.Events;
+    }
+    snapshot.TotalShift = world.TotalShift;
+    snapshot.PlayerPosition = player.Position;
+    snapshot.PlayerPreviousPosition = player.PreviousPosition;
+    snapshot.PlayerDirection = player.Direction;
+    snapshot.PlayerCurrentHealth = player.GetCurrentHealth();
+    snapshot.PlayerMaximumHealth = player.GetMaximumHealth();
+    snapshot.PlayerVisuals = game.Player.Visuals;
+
+    const EnemyStore &enemies = world.enemies;
+    snapshot.Enemies.clear();
+    for (const size_t enemy : FindEnemiesInRectangle(world, getCandidateArea(world, player.Position, windowSize)))
+    {
+        // enemies which were not updated in the last tick stand still until their next update
+        const Vector2f &previousPosition = (enemies.SimulatedTicks[enemy] == world.SimulatedTicks)
+                                               ? enemies.PreviousPositions[enemy]
+                                               : enemies.Positions[enemy];
+        snapshot.Enemies.push_back(EnemySnapshot{enemy, enemies.Positions[enemy], previousPosition,
+                                                 enemies.Directions[enemy], enemies.CurrentHealth[enemy],
+                                                 enemies.MaximumHealth[enemy], enemies.Visuals[enemy]});
+    }
+
+    snapshot.SelectedEnemy.reset();
+    if (const std::optional<size_t> selected = game.CurrentInput.selectedEnemy)
+    {
+        const size_t enemy = *selected;
+        const Bot &bot = enemies.Bots[enemy];
+        snapshot.SelectedEnemy = SelectedEnemySnapshot{enemy,
+                                                       enemies.CurrentHealth[enemy],
+                                                       enemies.MaximumHealth[enemy],
+                                                       (enemies.HasBumpedIntoWall[enemy] != 0),
+                                                       enemies.Visuals[enemy].Animation,
+                                                       enemies.Directions[enemy],
+                                                       bot.CurrentState,
+                                                       bot.HasTarget};
+    }
+
+    snapshot.NumberOfEnemies = enemies.GetCount();
+    snapshot.LevelOfDetailCountsLastTick = world.LevelOfDetailCountsLastTick;
+}
+
+ij::Vector2f ij::InterpolatePosition(const Vector2f &previous, const Vector2f &current, const float interpolation)
+{
+    return (previous + ((current - previous) * interpolation));
+}
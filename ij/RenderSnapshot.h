@@ -0,0 +1,82 @@
+#pragma once
+#include "Bot.h"
+#include "Canvas.h"
+#include "LevelOfDetail.h"
+#include "Map.h"
+#include "SimulationClock.h"
+#include "SimulationEvents.h"
+#include "VisualEntity.h"
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace ij
+{
+    struct Game;
+
+    struct EnemySnapshot final
+    {
+        // into World::enemies when the snapshot was taken
+        size_t Index;
+        Vector2f Position;
+        // see EnemyStore::PreviousPositions
+        Vector2f PreviousPosition;
+        Vector2f Direction;
+        Health CurrentHealth;
+        Health MaximumHealth;
+        VisualEntity Visuals;
+    };
+
+    // Input::selectedEnemy for the user interface
+    struct SelectedEnemySnapshot final
+    {
+        size_t Index;
+        Health CurrentHealth;
+        Health MaximumHealth;
+        bool HasBumpedIntoWall;
+        ObjectAnimation Animation;
+        Vector2f Direction;
+        Bot::State BotState;
+        bool HasBotTarget;
+    };
+
+    // Everything DrawWorld and the user interface need from a game, copied so that they can run on another thread
+    // while the simulation continues.
+    struct RenderSnapshot final
+    {
+        UInt64 SimulatedTicks = 0;
+        // set by SimulationThread to interpolate between the ticks until the next snapshot
+        std::chrono::steady_clock::time_point LastTickTime;
+        FontId Font;
+        UInt64 SimulationSeed;
+        // shares the tiles with the map of the world
+        Map map;
+        // see World::TotalShift
+        Vector2f TotalShift;
+        Vector2f PlayerPosition;
+        Vector2f PlayerPreviousPosition;
+        Vector2f PlayerDirection;
+        Health PlayerCurrentHealth;
+        Health PlayerMaximumHealth;
+        VisualEntity PlayerVisuals;
+        // the enemies around the player which may be visible, in the order of World::enemies
+        std::vector<EnemySnapshot> Enemies;
+        std::optional<SelectedEnemySnapshot> SelectedEnemy;
+        // A copy of all of World::Events, so that positions in the queue stay valid from snapshot to snapshot no matter
+        // how many snapshots the reader skips. Usually only the new events have to be copied.
+        SimulationEventQueue Events;
+        size_t NumberOfEnemies = 0;
+        LevelOfDetailCounts LevelOfDetailCountsLastTick;
+        CatchUpStatistics CatchUp;
+
+        explicit RenderSnapshot(const Game &game);
+    };
+
+    // Advances the animations of the player and the enemies which may be visible in a window of this size around the
+    // player. The animations only exist for drawing, so they do not affect the simulation.
+    void AnimateVisibleObjects(Game &game, const Vector2u &windowSize, TimeSpan timeSinceLastCall);
+    // Reuses the memory of snapshot. The enemies are the candidates for a window of this size around the player.
+    void UpdateRenderSnapshot(RenderSnapshot &snapshot, const Game &game, const Vector2u &windowSize);
+    // between the position before the last tick and the current one, see SimulationClock::GetInterpolation
+    [[nodiscard]] Vector2f InterpolatePosition(const Vector2f &previous, const Vector2f &current, float interpolation);
+} // namespace ij
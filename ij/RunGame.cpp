@@ -1,15 +1,21 @@
 #include "RunGame.h"
 #include "DrawWorld.h"
-#include "PlayerCharacter.h"
+#include "InputRecording.h"
+#include "MapFile.h"
+#include "SaveGame.h"
+#include "SimulationThread.h"
 #include "UserInterface.h"
+#include <charconv>
+#include <fstream>
 #include <iostream>
+#include <string_view>
 
 ij::WindowFunctions::~WindowFunctions()
 {
 }
 
 [[nodiscard]] bool ij::RunGame(TextureLoader &textures, Canvas &canvas, const std::filesystem::path &assets,
-                               WindowFunctions &window)
+                               WindowFunctions &window, const GameOptions &options)
 {
     using namespace ij;
 
@@ -38,42 +44,164 @@ ij::WindowFunctions::~WindowFunctions()
         return false;
     }
 
-    Input input;
-    StandardRandomNumberGenerator randomNumberGenerator;
-    const Map map = GenerateRandomMap(randomNumberGenerator);
+    std::optional<Map> map;
+    if (options.MapFile)
+    {
+        if (options.IsWorldInfinite)
+        {
+            std::cerr << "An infinite world has no map file\n";
+            return false;
+        }
+        // a recording only contains the settings for generating a map, so its replay would run on another one
+        if (options.InputRecordingFile)
+        {
+            std::cerr << "The input of a game on a map file can not be recorded\n";
+            return false;
+        }
+        map = LoadMapFile(*options.MapFile);
+        if (!map)
+        {
+            std::cerr << "Could not load map " << options.MapFile->string() << '\n';
+            return false;
+        }
+    }
 
-    constexpr float enemiesPerTile = 0.02f;
-    const size_t numberOfEnemies = static_cast<size_t>(AssertCast<float>(map.Tiles.size()) * enemiesPerTile);
-    World world(0, map, canvas);
-    SpawnEnemies(world, numberOfEnemies, *maybeEnemies, randomNumberGenerator);
+    GameSettings settings;
+    settings.Seed = std::random_device()();
+    settings.IsWorldInfinite = options.IsWorldInfinite;
+    std::optional<SaveGameSnapshot> savedGame;
+    if (options.SaveGameFile)
+    {
+        if (settings.IsWorldInfinite)
+        {
+            std::cerr << "An infinite world can not be saved\n";
+            return false;
+        }
+        // a new game if the file does not exist yet
+        savedGame = ReadSaveGame(*options.SaveGameFile);
+        if (savedGame && options.InputRecordingFile)
+        {
+            std::cerr << "The input of a loaded game can not be recorded\n";
+            return false;
+        }
+        if (savedGame)
+        {
+            settings = savedGame->Settings;
+        }
+    }
+    if (options.TicksPerSecond)
+    {
+        if ((*options.TicksPerSecond == 0) || (*options.TicksPerSecond > MaximumTicksPerSecond))
+        {
+            std::cerr << "The tick rate has to be between 1 and " << MaximumTicksPerSecond << '\n';
+            return false;
+        }
+        settings.TicksPerSecond = *options.TicksPerSecond;
+    }
+    Game game(settings, *maybeEnemies, *wolfsheet1Texture, std::move(map));
+
+    std::unique_ptr<SaveGameWriter> saveGameWriter;
+    if (options.SaveGameFile)
+    {
+        if (savedGame && !RestoreSaveGame(game, *savedGame))
+        {
+            std::cerr << options.SaveGameFile->string() << " does not fit the map\n";
+            return false;
+        }
+        saveGameWriter = OpenSaveGame(*options.SaveGameFile);
+        if (!saveGameWriter)
+        {
+            std::cerr << "Could not open save game " << options.SaveGameFile->string() << '\n';
+            return false;
+        }
+    }
+
+    std::ofstream inputRecordingStream;
+    std::optional<InputRecorder> inputRecorder;
+    if (options.InputRecordingFile)
+    {
+        if (options.IsSimulationThreaded)
+        {
+            std::cerr << "The input of a threaded simulation can not be recorded\n";
+            return false;
+        }
+        inputRecordingStream.open(*options.InputRecordingFile, std::ios::binary);
+        if (!inputRecordingStream)
+        {
+            std::cerr << "Could not create input recording " << options.InputRecordingFile->string() << '\n';
+            return false;
+        }
+        inputRecorder.emplace(inputRecordingStream, settings);
+    }
 
-    Object player(VisualEntity(*wolfsheet1Texture, Vector2u(64, 64), 0, TimeSpan::FromMilliseconds(0), CutWolfTexture,
-                               ObjectAnimation::Standing),
-                  LogicEntity(std::make_unique<PlayerCharacter>(input.isDirectionKeyPressed, input.isAttackPressed),
-                              GenerateRandomPointForSpawning(world, randomNumberGenerator), Vector2f(0, 0), true, false,
-                              100, 100, ObjectActivity::Standing));
+    WorkerPool workers(GetDefaultNumberOfWorkers());
+    WorkerPool noWorkers(0);
+    SimulationClock simulationClock(game.SimulatedWorld.TimeStep);
+    SimulationControls controls = GetSimulationControls(game, simulationClock);
+    // the input as the render thread sees it; the simulation gets a copy in every frame
+    Input input;
+    const auto createInputMessage = [&input, &canvas, &controls](const std::optional<Vector2f> &selectionClick) {
+        return InputMessage{input.isDirectionKeyPressed, input.isAttackPressed, input.isDebugModeOn, selectionClick,
+                            canvas.GetSize(), controls};
+    };
+    // Without a simulation thread, the simulation runs on this thread between the frames and the snapshot is taken
+    // from the game directly.
+    std::optional<RenderSnapshot> ownSnapshot;
+    std::optional<SimulationThread> simulation;
+    if (options.IsSimulationThreaded)
+    {
+        simulation.emplace(game, workers, saveGameWriter.get(), createInputMessage(std::nullopt));
+    }
+    else
+    {
+        ownSnapshot.emplace(game);
+        UpdateRenderSnapshot(*ownSnapshot, game, canvas.GetSize());
+    }
 
-    Camera camera{player.Logic.Position};
+    // the game must not be touched here any more while the simulation thread is running
+    const RenderSnapshot &firstSnapshot = (simulation ? simulation->GetLatestSnapshot() : *ownSnapshot);
+    Camera camera{firstSnapshot.PlayerPosition};
+    WorldPresentation presentation(firstSnapshot);
     Debugging debugging;
-    TimeSpan remainingSimulationTime = TimeSpan::FromMilliseconds(0);
+    std::vector<DrawCommand> drawCommands;
     while (window.IsOpen())
     {
-        window.ProcessEvents(input, camera, world);
+        std::optional<Vector2f> selectionClick;
+        window.ProcessEvents(input, camera, selectionClick);
 
         const TimeSpan deltaTime = window.RestartDeltaClock();
         debugging.FrameTimes[debugging.NextFrameTime] = AssertCast<float>(deltaTime.Milliseconds);
         debugging.NextFrameTime = (debugging.NextFrameTime + 1) % debugging.FrameTimes.size();
 
-        // fix the time step to make physics and NPC behaviour independent from the frame rate
-        remainingSimulationTime += deltaTime;
-        UpdateWorld(remainingSimulationTime, player.Logic, world, randomNumberGenerator);
+        const InputMessage message = createInputMessage(selectionClick);
+        if (simulation)
+        {
+            simulation->SendInput(message);
+        }
+        else
+        {
+            ApplyInputMessage(game, simulationClock, message);
+            AdvanceSimulation(game, simulationClock, deltaTime,
+                              (controls.IsSimulationParallel ? workers : noWorkers),
+                              (inputRecorder ? &*inputRecorder : nullptr), saveGameWriter.get());
+            AnimateVisibleObjects(game, message.WindowSize, deltaTime);
+            UpdateRenderSnapshot(*ownSnapshot, game, message.WindowSize);
+            ownSnapshot->CatchUp = simulationClock.Statistics;
+        }
+        const RenderSnapshot &snapshot = (simulation ? simulation->GetLatestSnapshot() : *ownSnapshot);
+        input.selectedEnemy =
+            (snapshot.SelectedEnemy ? std::optional<size_t>(snapshot.SelectedEnemy->Index) : std::nullopt);
 
         window.UpdateGui(deltaTime);
-        UpdateUserInterface(player.Logic, world, input, debugging);
+        UpdateUserInterface(snapshot, input, debugging, controls);
 
         window.Clear();
+        const UInt64 drawCallsBefore = canvas.GetDrawCallCount();
 
-        camera.Center = player.Logic.Position;
+        // the simulation may run fewer ticks per second than there are frames
+        const float interpolation =
+            (simulation ? simulation->GetInterpolation(snapshot) : simulationClock.GetInterpolation());
+        camera.Center = InterpolatePosition(snapshot.PlayerPreviousPosition, snapshot.PlayerPosition, interpolation);
         const Vector2f windowSize = AssertCastVector<float>(canvas.GetSize());
         Vector2f viewSize = windowSize;
         if (debugging.IsZoomedOut)
@@ -83,7 +211,8 @@ ij::WindowFunctions::~WindowFunctions()
         canvas.SetView(
             Rectangle<float>(camera.Center - (windowSize / 2.0f) + ((windowSize - viewSize) / 2.0f), viewSize));
 
-        DrawWorld(canvas, camera, input, debugging, world, player, *grassTexture, deltaTime);
+        DrawWorld(canvas, camera, input, debugging, snapshot, interpolation, presentation, *grassTexture, deltaTime,
+                  drawCommands);
 
         if (debugging.IsZoomedOut)
         {
@@ -91,9 +220,69 @@ ij::WindowFunctions::~WindowFunctions()
                                  canvas.GetSize(), Color(255, 0, 0, 255), Color(0, 0, 0, 0), 2);
         }
 
+        canvas.Flush();
+        debugging.DrawCallsLastFrame = (canvas.GetDrawCallCount() - drawCallsBefore);
         window.RenderGui();
         window.Display();
     }
 
+    // the game belongs to the simulation thread until it has stopped
+    simulation.reset();
+    if (saveGameWriter)
+    {
+        saveGameWriter->Submit(TakeSaveGameSnapshot(game));
+        saveGameWriter->WaitUntilWritten();
+        const SaveGameStatistics statistics = saveGameWriter->GetStatistics();
+        if (statistics.HasFailed)
+        {
+            std::cerr << "Could not write save game " << options.SaveGameFile->string() << " ("
+                      << statistics.FailedTransactions << " failed transactions)\n";
+            return false;
+        }
+    }
     return true;
-}
\ No newline at end of file
+}
+
+ij::GameOptions ij::ParseGameOptions(const int argc, char **const argv)
+{
+    GameOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if ((argument == "--record-input") && ((i + 1) < argc))
+        {
+            ++i;
+            options.InputRecordingFile = std::filesystem::path(argv[i]);
+        }
+        else if ((argument == "--map") && ((i + 1) < argc))
+        {
+            ++i;
+            options.MapFile = std::filesystem::path(argv[i]);
+        }
+        else if ((argument == "--save-game") && ((i + 1) < argc))
+        {
+            ++i;
+            options.SaveGameFile = std::filesystem::path(argv[i]);
+        }
+        else if (argument == "--infinite-world")
+        {
+            options.IsWorldInfinite = true;
+        }
+        else if (argument == "--threaded-simulation")
+        {
+            options.IsSimulationThreaded = true;
+        }
+        else if ((argument == "--tick-rate") && ((i + 1) < argc))
+        {
+            ++i;
+            const std::string_view value = argv[i];
+            unsigned ticksPerSecond = 0;
+            const std::from_chars_result result =
+                std::from_chars(value.data(), (value.data() + value.size()), ticksPerSecond);
+            // RunGame rejects 0
+            options.TicksPerSecond =
+                ((result.ec == std::errc()) && (result.ptr == (value.data() + value.size()))) ? ticksPerSecond : 0;
+        }
+    }
+    return options;
+}
@@ -9,7 +9,8 @@ namespace ij
     {
         virtual ~WindowFunctions() = 0;
         [[nodiscard]] virtual bool IsOpen() = 0;
-        virtual void ProcessEvents(Input &input, const Camera &camera, World &world) = 0;
+        // Sets selectionClick to the point in the world where the player clicked to select an enemy, if they did.
+        virtual void ProcessEvents(Input &input, const Camera &camera, std::optional<Vector2f> &selectionClick) = 0;
         virtual void UpdateGui(TimeSpan deltaTime) = 0;
         virtual void Clear() = 0;
         virtual void RenderGui() = 0;
@@ -17,6 +18,25 @@ namespace ij
         [[nodiscard]] virtual TimeSpan RestartDeltaClock() = 0;
     };
 
+    struct GameOptions final
+    {
+        // writes the input of the session to this file if set, see InputRecorder
+        std::optional<std::filesystem::path> InputRecordingFile;
+        bool IsWorldInfinite = false;
+        // instead of a generated map, see LoadMapFile. Neither for an infinite world nor together with an input
+        // recording, which only knows how to generate the map.
+        std::optional<std::filesystem::path> MapFile;
+        // continues the game saved in this file if there is one and saves into it regularly, see SaveGameWriter
+        std::optional<std::filesystem::path> SaveGameFile;
+        // runs the simulation on a thread of its own, see SimulationThread
+        bool IsSimulationThreaded = false;
+        // replaces GameSettings::TicksPerSecond, also of a loaded game
+        std::optional<unsigned> TicksPerSecond;
+    };
+
     [[nodiscard]] bool RunGame(TextureLoader &textures, Canvas &canvas, const std::filesystem::path &assets,
-                               WindowFunctions &window);
+                               WindowFunctions &window, const GameOptions &options);
+    // Understands "--record-input <file>", "--infinite-world", "--map <file>", "--save-game <file>",
+    // "--threaded-simulation" and "--tick-rate <ticks per second>".
+    [[nodiscard]] GameOptions ParseGameOptions(int argc, char **argv);
 } // namespace ij
@@ -0,0 +1,498 @@
+#include "SaveGame.h"
+#include <algorithm>
+#include <iterator>
+#include <sqlite3.h>
+#include <utility>
+
+namespace ij
+{
+    namespace
+    {
+        // stored in the game table so that an incompatible save game is never half understood
+        constexpr Int64 saveGameVersion = 2;
+
+        constexpr const char *createTables = "CREATE TABLE IF NOT EXISTS game ("
+                                             "id INTEGER PRIMARY KEY CHECK (id = 0), version INTEGER, seed INTEGER, "
+                                             "settings_map_width INTEGER, settings_map_height INTEGER, "
+                                             "enemies_per_tile REAL, map_width INTEGER, map_height INTEGER, "
+                                             "number_of_enemies INTEGER, simulated_ticks INTEGER, player_x REAL, "
+                                             "player_y REAL, player_direction_x REAL, player_direction_y REAL, "
+                                             "player_health INTEGER, player_maximum_health INTEGER, "
+                                             "player_activity INTEGER, player_has_bumped_into_wall INTEGER, "
+                                             "ticks_per_second INTEGER);"
+                                             "CREATE TABLE IF NOT EXISTS enemies ("
+                                             "id INTEGER PRIMARY KEY, x REAL, y REAL, direction_x REAL, "
+                                             "direction_y REAL, health INTEGER, activity INTEGER, "
+                                             "has_bumped_into_wall INTEGER, bot_state INTEGER, bot_has_target INTEGER, "
+                                             "bot_since_last_attack INTEGER, simulated_ticks INTEGER);";
+
+        constexpr const char *gameColumns =
+            "version, seed, settings_map_width, settings_map_height, enemies_per_tile, map_width, map_height, "
+            "number_of_enemies, simulated_ticks, player_x, player_y, player_direction_x, player_direction_y, "
+            "player_health, player_maximum_health, player_activity, player_has_bumped_into_wall, ticks_per_second";
+
+        constexpr const char *enemyColumns = "id, x, y, direction_x, direction_y, health, activity, "
+                                             "has_bumped_into_wall, bot_state, bot_has_target, "
+                                             "bot_since_last_attack, simulated_ticks";
+
+        struct ConnectionDeleter final
+        {
+            void operator()(sqlite3 *const connection) const
+            {
+                sqlite3_close(connection);
+            }
+        };
+
+        struct StatementDeleter final
+        {
+            void operator()(sqlite3_stmt *const statement) const
+            {
+                sqlite3_finalize(statement);
+            }
+        };
+
+        using Connection = std::unique_ptr<sqlite3, ConnectionDeleter>;
+        using Statement = std::unique_ptr<sqlite3_stmt, StatementDeleter>;
+
+        [[nodiscard]] Connection openConnection(const std::filesystem::path &file, const int flags)
+        {
+            sqlite3 *connection = nullptr;
+            const int result =
+                sqlite3_open_v2(reinterpret_cast<const char *>(file.u8string().c_str()), &connection, flags, nullptr);
+            // the connection has to be closed even if opening failed
+            Connection owned(connection);
+            if (result != SQLITE_OK)
+            {
+                return nullptr;
+            }
+            return owned;
+        }
+
+        [[nodiscard]] bool execute(sqlite3 *const connection, const char *const sql)
+        {
+            return (sqlite3_exec(connection, sql, nullptr, nullptr, nullptr) == SQLITE_OK);
+        }
+
+        [[nodiscard]] Statement prepare(sqlite3 *const connection, const std::string &sql)
+        {
+            sqlite3_stmt *statement = nullptr;
+            if (sqlite3_prepare_v3(connection, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &statement, nullptr) !=
+                SQLITE_OK)
+            {
+                sqlite3_finalize(statement);
+                return nullptr;
+            }
+            return Statement(statement);
+        }
+
+        // for statements which do not return rows
+        [[nodiscard]] bool run(sqlite3_stmt *const statement)
+        {
+            const int result = sqlite3_step(statement);
+            sqlite3_reset(statement);
+            return (result == SQLITE_DONE);
+        }
+
+        void bindReal(sqlite3_stmt *const statement, const int parameter, const float value)
+        {
+            sqlite3_bind_double(statement, parameter, static_cast<double>(value));
+        }
+
+        template <class Integer>
+        void bindInteger(sqlite3_stmt *const statement, const int parameter, const Integer value)
+        {
+            sqlite3_bind_int64(statement, parameter, AssertCast<Int64>(value));
+        }
+
+        // returns nothing if the stored number does not fit into Integer
+        template <class Integer>
+        [[nodiscard]] std::optional<Integer> readInteger(sqlite3_stmt *const statement, const int column)
+        {
+            const sqlite3_int64 value = sqlite3_column_int64(statement, column);
+            if (!std::in_range<Integer>(value))
+            {
+                return std::nullopt;
+            }
+            return static_cast<Integer>(value);
+        }
+
+        [[nodiscard]] float readReal(sqlite3_stmt *const statement, const int column)
+        {
+            return static_cast<float>(sqlite3_column_double(statement, column));
+        }
+
+        [[nodiscard]] std::optional<ObjectActivity> readActivity(sqlite3_stmt *const statement, const int column)
+        {
+            const std::optional<Int32> activity = readInteger<Int32>(statement, column);
+            if (!activity || (*activity < 0) || (*activity > static_cast<Int32>(ObjectActivity::Dead)))
+            {
+                return std::nullopt;
+            }
+            return static_cast<ObjectActivity>(*activity);
+        }
+    } // namespace
+
+    struct SaveGameDatabase final
+    {
+        Connection Database;
+        Statement Begin;
+        Statement Commit;
+        Statement Rollback;
+        Statement WriteGame;
+        Statement WriteEnemy;
+        // enemies beyond the number in the game, which are left over from a previous game in the same file
+        Statement DeleteRemovedEnemies;
+    };
+
+    namespace
+    {
+        [[nodiscard]] bool writeEnemy(sqlite3_stmt *const statement, const SavedEnemy &enemy)
+        {
+            bindInteger(statement, 1, enemy.Index);
+            bindReal(statement, 2, enemy.Position.x);
+            bindReal(statement, 3, enemy.Position.y);
+            bindReal(statement, 4, enemy.Direction.x);
+            bindReal(statement, 5, enemy.Direction.y);
+            bindInteger(statement, 6, enemy.CurrentHealth);
+            bindInteger(statement, 7, static_cast<Int32>(enemy.Activity));
+            bindInteger(statement, 8, static_cast<Int32>(enemy.HasBumpedIntoWall));
+            bindInteger(statement, 9, static_cast<Int32>(enemy.BotState.CurrentState));
+            bindInteger(statement, 10, static_cast<Int32>(enemy.BotState.HasTarget));
+            bindInteger(statement, 11, enemy.BotState.SinceLastAttack.Milliseconds);
+            bindInteger(statement, 12, enemy.SimulatedTicks);
+            return run(statement);
+        }
+
+        [[nodiscard]] bool writeGame(sqlite3_stmt *const statement, const SaveGameSnapshot &snapshot)
+        {
+            const SavedPlayer &player = snapshot.Player;
+            bindInteger(statement, 1, saveGameVersion);
+            bindInteger(statement, 2, snapshot.Settings.Seed);
+            bindInteger(statement, 3, snapshot.Settings.MapWidth);
+            bindInteger(statement, 4, snapshot.Settings.MapHeight);
+            bindReal(statement, 5, snapshot.Settings.EnemiesPerTile);
+            bindInteger(statement, 6, snapshot.MapWidth);
+            bindInteger(statement, 7, snapshot.MapHeight);
+            bindInteger(statement, 8, snapshot.NumberOfEnemies);
+            bindInteger(statement, 9, snapshot.SimulatedTicks);
+            bindReal(statement, 10, player.Position.x);
+            bindReal(statement, 11, player.Position.y);
+            bindReal(statement, 12, player.Direction.x);
+            bindReal(statement, 13, player.Direction.y);
+            bindInteger(statement, 14, player.CurrentHealth);
+            bindInteger(statement, 15, player.MaximumHealth);
+            bindInteger(statement, 16, static_cast<Int32>(player.Activity));
+            bindInteger(statement, 17, static_cast<Int32>(player.HasBumpedIntoWall));
+            bindInteger(statement, 18, snapshot.Settings.TicksPerSecond);
+            return run(statement);
+        }
+
+        // Writes all snapshots in one transaction and returns the number of rows written. Only the game row of the
+        // latest snapshot matters, so the others are skipped.
+        [[nodiscard]] std::optional<size_t> writeSnapshots(SaveGameDatabase &database,
+                                                           const std::deque<SaveGameSnapshot> &snapshots)
+        {
+            assert(!snapshots.empty());
+            if (!run(database.Begin.get()))
+            {
+                return std::nullopt;
+            }
+            size_t rows = 0;
+            bool isSuccess = true;
+            for (const SaveGameSnapshot &snapshot : snapshots)
+            {
+                for (const SavedEnemy &enemy : snapshot.Enemies)
+                {
+                    isSuccess = (isSuccess && writeEnemy(database.WriteEnemy.get(), enemy));
+                }
+                rows += snapshot.Enemies.size();
+            }
+            const SaveGameSnapshot &latest = snapshots.back();
+            isSuccess = (isSuccess && writeGame(database.WriteGame.get(), latest));
+            bindInteger(database.DeleteRemovedEnemies.get(), 1, latest.NumberOfEnemies);
+            isSuccess = (isSuccess && run(database.DeleteRemovedEnemies.get()));
+            if (!isSuccess || !run(database.Commit.get()))
+            {
+                (void)run(database.Rollback.get());
+                return std::nullopt;
+            }
+            return (rows + 1);
+        }
+
+        [[nodiscard]] std::optional<SavedEnemy> readEnemy(sqlite3_stmt *const statement)
+        {
+            const std::optional<UInt64> index = readInteger<UInt64>(statement, 0);
+            const std::optional<Health> health = readInteger<Health>(statement, 5);
+            const std::optional<ObjectActivity> activity = readActivity(statement, 6);
+            const std::optional<Int32> botState = readInteger<Int32>(statement, 8);
+            const std::optional<UInt64> simulatedTicks = readInteger<UInt64>(statement, 11);
+            if (!index || !health || !activity || !botState || (*botState < 0) ||
+                (*botState > static_cast<Int32>(Bot::State::Attacking)) || !simulatedTicks)
+            {
+                return std::nullopt;
+            }
+            Bot bot;
+            bot.CurrentState = static_cast<Bot::State>(*botState);
+            bot.HasTarget = (sqlite3_column_int64(statement, 9) != 0);
+            bot.SinceLastAttack = TimeSpan::FromMilliseconds(sqlite3_column_int64(statement, 10));
+            return SavedEnemy{*index,
+                              Vector2f(readReal(statement, 1), readReal(statement, 2)),
+                              Vector2f(readReal(statement, 3), readReal(statement, 4)),
+                              *health,
+                              *activity,
+                              (sqlite3_column_int64(statement, 7) != 0),
+                              bot,
+                              *simulatedTicks};
+        }
+
+        [[nodiscard]] std::optional<SaveGameSnapshot> readGame(sqlite3_stmt *const statement)
+        {
+            const std::optional<Int32> version = readInteger<Int32>(statement, 0);
+            const std::optional<UInt32> seed = readInteger<UInt32>(statement, 1);
+            const std::optional<size_t> settingsMapWidth = readInteger<size_t>(statement, 2);
+            const std::optional<size_t> settingsMapHeight = readInteger<size_t>(statement, 3);
+            const std::optional<size_t> mapWidth = readInteger<size_t>(statement, 5);
+            const std::optional<size_t> mapHeight = readInteger<size_t>(statement, 6);
+            const std::optional<size_t> numberOfEnemies = readInteger<size_t>(statement, 7);
+            const std::optional<UInt64> simulatedTicks = readInteger<UInt64>(statement, 8);
+            const std::optional<Health> health = readInteger<Health>(statement, 13);
+            const std::optional<Health> maximumHealth = readInteger<Health>(statement, 14);
+            const std::optional<ObjectActivity> activity = readActivity(statement, 15);
+            const std::optional<unsigned> ticksPerSecond = readInteger<unsigned>(statement, 17);
+            if (!version || (*version != saveGameVersion) || !seed || !settingsMapWidth || !settingsMapHeight ||
+                !mapWidth || !mapHeight || !numberOfEnemies || !simulatedTicks || !health || !maximumHealth ||
+                !activity || !ticksPerSecond || (*ticksPerSecond == 0) || (*ticksPerSecond > MaximumTicksPerSecond))
+            {
+                return std::nullopt;
+            }
+            GameSettings settings;
+            settings.Seed = *seed;
+            settings.MapWidth = *settingsMapWidth;
+            settings.MapHeight = *settingsMapHeight;
+            settings.EnemiesPerTile = readReal(statement, 4);
+            settings.TicksPerSecond = *ticksPerSecond;
+            const SavedPlayer player{Vector2f(readReal(statement, 9), readReal(statement, 10)),
+                                     Vector2f(readReal(statement, 11), readReal(statement, 12)),
+                                     *health,
+                                     *maximumHealth,
+                                     *activity,
+                                     (sqlite3_column_int64(statement, 16) != 0)};
+            return SaveGameSnapshot{settings, *mapWidth, *mapHeight, *numberOfEnemies, *simulatedTicks, player, {}};
+        }
+    } // namespace
+} // namespace ij
+
+ij::SaveGameSnapshot ij::TakeSaveGameSnapshot(Game &game)
+{
+    assert(!game.Streaming);
+    World &world = game.SimulatedWorld;
+    const LogicEntity &player = game.Player.Logic;
+    EnemyStore &enemies = world.enemies;
+    SaveGameSnapshot snapshot{game.Settings,
+                              world.map.Width,
+                              world.map.GetHeight(),
+                              enemies.GetCount(),
+                              world.SimulatedTicks,
+                              SavedPlayer{player.Position, player.Direction, player.GetCurrentHealth(),
+                                          player.GetMaximumHealth(), player.GetActivity(), player.HasBumpedIntoWall},
+                              {}};
+    for (size_t i = 0; i < enemies.GetCount(); ++i)
+    {
+        if (!enemies.IsDirty[i])
+        {
+            continue;
+        }
+        enemies.IsDirty[i] = false;
+        snapshot.Enemies.push_back(SavedEnemy{AssertCast<UInt64>(i), enemies.Positions[i], enemies.Directions[i],
+                                              enemies.CurrentHealth[i], enemies.Activities[i],
+                                              !!enemies.HasBumpedIntoWall[i], enemies.Bots[i],
+                                              enemies.SimulatedTicks[i]});
+    }
+    return snapshot;
+}
+
+ij::SaveGameWriter::SaveGameWriter(std::unique_ptr<SaveGameDatabase> database)
+    : _database(std::move(database))
+    , _thread(&SaveGameWriter::run, this)
+{
+    assert(_database);
+}
+
+ij::SaveGameWriter::~SaveGameWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _submitted.notify_one();
+    _thread.join();
+}
+
+void ij::SaveGameWriter::Submit(SaveGameSnapshot snapshot)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push_back(std::move(snapshot));
+    }
+    _submitted.notify_one();
+}
+
+void ij::SaveGameWriter::WaitUntilWritten()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _written.wait(lock, [this]() { return (_queue.empty() && !_isWriting); });
+}
+
+ij::SaveGameStatistics ij::SaveGameWriter::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _statistics;
+}
+
+void ij::SaveGameWriter::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;)
+    {
+        _submitted.wait(lock, [this]() { return (_isStopping || !_queue.empty()); });
+        if (_queue.empty() && _failed.empty())
+        {
+            return;
+        }
+        std::deque<SaveGameSnapshot> snapshots = std::exchange(_failed, {});
+        std::ranges::move(_queue, std::back_inserter(snapshots));
+        _queue.clear();
+        _isWriting = true;
+        lock.unlock();
+        const auto start = std::chrono::steady_clock::now();
+        const std::optional<size_t> rows = writeSnapshots(*_database, snapshots);
+        const auto duration = (std::chrono::steady_clock::now() - start);
+        lock.lock();
+        _isWriting = false;
+        ++_statistics.Transactions;
+        _statistics.TimeSpentWriting += duration;
+        _statistics.HasFailed = !rows;
+        if (rows)
+        {
+            _statistics.SnapshotsWritten += snapshots.size();
+            _statistics.RowsWritten += *rows;
+        }
+        else
+        {
+            ++_statistics.FailedTransactions;
+            _failed = std::move(snapshots);
+        }
+        _written.notify_all();
+        // the failed snapshots were tried one last time
+        if (_isStopping && _queue.empty())
+        {
+            return;
+        }
+    }
+}
+
+std::unique_ptr<ij::SaveGameWriter> ij::OpenSaveGame(const std::filesystem::path &file)
+{
+    auto database = std::make_unique<SaveGameDatabase>();
+    database->Database = openConnection(file, (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE));
+    sqlite3 *const connection = database->Database.get();
+    // Normal synchronization is enough in WAL mode: a crash can lose the latest transactions, but never corrupts the
+    // save game.
+    if (!connection || !execute(connection, "PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;") ||
+        !execute(connection, createTables))
+    {
+        return nullptr;
+    }
+    const std::string gameColumnsString = gameColumns;
+    database->Begin = prepare(connection, "BEGIN");
+    database->Commit = prepare(connection, "COMMIT");
+    database->Rollback = prepare(connection, "ROLLBACK");
+    database->WriteGame = prepare(connection, ("INSERT OR REPLACE INTO game (id, " + gameColumnsString +
+                                               ") VALUES (0, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"));
+    database->WriteEnemy = prepare(connection, (std::string("INSERT OR REPLACE INTO enemies (") + enemyColumns +
+                                                ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"));
+    database->DeleteRemovedEnemies = prepare(connection, "DELETE FROM enemies WHERE id >= ?");
+    if (!database->Begin || !database->Commit || !database->Rollback || !database->WriteGame ||
+        !database->WriteEnemy || !database->DeleteRemovedEnemies)
+    {
+        return nullptr;
+    }
+    return std::make_unique<SaveGameWriter>(std::move(database));
+}
+
+std::optional<ij::SaveGameSnapshot> ij::ReadSaveGame(const std::filesystem::path &file)
+{
+    // without SQLITE_OPEN_CREATE, so that a missing file is not created
+    const Connection connection = openConnection(file, SQLITE_OPEN_READWRITE);
+    if (!connection)
+    {
+        return std::nullopt;
+    }
+    const Statement readGameStatement =
+        prepare(connection.get(), (std::string("SELECT ") + gameColumns + " FROM game WHERE id = 0"));
+    if (!readGameStatement || (sqlite3_step(readGameStatement.get()) != SQLITE_ROW))
+    {
+        return std::nullopt;
+    }
+    std::optional<SaveGameSnapshot> snapshot = readGame(readGameStatement.get());
+    if (!snapshot)
+    {
+        return std::nullopt;
+    }
+    const Statement readEnemies =
+        prepare(connection.get(), (std::string("SELECT ") + enemyColumns + " FROM enemies ORDER BY id"));
+    if (!readEnemies)
+    {
+        return std::nullopt;
+    }
+    snapshot->Enemies.reserve(snapshot->NumberOfEnemies);
+    int result = SQLITE_ROW;
+    while ((result = sqlite3_step(readEnemies.get())) == SQLITE_ROW)
+    {
+        const std::optional<SavedEnemy> enemy = readEnemy(readEnemies.get());
+        // every enemy of the game has to be there exactly once
+        if (!enemy || (enemy->Index != snapshot->Enemies.size()))
+        {
+            return std::nullopt;
+        }
+        snapshot->Enemies.push_back(*enemy);
+    }
+    if ((result != SQLITE_DONE) || (snapshot->Enemies.size() != snapshot->NumberOfEnemies))
+    {
+        return std::nullopt;
+    }
+    return snapshot;
+}
+
+bool ij::RestoreSaveGame(Game &game, const SaveGameSnapshot &snapshot)
+{
+    World &world = game.SimulatedWorld;
+    EnemyStore &enemies = world.enemies;
+    if (game.Streaming || (game.Settings.Seed != snapshot.Settings.Seed) || (world.map.Width != snapshot.MapWidth) ||
+        (world.map.GetHeight() != snapshot.MapHeight) || (enemies.GetCount() != snapshot.NumberOfEnemies) ||
+        (snapshot.Enemies.size() != snapshot.NumberOfEnemies))
+    {
+        return false;
+    }
+    world.SimulatedTicks = snapshot.SimulatedTicks;
+    world.EnemyGrid = SpatialGrid(world.map.Width, world.map.GetHeight());
+    for (const SavedEnemy &enemy : snapshot.Enemies)
+    {
+        const size_t i = AssertCast<size_t>(enemy.Index);
+        assert(i < enemies.GetCount());
+        enemies.Positions[i] = enemy.Position;
+        enemies.PreviousPositions[i] = enemy.Position;
+        enemies.Directions[i] = enemy.Direction;
+        enemies.CurrentHealth[i] = enemy.CurrentHealth;
+        enemies.Activities[i] = enemy.Activity;
+        enemies.HasBumpedIntoWall[i] = enemy.HasBumpedIntoWall;
+        enemies.Bots[i] = enemy.BotState;
+        enemies.SimulatedTicks[i] = enemy.SimulatedTicks;
+        world.EnemyGrid.Insert(i, enemy.Position);
+    }
+    const SavedPlayer &saved = snapshot.Player;
+    LogicEntity &player = game.Player.Logic;
+    player = LogicEntity(std::move(player.Behavior), saved.Position, saved.Direction, player.HasCollisionWithWalls,
+                         saved.HasBumpedIntoWall, saved.CurrentHealth, saved.MaximumHealth, saved.Activity);
+    return true;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "Game.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ij
+{
+    // the state of an enemy which can change during a game, everything else is spawned again from the settings
+    struct SavedEnemy final
+    {
+        // the index in EnemyStore
+        UInt64 Index;
+        Vector2f Position;
+        Vector2f Direction;
+        Health CurrentHealth;
+        ObjectActivity Activity;
+        bool HasBumpedIntoWall;
+        Bot BotState;
+        UInt64 SimulatedTicks;
+    };
+
+    struct SavedPlayer final
+    {
+        Vector2f Position;
+        Vector2f Direction;
+        Health CurrentHealth;
+        Health MaximumHealth;
+        ObjectActivity Activity;
+        bool HasBumpedIntoWall;
+    };
+
+    struct SaveGameSnapshot final
+    {
+        GameSettings Settings;
+        // of the map in use, which differs from the settings when it was loaded from a file
+        size_t MapWidth;
+        size_t MapHeight;
+        size_t NumberOfEnemies;
+        UInt64 SimulatedTicks;
+        SavedPlayer Player;
+        // Only the enemies which changed since the previous snapshot when taken from a running game, all of them when
+        // read from a save game.
+        std::vector<SavedEnemy> Enemies;
+    };
+
+    // Copies the changed enemies and marks them as saved. This is the only part of saving which runs on the simulation
+    // thread. Infinite worlds can not be saved because their enemies are replaced all the time.
+    [[nodiscard]] SaveGameSnapshot TakeSaveGameSnapshot(Game &game);
+
+    struct SaveGameStatistics final
+    {
+        size_t SnapshotsWritten = 0;
+        size_t Transactions = 0;
+        size_t FailedTransactions = 0;
+        size_t RowsWritten = 0;
+        std::chrono::steady_clock::duration TimeSpentWriting = {};
+        // whether the latest transaction failed, so that the save game lacks the snapshots which are still waiting
+        bool HasFailed = false;
+    };
+
+    // the SQLite connection, only used by the writer thread
+    struct SaveGameDatabase;
+
+    // Writes snapshots into a save game on a background thread. Snapshots which arrive while a transaction is running
+    // are written together in the next one. The database is in WAL mode, so the game can be read at the same time.
+    // TakeSaveGameSnapshot only takes the enemies which changed, so the snapshots of a failed transaction are kept and
+    // written again together with the next ones.
+    struct SaveGameWriter final
+    {
+        explicit SaveGameWriter(std::unique_ptr<SaveGameDatabase> database);
+        // writes the remaining snapshots
+        ~SaveGameWriter();
+        SaveGameWriter(const SaveGameWriter &) = delete;
+        SaveGameWriter &operator=(const SaveGameWriter &) = delete;
+
+        void Submit(SaveGameSnapshot snapshot);
+        // blocks until every submitted snapshot is in the database or its transaction has failed
+        void WaitUntilWritten();
+        [[nodiscard]] SaveGameStatistics GetStatistics();
+
+    private:
+        std::unique_ptr<SaveGameDatabase> _database;
+        std::mutex _mutex;
+        std::condition_variable _submitted;
+        std::condition_variable _written;
+        std::deque<SaveGameSnapshot> _queue;
+        // from the latest transaction if it failed, older than everything in the queue
+        std::deque<SaveGameSnapshot> _failed;
+        bool _isWriting = false;
+        bool _isStopping = false;
+        SaveGameStatistics _statistics;
+        // last so that everything else is initialized when the thread starts
+        std::thread _thread;
+
+        void run();
+    };
+
+    // Creates the save game if it does not exist yet. Returns nullptr if the file can not be opened as a database.
+    [[nodiscard]] std::unique_ptr<SaveGameWriter> OpenSaveGame(const std::filesystem::path &file);
+    // Returns nothing if the file does not exist or is not a complete save game.
+    [[nodiscard]] std::optional<SaveGameSnapshot> ReadSaveGame(const std::filesystem::path &file);
+    // Puts the saved state into a game which was created with the settings of the snapshot. Returns false if they do
+    // not fit together.
+    [[nodiscard]] bool RestoreSaveGame(Game &game, const SaveGameSnapshot &snapshot);
+} // namespace ij
@@ -0,0 +1,39 @@
+#include "SimulationClock.h"
+#include "AssertCast.h"
+#include <algorithm>
+#include <cmath>
+
+ij::SimulationClock::SimulationClock(const TimeSpan timeStep)
+    : _timeStep(timeStep)
+{
+}
+
+ij::TimeSpan ij::SimulationClock::Advance(const TimeSpan realTime)
+{
+    const double scaled =
+        (AssertCast<double>(realTime.Milliseconds) * AssertCast<double>(Policy.TimeScale)) + _scaledFraction;
+    const double wholeMilliseconds = std::floor(scaled);
+    _scaledFraction = (scaled - wholeMilliseconds);
+    _backlog += TimeSpan::FromMilliseconds(static_cast<Int64>(wholeMilliseconds));
+    Statistics.WorstBacklog.Milliseconds = (std::max)(Statistics.WorstBacklog.Milliseconds, _backlog.Milliseconds);
+
+    const Int64 timeStep = _timeStep.Milliseconds;
+    const UInt64 dueTicks = AssertCast<UInt64>(_backlog.Milliseconds / timeStep);
+    const UInt64 ticks = (std::min)(dueTicks, AssertCast<UInt64>(Policy.MaximumTicksPerFrame));
+    _backlog -= TimeSpan::FromMilliseconds(AssertCast<Int64>(ticks) * timeStep);
+    if (Policy.IsDroppingExcessTime && (dueTicks > ticks))
+    {
+        Statistics.TicksDropped += (dueTicks - ticks);
+        // keep the part of a tick, dropping it would make the simulation slower than real time in every frame
+        _backlog.Milliseconds %= timeStep;
+    }
+    Statistics.TicksRun += ticks;
+    Statistics.TicksLastFrame = AssertCast<size_t>(ticks);
+    return TimeSpan::FromMilliseconds(AssertCast<Int64>(ticks) * timeStep);
+}
+
+float ij::SimulationClock::GetInterpolation() const
+{
+    // the backlog can be longer than a tick when the policy limits the ticks per frame
+    return (std::min)(1.0f, (AssertCast<float>(_backlog.Milliseconds) / AssertCast<float>(_timeStep.Milliseconds)));
+}
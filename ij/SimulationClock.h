@@ -0,0 +1,48 @@
+#pragma once
+#include "TimeSpan.h"
+#include <cstddef>
+
+namespace ij
+{
+    // What to do when the simulation falls behind the real time, for example after a slow frame or a debugger pause.
+    struct CatchUpPolicy final
+    {
+        // Running every tick that is due in a single frame makes that frame even slower, so that the next one has to
+        // catch up even more.
+        size_t MaximumTicksPerFrame = 5;
+        // Forget the time which could not be simulated in this frame instead of catching up in the following frames.
+        bool IsDroppingExcessTime = true;
+        // less than 1 for slow motion
+        float TimeScale = 1.0f;
+    };
+
+    struct CatchUpStatistics final
+    {
+        UInt64 TicksRun = 0;
+        UInt64 TicksDropped = 0;
+        size_t TicksLastFrame = 0;
+        // the most simulation time that was ever due at the start of a frame
+        TimeSpan WorstBacklog = TimeSpan::FromMilliseconds(0);
+    };
+
+    // Turns the real time between frames into a number of fixed simulation steps.
+    struct SimulationClock final
+    {
+        CatchUpPolicy Policy;
+        CatchUpStatistics Statistics;
+
+        // see World::TimeStep
+        explicit SimulationClock(TimeSpan timeStep);
+        // Returns the simulation time to pass to UpdateWorld in this frame. It is a multiple of the time step.
+        [[nodiscard]] TimeSpan Advance(TimeSpan realTime);
+        // How far the real time is between the last tick and the next one, from 0 to 1. Drawing the world between
+        // those two ticks keeps the motion smooth when there are fewer ticks than frames.
+        [[nodiscard]] float GetInterpolation() const;
+
+    private:
+        TimeSpan _timeStep;
+        TimeSpan _backlog = TimeSpan::FromMilliseconds(0);
+        // the part of a millisecond lost to the time scale
+        double _scaledFraction = 0;
+    };
+} // namespace ij
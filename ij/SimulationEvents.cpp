@@ -0,0 +1,57 @@
+#include "SimulationEvents.h"
+#include "Unreachable.h"
+
+void ij::SimulationEventCounts::Add(const SimulationEvent &event)
+{
+    switch (event.Type)
+    {
+    case SimulationEventType::Damage:
+        ++Damage;
+        return;
+    case SimulationEventType::Death:
+        ++Deaths;
+        return;
+    case SimulationEventType::AttackStarted:
+        ++AttacksStarted;
+        return;
+    }
+    IJ_UNREACHABLE();
+}
+
+ij::SimulationEventQueue::SimulationEventQueue(const size_t capacity)
+    : _events(capacity, SimulationEvent{SimulationEventType::Damage, PlayerEntity, Vector2f(0, 0), 0, 0})
+{
+    assert(capacity > 0);
+}
+
+void ij::SimulationEventQueue::Push(const SimulationEvent &event)
+{
+    _events[_end % _events.size()] = event;
+    ++_end;
+}
+
+ij::UInt64 ij::SimulationEventQueue::GetEnd() const
+{
+    return _end;
+}
+
+void ij::SimulationEventQueue::ShiftPositions(const Vector2f &shift)
+{
+    for (SimulationEvent &event : _events)
+    {
+        event.Position += shift;
+    }
+}
+
+void ij::SimulationEventQueue::CopyNewEvents(const SimulationEventQueue &source)
+{
+    assert(source._events.size() == _events.size());
+    assert(_end <= source._end);
+    const UInt64 capacity = _events.size();
+    const UInt64 begin = ((source._end - _end) > capacity) ? (source._end - capacity) : _end;
+    for (UInt64 i = begin; i < source._end; ++i)
+    {
+        _events[i % capacity] = source._events[i % capacity];
+    }
+    _end = source._end;
+}
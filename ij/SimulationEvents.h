@@ -0,0 +1,83 @@
+#pragma once
+#include "LogicEntity.h"
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+namespace ij
+{
+    enum class SimulationEventType : std::uint8_t
+    {
+        Damage,
+        Death,
+        AttackStarted
+    };
+
+    // SimulationEvent::Entity for the player
+    constexpr size_t PlayerEntity = ~size_t(0);
+
+    // Something that happened in the simulation which presentation, user interface or telemetry may want to show.
+    struct SimulationEvent final
+    {
+        SimulationEventType Type;
+        // an index into World::enemies at the time of the event, or PlayerEntity
+        size_t Entity;
+        Vector2f Position;
+        // only for Damage
+        Health Amount;
+        UInt64 Tick;
+    };
+
+    static_assert(std::is_trivially_copyable_v<SimulationEvent>);
+
+    // for statistics in the user interface and the benchmark
+    struct SimulationEventCounts final
+    {
+        size_t Damage = 0;
+        size_t Deaths = 0;
+        size_t AttacksStarted = 0;
+        // events which were overwritten before they were counted
+        UInt64 Lost = 0;
+
+        void Add(const SimulationEvent &event);
+    };
+
+    // A ring buffer of the latest events. The simulation pushes events without allocating memory. Every consumer keeps
+    // its own position in the sequence of all events and reads what is new once per frame, so nobody has to remove
+    // events and consumers which do not run every frame do not hold up the others.
+    struct SimulationEventQueue final
+    {
+        explicit SimulationEventQueue(size_t capacity);
+
+        // overwrites the oldest event when the queue is full
+        void Push(const SimulationEvent &event);
+        // the number of events pushed so far
+        [[nodiscard]] UInt64 GetEnd() const;
+        // for the events which may not have been consumed yet when everything in the world moves, see ReplaceMap
+        void ShiftPositions(const Vector2f &shift);
+        // For a copy of source which is kept up to date: copies only the events pushed since the last time. Both need
+        // the same capacity, and source must not have been shifted since then.
+        void CopyNewEvents(const SimulationEventQueue &source);
+
+        // Calls consume for every event from position to the end and moves position to the end. Returns the number of
+        // events which were overwritten before they could be consumed.
+        template <class F>
+        UInt64 Consume(UInt64 &position, F &&consume) const
+        {
+            assert(position <= _end);
+            const UInt64 capacity = _events.size();
+            const UInt64 begin = ((_end - position) > capacity) ? (_end - capacity) : position;
+            const UInt64 overwritten = (begin - position);
+            for (UInt64 i = begin; i < _end; ++i)
+            {
+                consume(_events[i % capacity]);
+            }
+            position = _end;
+            return overwritten;
+        }
+
+    private:
+        std::vector<SimulationEvent> _events;
+        UInt64 _end = 0;
+    };
+} // namespace ij
@@ -0,0 +1,154 @@
+#include "SimulationThread.h"
+#include "InputRecording.h"
+#include "SaveGame.h"
+#include <algorithm>
+#include <chrono>
+
+namespace ij
+{
+    namespace
+    {
+        // in simulated time, so that saving depends neither on the frame rate nor on the tick rate
+        constexpr UInt64 autosaveIntervalInSeconds = 10;
+        // far more than the frames the render thread can show while the simulation runs a single tick
+        constexpr size_t inputQueueCapacity = 64;
+    } // namespace
+} // namespace ij
+
+ij::SimulationControls ij::GetSimulationControls(const Game &game, const SimulationClock &clock)
+{
+    SimulationControls controls;
+    controls.LevelOfDetail = game.SimulatedWorld.LevelOfDetail;
+    controls.CatchUp = clock.Policy;
+    controls.HasPlayerCollisionWithWalls = game.Player.Logic.HasCollisionWithWalls;
+    return controls;
+}
+
+void ij::ApplyInputMessage(Game &game, SimulationClock &clock, const InputMessage &message)
+{
+    Input &input = game.CurrentInput;
+    input.isDirectionKeyPressed = message.IsDirectionKeyPressed;
+    input.isAttackPressed = message.IsAttackPressed;
+    input.isDebugModeOn = message.IsDebugModeOn;
+    if (message.SelectionClick)
+    {
+        input.selectedEnemy = FindEnemyByPosition(game.SimulatedWorld, *message.SelectionClick);
+    }
+    game.SimulatedWorld.LevelOfDetail = message.Controls.LevelOfDetail;
+    game.Player.Logic.HasCollisionWithWalls = message.Controls.HasPlayerCollisionWithWalls;
+    clock.Policy = message.Controls.CatchUp;
+}
+
+void ij::AdvanceSimulation(Game &game, SimulationClock &clock, const TimeSpan realTime, WorkerPool &workers,
+                           InputRecorder *const inputRecorder, SaveGameWriter *const saveGameWriter)
+{
+    const World &world = game.SimulatedWorld;
+    // fix the time step to make physics and NPC behaviour independent from the frame rate
+    TimeSpan remainingSimulationTime = clock.Advance(realTime);
+    const UInt64 ticksBefore = world.SimulatedTicks;
+    const UInt64 autosaveInterval = (autosaveIntervalInSeconds * game.Settings.TicksPerSecond);
+    // before the update because moving an infinite world can change the selected enemy
+    const RecordedInput recordedInput = CaptureInput(game.CurrentInput, world);
+    UpdateGame(game, remainingSimulationTime, workers);
+    if (inputRecorder)
+    {
+        inputRecorder->Record(recordedInput, (world.SimulatedTicks - ticksBefore));
+    }
+    if (saveGameWriter && ((world.SimulatedTicks / autosaveInterval) != (ticksBefore / autosaveInterval)))
+    {
+        saveGameWriter->Submit(TakeSaveGameSnapshot(game));
+    }
+}
+
+ij::SimulationThread::SimulationThread(Game &game, WorkerPool &workers, SaveGameWriter *const saveGameWriter,
+                                       const InputMessage &firstInput)
+    : _game(game)
+    , _workers(workers)
+    , _noWorkers(0)
+    , _saveGameWriter(saveGameWriter)
+    , _timeStep(game.SimulatedWorld.TimeStep)
+    , _clock(_timeStep)
+    , _latestInput(firstInput)
+    , _input(inputQueueCapacity)
+    , _snapshots(RenderSnapshot(game))
+{
+    ApplyInputMessage(_game, _clock, firstInput);
+    _thread = std::thread([this]() { run(); });
+}
+
+ij::SimulationThread::~SimulationThread()
+{
+    _isStopping.store(true, std::memory_order_release);
+    _thread.join();
+}
+
+void ij::SimulationThread::SendInput(const InputMessage &message)
+{
+    (void)_input.TrySend(message);
+}
+
+const ij::RenderSnapshot &ij::SimulationThread::GetLatestSnapshot()
+{
+    (void)_snapshots.Update();
+    return _snapshots.GetReadBuffer();
+}
+
+float ij::SimulationThread::GetInterpolation(const RenderSnapshot &snapshot) const
+{
+    const std::chrono::duration<float, std::milli> sinceLastTick =
+        (std::chrono::steady_clock::now() - snapshot.LastTickTime);
+    return (std::min)(1.0f, (sinceLastTick.count() / AssertCast<float>(_timeStep.Milliseconds)));
+}
+
+void ij::SimulationThread::run()
+{
+    using Clock = std::chrono::steady_clock;
+    const std::chrono::milliseconds timeStep(_timeStep.Milliseconds);
+    Clock::time_point lastAdvance = Clock::now();
+    Clock::time_point lastTick = lastAdvance;
+    bool isSnapshotDue = true;
+    while (!_isStopping.load(std::memory_order_acquire))
+    {
+        while (const std::optional<InputMessage> message = _input.TryReceive())
+        {
+            ApplyInputMessage(_game, _clock, *message);
+            _latestInput = *message;
+            // the render thread waits for the selection of an enemy to show up
+            isSnapshotDue = (isSnapshotDue || message->SelectionClick.has_value());
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - lastAdvance);
+        if (elapsed >= timeStep)
+        {
+            // the fraction of a millisecond is left for the next time
+            lastAdvance += elapsed;
+            const TimeSpan realTime = TimeSpan::FromMilliseconds(AssertCast<Int64>(elapsed.count()));
+            const UInt64 ticksBefore = _game.SimulatedWorld.SimulatedTicks;
+            AdvanceSimulation(_game, _clock, realTime,
+                              (_latestInput.Controls.IsSimulationParallel ? _workers : _noWorkers), nullptr,
+                              _saveGameWriter);
+            AnimateVisibleObjects(_game, _latestInput.WindowSize, realTime);
+            if (_game.SimulatedWorld.SimulatedTicks != ticksBefore)
+            {
+                // the simulated time lags behind by the part of a tick which is left in the clock
+                lastTick = (lastAdvance - std::chrono::duration_cast<Clock::duration>(
+                                              std::chrono::duration<float, std::milli>(timeStep) *
+                                              _clock.GetInterpolation()));
+                isSnapshotDue = true;
+            }
+        }
+
+        if (isSnapshotDue)
+        {
+            RenderSnapshot &snapshot = _snapshots.GetWriteBuffer();
+            UpdateRenderSnapshot(snapshot, _game, _latestInput.WindowSize);
+            snapshot.CatchUp = _clock.Statistics;
+            snapshot.LastTickTime = lastTick;
+            _snapshots.Publish();
+            isSnapshotDue = false;
+        }
+
+        // much shorter than a tick, so the ticks stay on time without keeping a core busy
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "Game.h"
+#include "MessageQueue.h"
+#include "RenderSnapshot.h"
+#include "SimulationClock.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <thread>
+
+namespace ij
+{
+    struct InputRecorder;
+    struct SaveGameWriter;
+
+    // What the user interface can change about the simulation.
+    struct SimulationControls final
+    {
+        LevelOfDetailSettings LevelOfDetail;
+        CatchUpPolicy CatchUp;
+        bool HasPlayerCollisionWithWalls = true;
+        // the result is the same either way, so this is only useful for measuring
+        bool IsSimulationParallel = true;
+    };
+
+    [[nodiscard]] SimulationControls GetSimulationControls(const Game &game, const SimulationClock &clock);
+
+    // The input of one frame for the simulation. It contains the whole state of the input, so the simulation only
+    // needs the latest message apart from the clicks.
+    struct InputMessage final
+    {
+        std::array<bool, 4> IsDirectionKeyPressed;
+        bool IsAttackPressed;
+        bool IsDebugModeOn;
+        // selects the enemy at this point in the world, or nothing if there is none
+        std::optional<Vector2f> SelectionClick;
+        // snapshots contain what may be visible in a window of this size around the player
+        Vector2u WindowSize;
+        SimulationControls Controls;
+    };
+
+    void ApplyInputMessage(Game &game, SimulationClock &clock, const InputMessage &message);
+    // Runs the ticks which are due after realTime according to the clock. Records the input of those ticks and saves
+    // the game regularly if the recorder or the writer are given.
+    void AdvanceSimulation(Game &game, SimulationClock &clock, TimeSpan realTime, WorkerPool &workers,
+                           InputRecorder *inputRecorder, SaveGameWriter *saveGameWriter);
+
+    // Runs the simulation of a game on a thread of its own, so that a slow tick does not delay drawing and waiting
+    // for the display does not delay the simulation. The game belongs to the thread until it is destroyed. The thread
+    // takes InputMessages from the render thread and hands RenderSnapshots back, both without locks.
+    struct SimulationThread final
+    {
+        SimulationThread(Game &game, WorkerPool &workers, SaveGameWriter *saveGameWriter,
+                         const InputMessage &firstInput);
+        ~SimulationThread();
+        SimulationThread(const SimulationThread &) = delete;
+        SimulationThread &operator=(const SimulationThread &) = delete;
+
+        // Only for the render thread. The input of a frame is dropped when the simulation is far behind, which only
+        // loses a click because the next message contains the rest again.
+        void SendInput(const InputMessage &message);
+        // Only for the render thread. The snapshot stays the same until the next call.
+        [[nodiscard]] const RenderSnapshot &GetLatestSnapshot();
+        // Only for the render thread. How far the present is between the last tick of the snapshot and the next one,
+        // see InterpolatePosition.
+        [[nodiscard]] float GetInterpolation(const RenderSnapshot &snapshot) const;
+
+    private:
+        Game &_game;
+        WorkerPool &_workers;
+        WorkerPool _noWorkers;
+        SaveGameWriter *_saveGameWriter;
+        const TimeSpan _timeStep;
+        SimulationClock _clock;
+        InputMessage _latestInput;
+        MessageQueue<InputMessage> _input;
+        TripleBuffer<RenderSnapshot> _snapshots;
+        std::atomic<bool> _isStopping = false;
+        std::thread _thread;
+
+        void run();
+    };
+} // namespace ij
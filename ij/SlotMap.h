@@ -0,0 +1,118 @@
+#pragma once
+#include "AssertCast.h"
+#include "Int.h"
+#include <cassert>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ij
+{
+    // Refers to a value in a SlotMap. The generation changes whenever the slot is reused, so a handle which outlived
+    // its value can be told apart from the handle of the value which replaced it.
+    struct SlotHandle final
+    {
+        UInt32 Index = 0;
+        UInt32 Generation = 0;
+    };
+
+    [[nodiscard]] inline bool operator==(const SlotHandle &left, const SlotHandle &right) noexcept
+    {
+        return (left.Index == right.Index) && (left.Generation == right.Generation);
+    }
+
+    // Values behind handles, for resources of canvases like texts and textures. Adding and removing take constant time
+    // thanks to a list of free slots. The values themselves are kept next to each other without gaps, so iterating
+    // over all of them is as fast as over a vector. Removing moves the last value into the gap.
+    template <class T>
+    struct SlotMap final
+    {
+        [[nodiscard]] SlotHandle Add(T value)
+        {
+            const UInt32 denseIndex = AssertCast<UInt32>(_values.size());
+            _values.emplace_back(std::move(value));
+            UInt32 index = 0;
+            if (_freeSlots.empty())
+            {
+                index = AssertCast<UInt32>(_slots.size());
+                _slots.push_back(Slot{denseIndex, 0});
+            }
+            else
+            {
+                index = _freeSlots.back();
+                _freeSlots.pop_back();
+                _slots[index].DenseIndex = denseIndex;
+            }
+            _valueSlots.push_back(index);
+            return SlotHandle{index, _slots[index].Generation};
+        }
+
+        void Remove(const SlotHandle &handle)
+        {
+            assert(Contains(handle));
+            Slot &slot = _slots[handle.Index];
+            const UInt32 lastIndex = AssertCast<UInt32>(_values.size() - 1);
+            if (slot.DenseIndex != lastIndex)
+            {
+                _values[slot.DenseIndex] = std::move(_values.back());
+                _valueSlots[slot.DenseIndex] = _valueSlots.back();
+                _slots[_valueSlots.back()].DenseIndex = slot.DenseIndex;
+            }
+            _values.pop_back();
+            _valueSlots.pop_back();
+            slot.DenseIndex = noValue;
+            ++slot.Generation;
+            _freeSlots.push_back(handle.Index);
+        }
+
+        [[nodiscard]] bool Contains(const SlotHandle &handle) const
+        {
+            return (handle.Index < _slots.size()) && (_slots[handle.Index].DenseIndex != noValue) &&
+                   (_slots[handle.Index].Generation == handle.Generation);
+        }
+
+        [[nodiscard]] T &Get(const SlotHandle &handle)
+        {
+            assert(Contains(handle));
+            return _values[_slots[handle.Index].DenseIndex];
+        }
+
+        [[nodiscard]] const T &Get(const SlotHandle &handle) const
+        {
+            assert(Contains(handle));
+            return _values[_slots[handle.Index].DenseIndex];
+        }
+
+        [[nodiscard]] size_t GetSize() const
+        {
+            return _values.size();
+        }
+
+        // in no particular order
+        [[nodiscard]] std::span<T> GetValues()
+        {
+            return _values;
+        }
+
+        [[nodiscard]] std::span<const T> GetValues() const
+        {
+            return _values;
+        }
+
+    private:
+        struct Slot final
+        {
+            UInt32 DenseIndex;
+            UInt32 Generation;
+        };
+
+        static constexpr UInt32 noValue = (std::numeric_limits<UInt32>::max)();
+
+        std::vector<T> _values;
+        // the slot of each value
+        std::vector<UInt32> _valueSlots;
+        std::vector<Slot> _slots;
+        std::vector<UInt32> _freeSlots;
+    };
+} // namespace ij
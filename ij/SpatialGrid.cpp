@@ -0,0 +1,76 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace ij
+{
+    namespace
+    {
+        [[nodiscard]] size_t divideRoundingUp(const size_t dividend, const size_t divisor)
+        {
+            return ((dividend + divisor - 1) / divisor);
+        }
+
+        [[nodiscard]] size_t clampCellIndex(const float coordinate, const size_t cellCount)
+        {
+            // entities without wall collision can leave the map, so they are kept in the border cells
+            const float index = std::floor(coordinate / SpatialGrid::CellSize);
+            if (index < 0)
+            {
+                return 0;
+            }
+            if (index >= AssertCast<float>(cellCount))
+            {
+                return (cellCount - 1);
+            }
+            return AssertCast<size_t>(index);
+        }
+    } // namespace
+} // namespace ij
+
+ij::SpatialGrid::SpatialGrid(const size_t widthInTiles, const size_t heightInTiles)
+    : _widthInCells((std::max<size_t>)(1, divideRoundingUp(widthInTiles, CellSizeInTiles)))
+    , _heightInCells((std::max<size_t>)(1, divideRoundingUp(heightInTiles, CellSizeInTiles)))
+    , _cells(_widthInCells * _heightInCells)
+{
+}
+
+void ij::SpatialGrid::Insert(const size_t element, const Vector2f &position)
+{
+    getCell(position).push_back(element);
+}
+
+void ij::SpatialGrid::Move(const size_t element, const Vector2f &from, const Vector2f &to)
+{
+    std::vector<size_t> &oldCell = getCell(from);
+    std::vector<size_t> &newCell = getCell(to);
+    if (&oldCell == &newCell)
+    {
+        return;
+    }
+    const auto found = std::ranges::find(oldCell, element);
+    assert(found != oldCell.end());
+    *found = oldCell.back();
+    oldCell.pop_back();
+    newCell.push_back(element);
+}
+
+void ij::SpatialGrid::Clear()
+{
+    for (std::vector<size_t> &cell : _cells)
+    {
+        cell.clear();
+    }
+}
+
+ij::Vector2<size_t> ij::SpatialGrid::findCell(const Vector2f &position) const
+{
+    return Vector2<size_t>(clampCellIndex(position.x, _widthInCells), clampCellIndex(position.y, _heightInCells));
+}
+
+std::vector<size_t> &ij::SpatialGrid::getCell(const Vector2f &position)
+{
+    const Vector2<size_t> cell = findCell(position);
+    return _cells[(cell.y * _widthInCells) + cell.x];
+}
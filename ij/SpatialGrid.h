@@ -0,0 +1,47 @@
+#pragma once
+#include "LogicEntity.h"
+#include "TextureCutter.h"
+#include <vector>
+
+namespace ij
+{
+    // Buckets elements (identified by their index in some external container) by the tile-aligned cell their position
+    // falls into, so that area queries only have to look at the few cells that overlap the area.
+    struct SpatialGrid final
+    {
+        static constexpr size_t CellSizeInTiles = 4;
+        static constexpr float CellSize = CellSizeInTiles * TileSize;
+
+        SpatialGrid(size_t widthInTiles, size_t heightInTiles);
+        void Insert(size_t element, const Vector2f &position);
+        void Move(size_t element, const Vector2f &from, const Vector2f &to);
+        void Clear();
+
+        // Calls visit(element) for every element in a cell that overlaps the area. The caller has to do the exact
+        // test because a cell usually contains elements outside of the area as well.
+        template <class Visitor>
+        void ForEachCandidate(const Rectangle<float> &area, Visitor &&visit) const
+        {
+            const Vector2<size_t> topLeft = findCell(area.Position);
+            const Vector2<size_t> bottomRight = findCell(area.Position + area.Size);
+            for (size_t y = topLeft.y; y <= bottomRight.y; ++y)
+            {
+                for (size_t x = topLeft.x; x <= bottomRight.x; ++x)
+                {
+                    for (const size_t element : _cells[(y * _widthInCells) + x])
+                    {
+                        visit(element);
+                    }
+                }
+            }
+        }
+
+    private:
+        size_t _widthInCells;
+        size_t _heightInCells;
+        std::vector<std::vector<size_t>> _cells;
+
+        [[nodiscard]] Vector2<size_t> findCell(const Vector2f &position) const;
+        [[nodiscard]] std::vector<size_t> &getCell(const Vector2f &position);
+    };
+} // namespace ij
@@ -1,10 +1,15 @@
 #include "Sprite.h"
 
-ij::TextureId::TextureId(UInt32 value)
+ij::TextureId::TextureId(const SlotHandle &value)
     : Value(value)
 {
 }
 
+ij::TextureId::TextureId(const UInt32 index)
+    : Value{index, 0}
+{
+}
+
 ij::Sprite::Sprite(TextureId texture, const Vector2i &position, Color colorMultiplier, const Vector2u &textureTopLeft,
                    const Vector2u &textureSize)
     : Texture(texture)
@@ -1,15 +1,18 @@
 #pragma once
 #include "Color.h"
 #include "Int.h"
+#include "SlotMap.h"
 #include "Vector2.h"
 
 namespace ij
 {
     struct TextureId final
     {
-        UInt32 Value;
+        SlotHandle Value;
 
-        explicit TextureId(UInt32 value);
+        explicit TextureId(const SlotHandle &value);
+        // the texture which was added as the index-th to a SlotMap from which nothing has been removed
+        explicit TextureId(UInt32 index);
     };
 
     struct Sprite final
@@ -0,0 +1,365 @@
+#include "StreamedWorld.h"
+#include "Direction.h"
+#include "FastRandomNumberGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ij
+{
+    namespace
+    {
+        // distinguishes the random numbers for the enemies of a chunk from the ones for its tiles
+        constexpr UInt64 enemyRandomSalt = 0x656e656d696573u;
+
+        [[nodiscard]] UInt64 getChunkKey(const UInt64 seed, const ChunkCoordinates &coordinates)
+        {
+            return MixBits(seed ^
+                           MixBits(static_cast<UInt64>(coordinates.X) ^ MixBits(static_cast<UInt64>(coordinates.Y))));
+        }
+
+        // the number of chunks between two chunks, counting diagonal steps as one
+        [[nodiscard]] Int64 getDistance(const ChunkCoordinates &first, const ChunkCoordinates &second)
+        {
+            return (std::max)(std::abs(first.X - second.X), std::abs(first.Y - second.Y));
+        }
+
+        [[nodiscard]] Int64 floorToChunk(const float local)
+        {
+            return static_cast<Int64>(std::floor(local / ChunkSizeInPixels));
+        }
+    } // namespace
+} // namespace ij
+
+size_t ij::ChunkCoordinatesHash::operator()(const ChunkCoordinates &coordinates) const noexcept
+{
+    return AssertCast<size_t>(getChunkKey(0, coordinates));
+}
+
+ij::WorldPosition ij::ToWorldPosition(const Vector2f &local, const ChunkCoordinates &origin)
+{
+    const Int64 chunkX = floorToChunk(local.x);
+    const Int64 chunkY = floorToChunk(local.y);
+    return WorldPosition{ChunkCoordinates{origin.X + chunkX, origin.Y + chunkY},
+                         local - Vector2f(AssertCast<float>(chunkX) * ChunkSizeInPixels,
+                                          AssertCast<float>(chunkY) * ChunkSizeInPixels)};
+}
+
+ij::Vector2f ij::ToLocalPosition(const WorldPosition &position, const ChunkCoordinates &origin)
+{
+    return position.Offset + Vector2f(AssertCast<float>(position.Chunk.X - origin.X) * ChunkSizeInPixels,
+                                      AssertCast<float>(position.Chunk.Y - origin.Y) * ChunkSizeInPixels);
+}
+
+void ij::GenerateChunk(const UInt64 seed, const ChunkCoordinates &coordinates, ChunkTiles &tiles)
+{
+    BatchRandomNumberGenerator random(getChunkKey(seed, coordinates));
+    std::array<Int32, Map::TilesPerChunk> generated;
+    random.FillInt32(generated, 0, 3);
+    std::ranges::transform(generated, tiles.begin(), [](const Int32 tile) { return static_cast<Tile>(tile); });
+}
+
+ij::ChunkGenerator::ChunkGenerator(const UInt64 seed)
+    : _seed(seed)
+    , _thread([this]() { run(); })
+{
+}
+
+ij::ChunkGenerator::~ChunkGenerator()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _requested.notify_one();
+    _thread.join();
+}
+
+void ij::ChunkGenerator::Request(const ChunkCoordinates &coordinates)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push_back(coordinates);
+    }
+    _requested.notify_one();
+}
+
+std::vector<ij::ChunkCoordinates> ij::ChunkGenerator::DropRequests(
+    const std::function<bool(const ChunkCoordinates &coordinates)> &isNoLongerNeeded)
+{
+    std::vector<ChunkCoordinates> dropped;
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::erase_if(_queue, [&isNoLongerNeeded, &dropped](const ChunkCoordinates &coordinates) {
+        if (!isNoLongerNeeded(coordinates))
+        {
+            return false;
+        }
+        dropped.push_back(coordinates);
+        return true;
+    });
+    return dropped;
+}
+
+std::vector<ij::GeneratedChunk> ij::ChunkGenerator::TakeFinished()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::exchange(_finished, {});
+}
+
+void ij::ChunkGenerator::run()
+{
+    for (;;)
+    {
+        ChunkCoordinates coordinates;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _requested.wait(lock, [this]() { return _isStopping || !_queue.empty(); });
+            if (_isStopping)
+            {
+                return;
+            }
+            coordinates = _queue.front();
+            _queue.pop_front();
+        }
+        auto tiles = std::make_shared<ChunkTiles>();
+        GenerateChunk(_seed, coordinates, *tiles);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished.push_back(GeneratedChunk{coordinates, std::move(tiles)});
+    }
+}
+
+ij::StreamedWorld::StreamedWorld(const UInt64 seed, const StreamingSettings &settings,
+                                 std::vector<EnemyTemplate> enemies)
+    : Settings(settings)
+    , _seed(seed)
+    , _enemies(std::move(enemies))
+    , _generator(seed)
+{
+    assert(!_enemies.empty());
+    requestChunksAroundCenter();
+}
+
+ij::UInt64 ij::StreamedWorld::GetSeed() const
+{
+    return _seed;
+}
+
+ij::ChunkCoordinates ij::StreamedWorld::GetOrigin() const
+{
+    return ChunkCoordinates{_center.X - getActiveRadius(), _center.Y - getActiveRadius()};
+}
+
+size_t ij::StreamedWorld::GetNumberOfLoadedChunks() const
+{
+    return _chunks.size();
+}
+
+ij::Map ij::StreamedWorld::CreateMap()
+{
+    takeGeneratedChunks();
+    const size_t chunksPerSide = AssertCast<size_t>((2 * getActiveRadius()) + 1);
+    MapBuilder builder((chunksPerSide * Map::ChunkSize), (chunksPerSide * Map::ChunkSize));
+    const ChunkCoordinates origin = GetOrigin();
+    for (size_t y = 0; y < chunksPerSide; ++y)
+    {
+        for (size_t x = 0; x < chunksPerSide; ++x)
+        {
+            builder.SetChunk(
+                x, y, getChunk(ChunkCoordinates{origin.X + AssertCast<Int64>(x), origin.Y + AssertCast<Int64>(y)}));
+        }
+    }
+    return builder.Build();
+}
+
+void ij::StreamedWorld::SpawnAllEnemies(World &world)
+{
+    const size_t chunksPerSide = AssertCast<size_t>((2 * getActiveRadius()) + 1);
+    const ChunkCoordinates origin = GetOrigin();
+    for (size_t y = 0; y < chunksPerSide; ++y)
+    {
+        for (size_t x = 0; x < chunksPerSide; ++x)
+        {
+            spawnEnemies(world, ChunkCoordinates{origin.X + AssertCast<Int64>(x), origin.Y + AssertCast<Int64>(y)});
+        }
+    }
+}
+
+void ij::StreamedWorld::Update(World &world, LogicEntity &player, std::optional<size_t> &selectedEnemy)
+{
+    takeGeneratedChunks();
+    const ChunkCoordinates playerChunk = ToWorldPosition(player.Position, GetOrigin()).Chunk;
+    if (getDistance(playerChunk, _center) > AssertCast<Int64>(Settings.RecenterDistance))
+    {
+        recenter(world, player, selectedEnemy, playerChunk);
+    }
+}
+
+ij::Int64 ij::StreamedWorld::getActiveRadius() const
+{
+    return AssertCast<Int64>(Settings.ActiveRadius);
+}
+
+ij::Int64 ij::StreamedWorld::getPrefetchRadius() const
+{
+    return (getActiveRadius() + AssertCast<Int64>(Settings.RecenterDistance) + 1);
+}
+
+const ij::ChunkTiles &ij::StreamedWorld::getChunk(const ChunkCoordinates &coordinates)
+{
+    const ChunkMap::const_iterator found = _chunks.find(coordinates);
+    if (found != _chunks.end())
+    {
+        return *found->second;
+    }
+    auto tiles = std::make_shared<ChunkTiles>();
+    GenerateChunk(_seed, coordinates, *tiles);
+    ++Statistics.ChunksGeneratedOnDemand;
+    return *_chunks.emplace(coordinates, std::move(tiles)).first->second;
+}
+
+void ij::StreamedWorld::takeGeneratedChunks()
+{
+    for (GeneratedChunk &generated : _generator.TakeFinished())
+    {
+        ++Statistics.ChunksGeneratedInBackground;
+        _requested.erase(generated.Coordinates);
+        // the player may have moved on while the chunk was generated
+        if (getDistance(generated.Coordinates, _center) <= getPrefetchRadius())
+        {
+            // does nothing if the chunk was generated on demand in the meantime
+            _chunks.emplace(generated.Coordinates, std::move(generated.Tiles));
+        }
+    }
+}
+
+void ij::StreamedWorld::requestChunksAroundCenter()
+{
+    // The closest chunks first because they are needed first. Each distance is the edge of a square around the
+    // center, which is walked with unsigned offsets from its top left corner.
+    const size_t prefetchRadius = AssertCast<size_t>(getPrefetchRadius());
+    for (size_t distance = 0; distance <= prefetchRadius; ++distance)
+    {
+        const size_t side = (2 * distance);
+        const ChunkCoordinates corner{_center.X - AssertCast<Int64>(distance), _center.Y - AssertCast<Int64>(distance)};
+        for (size_t y = 0; y <= side; ++y)
+        {
+            // only the first and the last column between the top and the bottom row
+            const size_t step = (((y == 0) || (y == side)) ? 1 : side);
+            for (size_t x = 0; x <= side; x += step)
+            {
+                const ChunkCoordinates coordinates{corner.X + AssertCast<Int64>(x), corner.Y + AssertCast<Int64>(y)};
+                if (_chunks.contains(coordinates) || _requested.contains(coordinates))
+                {
+                    continue;
+                }
+                _requested.insert(coordinates);
+                _generator.Request(coordinates);
+            }
+        }
+    }
+}
+
+void ij::StreamedWorld::evictChunks()
+{
+    Statistics.ChunksEvicted += std::erase_if(_chunks, [this](const ChunkMap::value_type &chunk) {
+        return (getDistance(chunk.first, _center) > getPrefetchRadius());
+    });
+}
+
+void ij::StreamedWorld::dropStaleRequests()
+{
+    // otherwise a player who moves faster than the background thread would leave a growing queue behind
+    for (const ChunkCoordinates &dropped : _generator.DropRequests([this](const ChunkCoordinates &coordinates) {
+             return (getDistance(coordinates, _center) > getPrefetchRadius());
+         }))
+    {
+        _requested.erase(dropped);
+        ++Statistics.RequestsDropped;
+    }
+}
+
+void ij::StreamedWorld::spawnEnemies(World &world, const ChunkCoordinates &chunk)
+{
+    Xoshiro256 random(MixBits(getChunkKey(_seed, chunk) ^ enemyRandomSalt));
+    const ChunkCoordinates origin = GetOrigin();
+    const Vector2f topLeft(AssertCast<float>(chunk.X - origin.X) * ChunkSizeInPixels,
+                           AssertCast<float>(chunk.Y - origin.Y) * ChunkSizeInPixels);
+    const size_t numberOfEnemies =
+        static_cast<size_t>(std::lround(AssertCast<float>(Map::TilesPerChunk) * Settings.EnemiesPerTile));
+    for (size_t i = 0; i < numberOfEnemies; ++i)
+    {
+        const EnemyTemplate &enemyTemplate = _enemies[random.GenerateSize(0, _enemies.size() - 1)];
+        const Int32 tileX = random.GenerateInt32(0, AssertCast<Int32>(Map::ChunkSize - 1));
+        const Int32 tileY = random.GenerateInt32(0, AssertCast<Int32>(Map::ChunkSize - 1));
+        const Vector2f position = topLeft + Vector2f(AssertCast<float>((TileSize * tileX) + (TileSize / 2)),
+                                                     AssertCast<float>((TileSize * tileY) + (TileSize / 2)));
+        const Vector2f direction = DirectionToVector(AssertCast<Direction>(random.GenerateInt32(0, 3)));
+        // there are fewer enemies in chunks with a lot of water
+        if (!IsWalkable(position, DefaultEntityDimensions, world))
+        {
+            continue;
+        }
+        SpawnEnemy(world, enemyTemplate, position, direction);
+        ++Statistics.EnemiesSpawned;
+    }
+}
+
+void ij::StreamedWorld::recenter(World &world, LogicEntity &player, std::optional<size_t> &selectedEnemy,
+                                 const ChunkCoordinates &center)
+{
+    const ChunkCoordinates previousCenter = _center;
+    const ChunkCoordinates previousOrigin = GetOrigin();
+    _center = center;
+    const ChunkCoordinates origin = GetOrigin();
+    const Vector2f shift(AssertCast<float>(previousOrigin.X - origin.X) * ChunkSizeInPixels,
+                         AssertCast<float>(previousOrigin.Y - origin.Y) * ChunkSizeInPixels);
+
+    // the enemies in the chunks which are left behind are forgotten
+    EnemyStore &enemies = world.enemies;
+    const float mapSize = (AssertCast<float>((2 * getActiveRadius()) + 1) * ChunkSizeInPixels);
+    std::vector<std::uint8_t> isRemoved(enemies.GetCount());
+    size_t removedBeforeSelection = 0;
+    for (size_t i = 0; i < enemies.GetCount(); ++i)
+    {
+        const Vector2f position = (enemies.Positions[i] + shift);
+        isRemoved[i] = !((position.x >= 0) && (position.x < mapSize) && (position.y >= 0) && (position.y < mapSize));
+        if (isRemoved[i])
+        {
+            ++Statistics.EnemiesEvicted;
+            if (selectedEnemy && (i < *selectedEnemy))
+            {
+                ++removedBeforeSelection;
+            }
+        }
+    }
+    if (selectedEnemy)
+    {
+        if (isRemoved[*selectedEnemy])
+        {
+            selectedEnemy.reset();
+        }
+        else
+        {
+            *selectedEnemy -= removedBeforeSelection;
+        }
+    }
+    enemies.Remove(isRemoved);
+
+    ReplaceMap(world, player, CreateMap(), shift);
+    const size_t chunksPerSide = AssertCast<size_t>((2 * getActiveRadius()) + 1);
+    for (size_t y = 0; y < chunksPerSide; ++y)
+    {
+        for (size_t x = 0; x < chunksPerSide; ++x)
+        {
+            const ChunkCoordinates chunk{origin.X + AssertCast<Int64>(x), origin.Y + AssertCast<Int64>(y)};
+            if (getDistance(chunk, previousCenter) > getActiveRadius())
+            {
+                spawnEnemies(world, chunk);
+            }
+        }
+    }
+    evictChunks();
+    dropStaleRequests();
+    requestChunksAroundCenter();
+    ++Statistics.Recenterings;
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include "EnemyTemplate.h"
+#include "World.h"
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ij
+{
+    struct ChunkCoordinates final
+    {
+        Int64 X = 0;
+        Int64 Y = 0;
+
+        bool operator==(const ChunkCoordinates &) const = default;
+    };
+
+    struct ChunkCoordinatesHash final
+    {
+        [[nodiscard]] size_t operator()(const ChunkCoordinates &coordinates) const noexcept;
+    };
+
+    constexpr float ChunkSizeInPixels = static_cast<float>(Map::ChunkSize * TileSize);
+
+    // A position in a world without bounds. A float alone would lose too much precision far away from the origin.
+    struct WorldPosition final
+    {
+        ChunkCoordinates Chunk;
+        // relative to the top left corner of the chunk
+        Vector2f Offset;
+    };
+
+    // local positions are relative to the top left corner of the origin chunk
+    [[nodiscard]] WorldPosition ToWorldPosition(const Vector2f &local, const ChunkCoordinates &origin);
+    [[nodiscard]] Vector2f ToLocalPosition(const WorldPosition &position, const ChunkCoordinates &origin);
+
+    using ChunkTiles = std::array<Tile, Map::TilesPerChunk>;
+
+    // The tiles only depend on the seed and the coordinates, so a chunk can be generated again instead of being kept.
+    void GenerateChunk(UInt64 seed, const ChunkCoordinates &coordinates, ChunkTiles &tiles);
+
+    struct GeneratedChunk final
+    {
+        ChunkCoordinates Coordinates;
+        std::shared_ptr<const ChunkTiles> Tiles;
+    };
+
+    // Generates chunks on a background thread in the order in which they were requested.
+    struct ChunkGenerator final
+    {
+        explicit ChunkGenerator(UInt64 seed);
+        ~ChunkGenerator();
+        ChunkGenerator(const ChunkGenerator &) = delete;
+        ChunkGenerator &operator=(const ChunkGenerator &) = delete;
+
+        void Request(const ChunkCoordinates &coordinates);
+        // Forgets the requests which were not started yet and are no longer needed. Returns the forgotten ones.
+        [[nodiscard]] std::vector<ChunkCoordinates> DropRequests(
+            const std::function<bool(const ChunkCoordinates &coordinates)> &isNoLongerNeeded);
+        [[nodiscard]] std::vector<GeneratedChunk> TakeFinished();
+
+    private:
+        const UInt64 _seed;
+        std::mutex _mutex;
+        std::condition_variable _requested;
+        std::deque<ChunkCoordinates> _queue;
+        std::vector<GeneratedChunk> _finished;
+        bool _isStopping = false;
+        // last so that everything else is initialized when the thread starts
+        std::thread _thread;
+
+        void run();
+    };
+
+    struct StreamingSettings final
+    {
+        // World::map contains this many chunks in every direction from the chunk in its center
+        size_t ActiveRadius = 3;
+        // how many chunks the player can get away from the center before the map is moved
+        size_t RecenterDistance = 1;
+        float EnemiesPerTile = 0.02f;
+    };
+
+    struct StreamingStatistics final
+    {
+        size_t ChunksGeneratedInBackground = 0;
+        // chunks which were needed before the background thread had them, which stalls the simulation
+        size_t ChunksGeneratedOnDemand = 0;
+        size_t ChunksEvicted = 0;
+        // requests for the background thread which the player left behind before it got to them
+        size_t RequestsDropped = 0;
+        size_t EnemiesSpawned = 0;
+        size_t EnemiesEvicted = 0;
+        size_t Recenterings = 0;
+    };
+
+    // An unbounded world of which World::map only contains the square of chunks around the player. All positions in
+    // World are relative to the top left chunk of that square, so they stay small no matter how far the player goes.
+    // When the player gets too far away from the center, the square moves with them: chunks which leave it are evicted
+    // together with their enemies, and new chunks get the enemies that are generated for them. Chunks and enemies only
+    // depend on the seed and the chunk coordinates, so the simulation stays deterministic even though the background
+    // thread may be late. Memory and time per tick depend on the settings, not on how much of the world was visited.
+    struct StreamedWorld final
+    {
+        const StreamingSettings Settings;
+        StreamingStatistics Statistics;
+
+        StreamedWorld(UInt64 seed, const StreamingSettings &settings, std::vector<EnemyTemplate> enemies);
+
+        // the chunks only depend on this seed, see GenerateChunk
+        [[nodiscard]] UInt64 GetSeed() const;
+        // the chunk of the top left corner of World::map
+        [[nodiscard]] ChunkCoordinates GetOrigin() const;
+        [[nodiscard]] size_t GetNumberOfLoadedChunks() const;
+        // the square around the current center, generating the missing chunks on the calling thread
+        [[nodiscard]] Map CreateMap();
+        // spawns the enemies of every chunk in World::map, for a new world
+        void SpawnAllEnemies(World &world);
+        // Moves World::map along with the player if necessary. Has to be called after every tick. Fixes or resets the
+        // selected enemy if the enemies change.
+        void Update(World &world, LogicEntity &player, std::optional<size_t> &selectedEnemy);
+
+    private:
+        using ChunkMap = std::unordered_map<ChunkCoordinates, std::shared_ptr<const ChunkTiles>, ChunkCoordinatesHash>;
+
+        const UInt64 _seed;
+        const std::vector<EnemyTemplate> _enemies;
+        ChunkCoordinates _center;
+        ChunkMap _chunks;
+        std::unordered_set<ChunkCoordinates, ChunkCoordinatesHash> _requested;
+        ChunkGenerator _generator;
+
+        [[nodiscard]] Int64 getActiveRadius() const;
+        // the chunks which may be needed by the next recentering
+        [[nodiscard]] Int64 getPrefetchRadius() const;
+        [[nodiscard]] const ChunkTiles &getChunk(const ChunkCoordinates &coordinates);
+        void takeGeneratedChunks();
+        void requestChunksAroundCenter();
+        void evictChunks();
+        void dropStaleRequests();
+        void spawnEnemies(World &world, const ChunkCoordinates &chunk);
+        void recenter(World &world, LogicEntity &player, std::optional<size_t> &selectedEnemy,
+                      const ChunkCoordinates &center);
+    };
+} // namespace ij
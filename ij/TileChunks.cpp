@@ -0,0 +1,88 @@
+#include "TileChunks.h"
+#include <algorithm>
+#include <cassert>
+
+ij::Sprite ij::CreateTileSprite(const TextureId tileset, const Tile tile, const Vector2i &position)
+{
+    return Sprite(tileset, position, Color(255, 255, 255, 255), Vector2u(AssertCast<UInt32>(tile) * TileSize, 160),
+                  Vector2u(TileSize, TileSize));
+}
+
+void ij::AddTileSprites(const std::span<const Tile, Map::TilesPerChunk> tiles, const TextureId tileset,
+                        VertexBatch &batch)
+{
+    for (size_t y = 0; y < Map::ChunkSize; ++y)
+    {
+        for (size_t x = 0; x < Map::ChunkSize; ++x)
+        {
+            const Tile tile = tiles[(y * Map::ChunkSize) + x];
+            if (tile != NoTile)
+            {
+                batch.AddSprite(CreateTileSprite(
+                    tileset, tile, Vector2i(AssertCast<Int32>(x) * TileSize, AssertCast<Int32>(y) * TileSize)));
+            }
+        }
+    }
+}
+
+ij::TileChunkRenderer::~TileChunkRenderer()
+{
+}
+
+ij::TileChunkCache::TileChunkCache(const size_t memoryBudgetInBytes)
+    : _slotCount((std::max)(size_t(1), memoryBudgetInBytes / (size_t(TileChunkPixels) * TileChunkPixels * 4)))
+{
+}
+
+ij::TileChunkCache::Lookup ij::TileChunkCache::Find(const std::span<const Tile, Map::TilesPerChunk> tiles)
+{
+    ++_uses;
+    const auto found = std::ranges::find(_entries, tiles.data(), &Entry::Storage);
+    if (found != _entries.end())
+    {
+        found->LastUse = _uses;
+        found->LastFrame = _frame;
+        const size_t slot = AssertCast<size_t>(found - _entries.begin());
+        if (std::ranges::equal(found->Tiles, tiles))
+        {
+            return Lookup{slot, true};
+        }
+        std::ranges::copy(tiles, found->Tiles.begin());
+        return Lookup{slot, false};
+    }
+    if (_entries.size() < _slotCount)
+    {
+        return add(tiles);
+    }
+    const auto leastRecent = std::ranges::min_element(_entries, {}, &Entry::LastUse);
+    // the uses of the current frame are the most recent ones, so all the chunks are in the current frame
+    if (leastRecent->LastFrame == _frame)
+    {
+        ++_slotCount;
+        return add(tiles);
+    }
+    assert(leastRecent->LastFrame < _frame);
+    leastRecent->Storage = tiles.data();
+    std::ranges::copy(tiles, leastRecent->Tiles.begin());
+    leastRecent->LastUse = _uses;
+    leastRecent->LastFrame = _frame;
+    return Lookup{AssertCast<size_t>(leastRecent - _entries.begin()), false};
+}
+
+void ij::TileChunkCache::StartFrame()
+{
+    ++_frame;
+}
+
+size_t ij::TileChunkCache::GetSlotCount() const
+{
+    return _slotCount;
+}
+
+ij::TileChunkCache::Lookup ij::TileChunkCache::add(const std::span<const Tile, Map::TilesPerChunk> tiles)
+{
+    assert(_entries.size() < _slotCount);
+    Entry &added = _entries.emplace_back(Entry{tiles.data(), {}, _uses, _frame});
+    std::ranges::copy(tiles, added.Tiles.begin());
+    return Lookup{(_entries.size() - 1), false};
+}
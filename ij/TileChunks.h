@@ -0,0 +1,67 @@
+#pragma once
+#include "LogicEntity.h"
+#include "Map.h"
+#include "Sprite.h"
+#include "VertexBatch.h"
+#include <array>
+#include <span>
+#include <vector>
+
+namespace ij
+{
+    // the width and height of the picture of a map chunk
+    constexpr UInt32 TileChunkPixels = (Map::ChunkSize * TileSize);
+
+    [[nodiscard]] Sprite CreateTileSprite(TextureId tileset, Tile tile, const Vector2i &position);
+    // for drawing a chunk into a texture, relative to the top left corner of the chunk
+    void AddTileSprites(std::span<const Tile, Map::TilesPerChunk> tiles, TextureId tileset, VertexBatch &batch);
+
+    // A capability of canvases which can keep the tiles of map chunks in textures and draw them as a single sprite,
+    // see Canvas::GetTileChunkRenderer.
+    struct TileChunkRenderer
+    {
+        virtual ~TileChunkRenderer();
+        // Draws the tiles of a map chunk with the top left corner of the chunk at topLeft. Returns whether there
+        // already was a picture of the chunk, for measuring.
+        [[nodiscard]] virtual bool DrawTileChunk(std::span<const Tile, Map::TilesPerChunk> tiles, TextureId tileset,
+                                                 const Vector2i &topLeft) = 0;
+    };
+
+    // Decides which of a number of textures holds which map chunk. When all of them are used, the one which was drawn
+    // least recently gets the new chunk. The textures of the current frame may still wait in a batch, so they are
+    // never replaced. When a frame needs more chunks than the memory budget allows, the cache grows instead.
+    struct TileChunkCache final
+    {
+        struct Lookup final
+        {
+            size_t Slot;
+            // otherwise the caller has to draw the chunk into the texture of the slot
+            bool IsCached;
+        };
+
+        // for textures with four bytes per pixel
+        explicit TileChunkCache(size_t memoryBudgetInBytes);
+        [[nodiscard]] Lookup Find(std::span<const Tile, Map::TilesPerChunk> tiles);
+        // Call when the chunks found so far have been drawn, so that their slots can be given to other chunks.
+        void StartFrame();
+        [[nodiscard]] size_t GetSlotCount() const;
+
+    private:
+        struct Entry final
+        {
+            // where the map stores the tiles, which is the same for all uniform chunks of a tile
+            const Tile *Storage;
+            // in case a new map has different tiles at the same address
+            std::array<Tile, Map::TilesPerChunk> Tiles;
+            UInt64 LastUse;
+            UInt64 LastFrame;
+        };
+
+        size_t _slotCount;
+        std::vector<Entry> _entries;
+        UInt64 _uses = 0;
+        UInt64 _frame = 0;
+
+        [[nodiscard]] Lookup add(std::span<const Tile, Map::TilesPerChunk> tiles);
+    };
+} // namespace ij
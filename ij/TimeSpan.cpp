@@ -10,6 +10,11 @@ ij::TimeSpan::TimeSpan(Int64 milliseconds) noexcept
 {
 }
 
+bool ij::operator==(TimeSpan left, TimeSpan right) noexcept
+{
+    return (left.Milliseconds == right.Milliseconds);
+}
+
 bool ij::operator>=(TimeSpan left, TimeSpan right) noexcept
 {
     return (left.Milliseconds >= right.Milliseconds);
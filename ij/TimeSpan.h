@@ -13,6 +13,7 @@ namespace ij
         TimeSpan(Int64 milliseconds) noexcept;
     };
 
+    [[nodiscard]] bool operator==(TimeSpan left, TimeSpan right) noexcept;
     [[nodiscard]] bool operator>=(TimeSpan left, TimeSpan right) noexcept;
     TimeSpan &operator+=(TimeSpan &left, TimeSpan right) noexcept;
     TimeSpan &operator-=(TimeSpan &left, TimeSpan right) noexcept;
@@ -0,0 +1,67 @@
+#pragma once
+#include "AssertCast.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ij
+{
+    // Hands the newest version of a value from one writing thread to one reading thread without locks. Neither of them
+    // ever waits for the other: the writer always has a buffer of its own, the reader keeps its buffer until it asks
+    // for a newer one and the third buffer is the one in between. Versions which the reader was too slow for are
+    // skipped.
+    template <class T>
+    struct TripleBuffer final
+    {
+        explicit TripleBuffer(const T &initial)
+            : _buffers{initial, initial, initial}
+        {
+        }
+
+        TripleBuffer(const TripleBuffer &) = delete;
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+        // Only for the writer. Holds an older version which has to be overwritten completely before publishing.
+        [[nodiscard]] T &GetWriteBuffer()
+        {
+            return _buffers[_writing];
+        }
+
+        // Only for the writer. Makes the write buffer the newest version and continues with another buffer.
+        void Publish()
+        {
+            const std::uint8_t previous =
+                _middle.exchange(AssertCast<std::uint8_t>(_writing | isNewFlag), std::memory_order_acq_rel);
+            _writing = AssertCast<std::uint8_t>(previous & indexMask);
+        }
+
+        // Only for the reader. Switches to the newest version if there is one and returns whether it did.
+        bool Update()
+        {
+            if ((_middle.load(std::memory_order_relaxed) & isNewFlag) == 0)
+            {
+                return false;
+            }
+            const std::uint8_t previous = _middle.exchange(_reading, std::memory_order_acq_rel);
+            _reading = AssertCast<std::uint8_t>(previous & indexMask);
+            return true;
+        }
+
+        // Only for the reader. Stays the same until the next Update.
+        [[nodiscard]] const T &GetReadBuffer() const
+        {
+            return _buffers[_reading];
+        }
+
+    private:
+        static constexpr std::uint8_t indexMask = 3;
+        // set in _middle when the writer published a version the reader has not seen yet
+        static constexpr std::uint8_t isNewFlag = 4;
+
+        std::array<T, 3> _buffers;
+        std::uint8_t _writing = 0;
+        // the only state both threads touch; in its own cache line because the writer and the reader use the others
+        alignas(64) std::atomic<std::uint8_t> _middle = 1;
+        alignas(64) std::uint8_t _reading = 2;
+    };
+} // namespace ij
@@ -1,60 +1,102 @@
 #include "UserInterface.h"
-#include "Bot.h"
 #include "DrawWorld.h"
 #include "Input.h"
-#include "LogicEntity.h"
 #include "ObjectAnimation.h"
+#include "SimulationThread.h"
 #include <imgui.h>
 
-void ij::UpdateUserInterface(LogicEntity &player, const World &world, const Input &input, Debugging &debugging)
+void ij::UpdateUserInterface(const RenderSnapshot &snapshot, const Input &input, Debugging &debugging,
+                             SimulationControls &controls)
 {
     ImGui::Begin("Character");
     {
         ImGui::Text("Health");
         ImGui::SameLine();
-        ImGui::ProgressBar(AssertCast<float>(player.GetCurrentHealth()) / AssertCast<float>(player.GetMaximumHealth()));
+        ImGui::ProgressBar(AssertCast<float>(snapshot.PlayerCurrentHealth) /
+                           AssertCast<float>(snapshot.PlayerMaximumHealth));
     }
     ImGui::End();
 
     if (input.isDebugModeOn)
     {
-        if (Object *const selectedEnemy = input.selectedEnemy)
+        if (const std::optional<SelectedEnemySnapshot> &enemy = snapshot.SelectedEnemy)
         {
             ImGui::Begin("Enemy");
             {
                 ImGui::Text("Health");
                 ImGui::SameLine();
-                ImGui::ProgressBar(AssertCast<float>(selectedEnemy->Logic.GetCurrentHealth()) /
-                                   AssertCast<float>(selectedEnemy->Logic.GetMaximumHealth()));
+                ImGui::ProgressBar(AssertCast<float>(enemy->CurrentHealth) / AssertCast<float>(enemy->MaximumHealth));
                 ImGui::BeginDisabled();
-                ImGui::Checkbox("Bumped", &selectedEnemy->Logic.HasBumpedIntoWall);
+                bool hasBumpedIntoWall = enemy->HasBumpedIntoWall;
+                ImGui::Checkbox("Bumped", &hasBumpedIntoWall);
+                ImGui::EndDisabled();
+                ImGui::LabelText("Animation", "%s", GetObjectAnimationName(enemy->Animation));
+                ImGui::LabelText("Direction", "%f %f", AssertCast<double>(enemy->Direction.x),
+                                 AssertCast<double>(enemy->Direction.y));
+                ImGui::LabelText("State", "%s", Bot::GetStateName(enemy->BotState));
+                ImGui::BeginDisabled();
+                bool hasTarget = enemy->HasBotTarget;
+                ImGui::Checkbox("Has target", &hasTarget);
                 ImGui::EndDisabled();
-                ImGui::LabelText("Animation", "%s", GetObjectAnimationName(selectedEnemy->Visuals.Animation));
-                ImGui::LabelText("Direction", "%f %f", AssertCast<double>(selectedEnemy->Logic.Direction.x),
-                                 AssertCast<double>(selectedEnemy->Logic.Direction.y));
-                if (const Bot *const bot = dynamic_cast<const Bot *>(selectedEnemy->Logic.Behavior.get()))
-                {
-                    ImGui::LabelText("State", "%s", Bot::GetStateName(bot->GetState()));
-                    ImGui::BeginDisabled();
-                    bool hasTarget = (bot->GetTarget() != nullptr);
-                    ImGui::Checkbox("Has target", &hasTarget);
-                    ImGui::EndDisabled();
-                }
             }
             ImGui::End();
         }
 
         ImGui::Begin("Debug");
-        ImGui::LabelText("Enemies in the world", "%zu", world.enemies.size());
+        ImGui::LabelText("Enemies in the world", "%zu", snapshot.NumberOfEnemies);
         ImGui::LabelText("Enemies drawn", "%zu", debugging.enemiesDrawnLastFrame);
-        ImGui::LabelText("Tiles in the world", "%zu", world.map.Tiles.size());
+        ImGui::LabelText("Tiles in the map", "%zu", snapshot.map.GetNumberOfTiles());
+        ImGui::LabelText("Map memory (KiB)", "%zu", (snapshot.map.GetMemoryUsage() / 1024));
         ImGui::LabelText("Tiles drawn", "%zu", debugging.tilesDrawnLastFrame);
-        ImGui::LabelText("Floating texts in the world", "%zu", world.FloatingTexts.size());
-        ImGui::Checkbox("Player/wall collision", &player.HasCollisionWithWalls);
+        ImGui::LabelText("Tile chunks drawn", "%zu", debugging.TileChunksDrawnLastFrame);
+        if (debugging.TileChunksDrawnLastFrame > 0)
+        {
+            ImGui::LabelText("Tile chunk cache hits (%)", "%.0f",
+                             (100.0 * AssertCast<double>(debugging.TileChunkHitsLastFrame) /
+                              AssertCast<double>(debugging.TileChunksDrawnLastFrame)));
+        }
+        ImGui::LabelText("Draw calls", "%llu", static_cast<unsigned long long>(debugging.DrawCallsLastFrame));
+        ImGui::LabelText("Floating texts in the world", "%zu", debugging.FloatingTextsLastFrame);
+        const DepthOrderStatistics &spriteOrder = debugging.SpriteOrder;
+        ImGui::LabelText("Sprite order repairs", "%llu of %llu", static_cast<unsigned long long>(spriteOrder.Repairs),
+                         static_cast<unsigned long long>(spriteOrder.Repairs + spriteOrder.RadixSorts));
+        ImGui::LabelText("Sprite order moves", "%zu", spriteOrder.MovesLastFrame);
+        debugging.EventsLastFrame = SimulationEventCounts();
+        debugging.EventsLastFrame.Lost =
+            snapshot.Events.Consume(debugging.EventsCounted, [&debugging](const SimulationEvent &event) {
+                debugging.EventsLastFrame.Add(event);
+            });
+        ImGui::LabelText("Damage events", "%zu", debugging.EventsLastFrame.Damage);
+        ImGui::LabelText("Death events", "%zu", debugging.EventsLastFrame.Deaths);
+        ImGui::LabelText("Attack events", "%zu", debugging.EventsLastFrame.AttacksStarted);
+        ImGui::LabelText("Lost events", "%llu", static_cast<unsigned long long>(debugging.EventsLastFrame.Lost));
+        ImGui::Checkbox("Player/wall collision", &controls.HasPlayerCollisionWithWalls);
         ImGui::PlotHistogram("Frame times (ms)", debugging.FrameTimes.data(),
                              AssertCast<int>(debugging.FrameTimes.size()), AssertCast<int>(debugging.NextFrameTime),
                              nullptr, 0.0f, 100.0f, ImVec2(300, 100));
         ImGui::Checkbox("Zoom out", &debugging.IsZoomedOut);
+        ImGui::Checkbox("Parallel simulation", &controls.IsSimulationParallel);
+        ImGui::LabelText("Enemies simulated every tick", "%zu", snapshot.LevelOfDetailCountsLastTick.Near);
+        ImGui::LabelText("Enemies simulated less often", "%zu", snapshot.LevelOfDetailCountsLastTick.Mid);
+        ImGui::LabelText("Dormant enemies", "%zu", snapshot.LevelOfDetailCountsLastTick.Dormant);
+        ImGui::LabelText("Enemies woken up", "%zu", snapshot.LevelOfDetailCountsLastTick.CaughtUp);
+        ImGui::SliderFloat("Full simulation radius", &controls.LevelOfDetail.NearRadius, 600.0f, 5000.0f);
+        ImGui::SliderFloat("Reduced simulation radius", &controls.LevelOfDetail.MidRadius,
+                           controls.LevelOfDetail.NearRadius, 10000.0f);
+
+        CatchUpPolicy &policy = controls.CatchUp;
+        int maximumTicksPerFrame = AssertCast<int>(policy.MaximumTicksPerFrame);
+        if (ImGui::SliderInt("Maximum ticks per frame", &maximumTicksPerFrame, 1, 60))
+        {
+            policy.MaximumTicksPerFrame = AssertCast<size_t>(maximumTicksPerFrame);
+        }
+        ImGui::Checkbox("Drop excess simulation time", &policy.IsDroppingExcessTime);
+        ImGui::SliderFloat("Time scale", &policy.TimeScale, 0.1f, 2.0f);
+        const CatchUpStatistics &statistics = snapshot.CatchUp;
+        ImGui::LabelText("Ticks last frame", "%zu", statistics.TicksLastFrame);
+        ImGui::LabelText("Ticks run", "%llu", static_cast<unsigned long long>(statistics.TicksRun));
+        ImGui::LabelText("Ticks dropped", "%llu", static_cast<unsigned long long>(statistics.TicksDropped));
+        ImGui::LabelText("Worst backlog (ms)", "%lld", static_cast<long long>(statistics.WorstBacklog.Milliseconds));
         ImGui::End();
     }
 }
@@ -2,10 +2,12 @@
 
 namespace ij
 {
-    struct LogicEntity;
-    struct World;
+    struct RenderSnapshot;
     struct Input;
     struct Debugging;
+    struct SimulationControls;
 
-    void UpdateUserInterface(LogicEntity &player, const World &world, const Input &input, Debugging &debugging);
+    // Shows the snapshot. What the user changes about the simulation ends up in controls.
+    void UpdateUserInterface(const RenderSnapshot &snapshot, const Input &input, Debugging &debugging,
+                             SimulationControls &controls);
 } // namespace ij
@@ -0,0 +1,103 @@
+#include "VertexBatch.h"
+#include "AssertCast.h"
+#include <cassert>
+
+namespace ij
+{
+    namespace
+    {
+        [[nodiscard]] bool canContinue(const VertexRun &run, const BatchSource source, const TextureId &texture)
+        {
+            return (run.Source == source) && ((source != BatchSource::Texture) || (run.Texture.Value == texture.Value));
+        }
+
+        [[nodiscard]] std::vector<TexturedVertex> &continueRun(VertexBatch &batch, const BatchSource source,
+                                                               const TextureId &texture)
+        {
+            if (batch.Runs.empty() || !canContinue(batch.Runs.back(), source, texture))
+            {
+                batch.Runs.push_back(VertexRun{source, texture, batch.Vertices.size()});
+            }
+            return batch.Vertices;
+        }
+
+        void appendColoredQuad(const Vector2f &topLeft, const Vector2f &size, const Color color,
+                               std::vector<TexturedVertex> &vertices)
+        {
+            AppendQuad(topLeft, size, Vector2f(0, 0), color, vertices);
+        }
+    } // namespace
+} // namespace ij
+
+void ij::AppendQuad(const Vector2f &topLeft, const Vector2f &size, const Vector2f &textureTopLeft, const Color color,
+                    std::vector<TexturedVertex> &vertices)
+{
+    const auto corner = [&](const float x, const float y) {
+        const Vector2f offset((x * size.x), (y * size.y));
+        return TexturedVertex{(topLeft + offset), (textureTopLeft + offset), color};
+    };
+    vertices.push_back(corner(0, 0));
+    vertices.push_back(corner(1, 0));
+    vertices.push_back(corner(0, 1));
+    vertices.push_back(corner(0, 1));
+    vertices.push_back(corner(1, 0));
+    vertices.push_back(corner(1, 1));
+}
+
+void ij::VertexBatch::AddSprite(const Sprite &sprite)
+{
+    AppendQuad(AssertCastVector<float>(sprite.Position), AssertCastVector<float>(sprite.TextureSize),
+               AssertCastVector<float>(sprite.TextureTopLeft), sprite.ColorMultiplier,
+               continueRun(*this, BatchSource::Texture, sprite.Texture));
+}
+
+void ij::VertexBatch::AddRectangle(const Vector2i &topLeft, const Vector2u &size, const Color outline,
+                                   const Color fill, const float outlineThickness)
+{
+    std::vector<TexturedVertex> &vertices = Continue(BatchSource::Color);
+    const Vector2f position = AssertCastVector<float>(topLeft);
+    const Vector2f extent = AssertCastVector<float>(size);
+    if (fill.Alpha != 0)
+    {
+        appendColoredQuad(position, extent, fill, vertices);
+    }
+    if ((outlineThickness <= 0) || (outline.Alpha == 0))
+    {
+        return;
+    }
+    // the top and bottom edges include the corners
+    const Vector2f horizontalEdge((extent.x + (2 * outlineThickness)), outlineThickness);
+    const Vector2f verticalEdge(outlineThickness, extent.y);
+    appendColoredQuad(position - Vector2f(outlineThickness, outlineThickness), horizontalEdge, outline, vertices);
+    appendColoredQuad(position + Vector2f(-outlineThickness, extent.y), horizontalEdge, outline, vertices);
+    appendColoredQuad(position - Vector2f(outlineThickness, 0), verticalEdge, outline, vertices);
+    appendColoredQuad(position + Vector2f(extent.x, 0), verticalEdge, outline, vertices);
+}
+
+void ij::VertexBatch::AddDot(const Vector2i &position, const Color color)
+{
+    appendColoredQuad(AssertCastVector<float>(position), Vector2f(2, 2), color, Continue(BatchSource::Color));
+}
+
+std::vector<ij::TexturedVertex> &ij::VertexBatch::Continue(const BatchSource source)
+{
+    assert(source != BatchSource::Texture);
+    return continueRun(*this, source, TextureId(SlotHandle()));
+}
+
+size_t ij::VertexBatch::GetRunEnd(const size_t run) const
+{
+    assert(run < Runs.size());
+    return ((run + 1) < Runs.size()) ? Runs[run + 1].Begin : Vertices.size();
+}
+
+bool ij::VertexBatch::IsEmpty() const
+{
+    return Vertices.empty();
+}
+
+void ij::VertexBatch::Clear()
+{
+    Vertices.clear();
+    Runs.clear();
+}
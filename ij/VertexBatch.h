@@ -0,0 +1,60 @@
+#pragma once
+#include "Sprite.h"
+#include <vector>
+
+namespace ij
+{
+    struct TexturedVertex final
+    {
+        Vector2f Position;
+        // in pixels
+        Vector2f TextureCoordinates;
+        Color VertexColor;
+    };
+
+    // Appends two triangles which cover the rectangle from topLeft to topLeft + size.
+    void AppendQuad(const Vector2f &topLeft, const Vector2f &size, const Vector2f &textureTopLeft, Color color,
+                    std::vector<TexturedVertex> &vertices);
+
+    // what the vertices of a run are drawn with
+    enum class BatchSource : std::uint8_t
+    {
+        // only the vertex colors, the texture coordinates are meaningless
+        Color,
+        // the texture of VertexRun::Texture
+        Texture,
+        // the glyph atlas of the canvas
+        Glyphs
+    };
+
+    struct VertexRun final
+    {
+        BatchSource Source;
+        // only for BatchSource::Texture
+        TextureId Texture;
+        // index into VertexBatch::Vertices; the run ends where the next one begins
+        size_t Begin;
+    };
+
+    // Collects everything a canvas draws in triangles, so that a backend can draw consecutive primitives with the
+    // same texture in one call. The order of the runs is the order in which the primitives were added, so the
+    // result looks the same as drawing them one by one.
+    struct VertexBatch final
+    {
+        std::vector<TexturedVertex> Vertices;
+        std::vector<VertexRun> Runs;
+
+        void AddSprite(const Sprite &sprite);
+        // The outline is drawn around the filled area, like sf::RectangleShape does.
+        void AddRectangle(const Vector2i &topLeft, const Vector2u &size, Color outline, Color fill,
+                          float outlineThickness);
+        // a square of two by two pixels
+        void AddDot(const Vector2i &position, Color color);
+        // For vertices without a texture of their own which the caller appends to the result, for example the texts
+        // from the glyph atlas.
+        [[nodiscard]] std::vector<TexturedVertex> &Continue(BatchSource source);
+        [[nodiscard]] size_t GetRunEnd(size_t run) const;
+        [[nodiscard]] bool IsEmpty() const;
+        void Clear();
+    };
+} // namespace ij
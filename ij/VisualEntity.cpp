@@ -27,9 +27,9 @@ ij::Vector2f ij::VisualEntity::GetTopLeftPosition(const Vector2f &bottomLeftPosi
     return bottomLeftPosition - GetOffset();
 }
 
-void ij::updateVisuals(const LogicEntity &logic, VisualEntity &visuals, const TimeSpan deltaTime)
+void ij::updateVisuals(const ObjectActivity activity, VisualEntity &visuals, const TimeSpan deltaTime)
 {
-    switch (logic.GetActivity())
+    switch (activity)
     {
     case ObjectActivity::Standing:
         visuals.Animation = ObjectAnimation::Standing;
@@ -51,7 +51,8 @@ void ij::updateVisuals(const LogicEntity &logic, VisualEntity &visuals, const Ti
     visuals.AnimationTime += deltaTime;
 }
 
-ij::Sprite ij::CreateSpriteForVisualEntity(const LogicEntity &logic, const VisualEntity &visuals)
+ij::Sprite ij::CreateSpriteForVisualEntity(const Vector2f &position, const Vector2f &direction,
+                                           const VisualEntity &visuals)
 {
     bool isColoredDead = false;
     switch (visuals.Animation)
@@ -64,9 +65,9 @@ ij::Sprite ij::CreateSpriteForVisualEntity(const LogicEntity &logic, const Visua
         isColoredDead = true;
         break;
     }
-    const TextureRectangle textureRect = visuals.GetTextureRect(logic.Direction);
+    const TextureRectangle textureRect = visuals.GetTextureRect(direction);
     // the position of an object is at the bottom center of the sprite (on the ground)
-    const Vector2i position = RoundDown<Int32>(visuals.GetTopLeftPosition(logic.Position));
+    const Vector2i topLeft = RoundDown<Int32>(visuals.GetTopLeftPosition(position));
     const auto color = isColoredDead ? Color(128, 128, 128, 255) : Color(255, 255, 255, 255);
-    return Sprite(visuals.Texture, position, color, textureRect.Position, textureRect.Size);
+    return Sprite(visuals.Texture, topLeft, color, textureRect.Position, textureRect.Size);
 }
@@ -21,6 +21,7 @@ namespace ij
         [[nodiscard]] Vector2f GetTopLeftPosition(const Vector2f &bottomLeftPosition) const;
     };
 
-    void updateVisuals(const LogicEntity &logic, VisualEntity &visuals, TimeSpan deltaTime);
-    [[nodiscard]] Sprite CreateSpriteForVisualEntity(const LogicEntity &logic, const VisualEntity &visuals);
+    void updateVisuals(ObjectActivity activity, VisualEntity &visuals, TimeSpan deltaTime);
+    [[nodiscard]] Sprite CreateSpriteForVisualEntity(const Vector2f &position, const Vector2f &direction,
+                                                     const VisualEntity &visuals);
 } // namespace ij
@@ -0,0 +1,105 @@
+#include "WalkabilityMap.h"
+
+ij::WalkabilityMap::WalkabilityMap(const Map &map)
+    : _wordsPerRow(((map.Width + 2) + 63) / 64)
+    , _maximumColumn(AssertCast<float>(map.Width))
+    , _maximumRow(AssertCast<float>(map.GetHeight()))
+{
+    _bits.resize(_wordsPerRow * (map.GetHeight() + 2));
+    for (size_t chunkY = 0; chunkY < map.GetHeightInChunks(); ++chunkY)
+    {
+        for (size_t chunkX = 0; chunkX < map.GetWidthInChunks(); ++chunkX)
+        {
+            const std::span<const Tile, Map::TilesPerChunk> chunk = map.GetChunk(chunkX, chunkY);
+            if (map.IsChunkUniform(chunkX, chunkY) && (chunk[0] == NoTile))
+            {
+                continue;
+            }
+            // the parts of chunks outside of the map are NoTile, so they do not need special treatment
+            for (size_t y = 0; y < Map::ChunkSize; ++y)
+            {
+                for (size_t x = 0; x < Map::ChunkSize; ++x)
+                {
+                    if (chunk[(y * Map::ChunkSize) + x] == NoTile)
+                    {
+                        continue;
+                    }
+                    const size_t paddedColumn = ((chunkX * Map::ChunkSize) + x + 1);
+                    const size_t paddedRow = ((chunkY * Map::ChunkSize) + y + 1);
+                    _bits[(paddedRow * _wordsPerRow) + (paddedColumn / 64u)] |= (UInt64(1) << (paddedColumn % 64u));
+                }
+            }
+        }
+    }
+}
+
+void ij::MovementBatch::Add(const size_t entity, const Vector2f &position, const Vector2f &change)
+{
+    Entities.push_back(entity);
+    X.push_back(position.x);
+    Y.push_back(position.y);
+    ChangeX.push_back(change.x);
+    ChangeY.push_back(change.y);
+}
+
+void ij::MovementBatch::Clear()
+{
+    Entities.clear();
+    X.clear();
+    Y.clear();
+    ChangeX.clear();
+    ChangeY.clear();
+    HasBumpedIntoWall.clear();
+    Bumped.clear();
+}
+
+void ij::MoveWithCollisionDetection(MovementBatch &batch, const WalkabilityMap &walkability,
+                                    const std::span<Vector2f> positions,
+                                    const std::span<std::uint8_t> hasBumpedIntoWall)
+{
+    const size_t count = batch.Entities.size();
+    const float halfWidth = (DefaultEntityDimensions.x / 2.0f);
+    const float halfHeight = (DefaultEntityDimensions.y / 2.0f);
+
+    // First pass: most entities can go where they want. No branches, so this loop can be vectorized.
+    batch.HasBumpedIntoWall.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const bool isWalkable = walkability.IsWalkable(
+            (batch.X[i] + batch.ChangeX[i]), (batch.Y[i] + batch.ChangeY[i]), halfWidth, halfHeight);
+        batch.HasBumpedIntoWall[i] = !isWalkable;
+    }
+
+    // Second pass: move everyone and remember who bumped into a wall. Still no branches which would be unpredictable.
+    batch.Bumped.resize(count);
+    size_t bumped = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t entity = batch.Entities[i];
+        positions[entity] = Vector2f((batch.X[i] + batch.ChangeX[i]), (batch.Y[i] + batch.ChangeY[i]));
+        hasBumpedIntoWall[entity] = batch.HasBumpedIntoWall[i];
+        batch.Bumped[bumped] = i;
+        bumped += batch.HasBumpedIntoWall[i];
+    }
+
+    // Third pass: let the others slide along the wall, horizontally if possible, like the single entity version.
+    for (size_t k = 0; k < bumped; ++k)
+    {
+        const size_t i = batch.Bumped[k];
+        Vector2f &position = positions[batch.Entities[i]];
+        if (const Vector2f horizontalAlternative = Vector2f((batch.X[i] + batch.ChangeX[i]), (batch.Y[i] + 0.0f));
+            walkability.IsWalkable(horizontalAlternative.x, horizontalAlternative.y, halfWidth, halfHeight))
+        {
+            position = horizontalAlternative;
+        }
+        else if (const Vector2f verticalAlternative = Vector2f((batch.X[i] + 0.0f), (batch.Y[i] + batch.ChangeY[i]));
+                 walkability.IsWalkable(verticalAlternative.x, verticalAlternative.y, halfWidth, halfHeight))
+        {
+            position = verticalAlternative;
+        }
+        else
+        {
+            position = Vector2f(batch.X[i], batch.Y[i]);
+        }
+    }
+}
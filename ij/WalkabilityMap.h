@@ -0,0 +1,74 @@
+#pragma once
+#include "LogicEntity.h"
+#include "Map.h"
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace ij
+{
+    // One bit per tile of the map which tells whether entities can walk there. The map is surrounded by a border of
+    // unwalkable tiles. Every point outside of the map is clamped onto that border, so looking up a point needs no
+    // branches.
+    struct WalkabilityMap final
+    {
+        explicit WalkabilityMap(const Map &map);
+
+        [[nodiscard]] bool IsWalkablePoint(const float x, const float y) const noexcept
+        {
+            const size_t paddedColumn = static_cast<size_t>(toTileIndex(x, _maximumColumn) + 1);
+            const size_t paddedRow = static_cast<size_t>(toTileIndex(y, _maximumRow) + 1);
+            const UInt64 word = _bits[(paddedRow * _wordsPerRow) + (paddedColumn / 64u)];
+            return ((word >> (paddedColumn % 64u)) & 1u) != 0;
+        }
+
+        // checks the four corners of the bounding box around the entity in addition to the center
+        [[nodiscard]] bool IsWalkable(const float x, const float y, const float halfWidth,
+                                      const float halfHeight) const noexcept
+        {
+            // & instead of && so that there are no branches
+            return IsWalkablePoint(x - halfWidth, y - halfHeight) & IsWalkablePoint(x + halfWidth, y + halfHeight) &
+                   IsWalkablePoint(x - halfWidth, y + halfHeight) & IsWalkablePoint(x + halfWidth, y - halfHeight) &
+                   IsWalkablePoint(x, y);
+        }
+
+    private:
+        std::vector<UInt64> _bits;
+        size_t _wordsPerRow;
+        // the first column and row of the border on the right and at the bottom
+        float _maximumColumn;
+        float _maximumRow;
+
+        // between -1 and maximum
+        [[nodiscard]] static Int32 toTileIndex(const float pixel, const float maximum) noexcept
+        {
+            // clamping before the conversion to an integer which could overflow otherwise
+            constexpr float tilesPerPixel = (1.0f / TileSize);
+            const float clamped = (std::min)((std::max)((pixel * tilesPerPixel), -1.0f), maximum);
+            // std::floor is a function call on x64 without SSE 4.1
+            const Int32 truncated = static_cast<Int32>(clamped);
+            return (truncated - static_cast<Int32>(clamped < static_cast<float>(truncated)));
+        }
+    };
+
+    // The movements of many entities which collide with walls, as a structure of arrays.
+    struct MovementBatch final
+    {
+        std::vector<size_t> Entities;
+        std::vector<float> X;
+        std::vector<float> Y;
+        std::vector<float> ChangeX;
+        std::vector<float> ChangeY;
+        // filled by MoveWithCollisionDetection
+        std::vector<std::uint8_t> HasBumpedIntoWall;
+        std::vector<size_t> Bumped;
+
+        void Add(size_t entity, const Vector2f &position, const Vector2f &change);
+        void Clear();
+    };
+
+    // Same result as calling the single entity version for every entity of the batch. Writes the new positions and
+    // whether the entities bumped into a wall to the arrays which the indices in the batch refer to.
+    void MoveWithCollisionDetection(MovementBatch &batch, const WalkabilityMap &walkability,
+                                    std::span<Vector2f> positions, std::span<std::uint8_t> hasBumpedIntoWall);
+} // namespace ij
@@ -0,0 +1,99 @@
+#include "WorkerPool.h"
+
+ij::WorkerPool::WorkerPool(const size_t numberOfWorkers)
+{
+    _workers.reserve(numberOfWorkers);
+    for (size_t i = 0; i < numberOfWorkers; ++i)
+    {
+        _workers.emplace_back([this]() { runWorker(); });
+    }
+}
+
+ij::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _batchStarted.notify_all();
+    for (std::thread &worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+size_t ij::WorkerPool::GetNumberOfWorkers() const
+{
+    return _workers.size();
+}
+
+void ij::WorkerPool::ParallelFor(const size_t count, const std::function<void(size_t)> &task)
+{
+    if (_workers.empty() || (count <= 1))
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _taskCount = count;
+        _nextTask = 0;
+        _busyWorkers = _workers.size();
+        ++_batch;
+    }
+    _batchStarted.notify_all();
+    runTasks();
+    std::unique_lock<std::mutex> lock(_mutex);
+    _batchFinished.wait(lock, [this]() { return (_busyWorkers == 0); });
+    _task = nullptr;
+}
+
+void ij::WorkerPool::runWorker()
+{
+    UInt64 lastBatch = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _batchStarted.wait(lock, [this, lastBatch]() { return _isStopping || (_batch != lastBatch); });
+            if (_isStopping)
+            {
+                return;
+            }
+            lastBatch = _batch;
+        }
+        runTasks();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_busyWorkers;
+            if (_busyWorkers == 0)
+            {
+                _batchFinished.notify_one();
+            }
+        }
+    }
+}
+
+void ij::WorkerPool::runTasks()
+{
+    for (;;)
+    {
+        const size_t task = _nextTask.fetch_add(1);
+        if (task >= _taskCount)
+        {
+            return;
+        }
+        (*_task)(task);
+    }
+}
+
+size_t ij::GetDefaultNumberOfWorkers()
+{
+    // the main thread works, too
+    const unsigned cores = std::thread::hardware_concurrency();
+    return ((cores > 1) ? (cores - 1) : 0);
+}
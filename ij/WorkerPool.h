@@ -0,0 +1,42 @@
+#pragma once
+#include "Int.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ij
+{
+    // A fixed set of threads that work on one batch of tasks at a time. The calling thread takes part in the work, so a
+    // pool without any workers simply runs everything on the calling thread.
+    struct WorkerPool final
+    {
+        explicit WorkerPool(size_t numberOfWorkers);
+        ~WorkerPool();
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        [[nodiscard]] size_t GetNumberOfWorkers() const;
+        // calls task(i) for every i in [0, count) and returns when all of them have finished
+        void ParallelFor(size_t count, const std::function<void(size_t)> &task);
+
+    private:
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _batchStarted;
+        std::condition_variable _batchFinished;
+        const std::function<void(size_t)> *_task = nullptr;
+        size_t _taskCount = 0;
+        std::atomic<size_t> _nextTask = 0;
+        size_t _busyWorkers = 0;
+        UInt64 _batch = 0;
+        bool _isStopping = false;
+
+        void runWorker();
+        void runTasks();
+    };
+
+    [[nodiscard]] size_t GetDefaultNumberOfWorkers();
+} // namespace ij
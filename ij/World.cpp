@@ -1,5 +1,5 @@
 #include "World.h"
-#include <fmt/format.h>
+#include <algorithm>
 
 ij::Object::Object(VisualEntity visuals, LogicEntity logic)
     : Visuals(std::move(visuals))
@@ -7,69 +7,152 @@ ij::Object::Object(VisualEntity visuals, LogicEntity logic)
 {
 }
 
-ij::World::World(FontId font, const Map &map, Canvas &visualCanvas)
-    : Font(font)
-    , map(map)
-    , VisualCanvas(visualCanvas)
+namespace ij
+{
+    namespace
+    {
+        // several frames worth of hits on large groups of enemies
+        constexpr size_t simulationEventCapacity = 4096;
+
+        // std::ranges::sort falls back to heap code whose signed distances make GCC warn about signed overflow at
+        // -O2. The merge sort of std::ranges::stable_sort does not, and the indices are unique anyway.
+        void sortEnemies(std::vector<size_t> &enemies)
+        {
+            std::ranges::stable_sort(enemies);
+        }
+    } // namespace
+} // namespace ij
+
+ij::World::World(FontId font, Map map, const UInt64 simulationSeed)
+    : Events(simulationEventCapacity)
+    , Font(font)
+    , map(std::move(map))
+    , Walkability(this->map)
+    , EnemyGrid(this->map.Width, this->map.GetHeight())
+    , TowardsPlayer(GetFlowFieldRadius(BotChaseDistance))
+    , LargestEnemySprite(0, 0)
+    , SimulationSeed(simulationSeed)
+    , TimeStep(GetSimulationTimeStep(FrameRate))
+    , TotalShift(0, 0)
+{
+}
+
+void ij::AddEnemy(World &world, const VisualEntity &visuals, const Vector2f &position, const Vector2f &direction,
+                  const Health currentHealth, const Health maximumHealth)
 {
+    world.EnemyGrid.Insert(world.enemies.GetCount(), position);
+    world.LargestEnemySprite.x = (std::max)(world.LargestEnemySprite.x, visuals.SpriteSize.x);
+    world.LargestEnemySprite.y = (std::max)(world.LargestEnemySprite.y, visuals.SpriteSize.y);
+    world.enemies.Add(visuals, position, direction, currentHealth, maximumHealth, ObjectActivity::Standing);
+    // there is nothing to catch up on for an enemy spawned during the game
+    world.enemies.SimulatedTicks.back() = world.SimulatedTicks;
 }
 
-[[nodiscard]] ij::Object *ij::FindEnemyByPosition(World &world, const Vector2f &position)
+void ij::ReplaceMap(World &world, LogicEntity &player, Map map, const Vector2f &shift)
 {
-    for (Object &enemy : world.enemies)
+    world.Walkability = WalkabilityMap(map);
+    world.EnemyGrid = SpatialGrid(map.Width, map.GetHeight());
+    world.TowardsPlayer.Invalidate();
+    world.map = std::move(map);
+    player.Position += shift;
+    player.PreviousPosition += shift;
+    EnemyStore &enemies = world.enemies;
+    for (size_t i = 0; i < enemies.GetCount(); ++i)
     {
-        const Vector2f topLeft = enemy.Visuals.GetTopLeftPosition(enemy.Logic.Position);
-        const Vector2f bottomRight = topLeft + AssertCastVector<float>(enemy.Visuals.SpriteSize);
-        if ((position.x >= topLeft.x) && (position.x <= bottomRight.x) && (position.y >= topLeft.y) &&
-            (position.y <= bottomRight.y))
-        {
-            return &enemy;
-        }
+        enemies.Positions[i] += shift;
+        enemies.PreviousPositions[i] += shift;
+        enemies.IsDirty[i] = true;
+        world.EnemyGrid.Insert(i, enemies.Positions[i]);
     }
-    return nullptr;
+    world.Events.ShiftPositions(shift);
+    world.TotalShift += shift;
 }
 
-std::vector<ij::Object *> ij::FindEnemiesInCircle(World &world, const Vector2f &center, float radius)
+std::optional<size_t> ij::FindEnemyByPosition(const World &world, const Vector2f &position)
 {
-    std::vector<Object *> results;
-    for (Object &enemy : world.enemies)
-    {
-        if (isWithinDistance(center, enemy.Logic.Position, radius))
+    // the sprite of an enemy can extend in every direction from its logical position
+    const Vector2f largestSprite = AssertCastVector<float>(world.LargestEnemySprite);
+    std::optional<size_t> found;
+    world.EnemyGrid.ForEachCandidate(
+        Rectangle<float>(position - largestSprite, largestSprite * 2.0f), [&world, &position, &found](size_t enemy) {
+            const VisualEntity &visuals = world.enemies.Visuals[enemy];
+            const Vector2f topLeft = visuals.GetTopLeftPosition(world.enemies.Positions[enemy]);
+            const Vector2f bottomRight = topLeft + AssertCastVector<float>(visuals.SpriteSize);
+            // prefer the enemy that comes first in the list to be independent from the order of the grid cells
+            if ((position.x >= topLeft.x) && (position.x <= bottomRight.x) && (position.y >= topLeft.y) &&
+                (position.y <= bottomRight.y) && (!found || (enemy < *found)))
+            {
+                found = enemy;
+            }
+        });
+    return found;
+}
+
+std::vector<size_t> ij::FindEnemiesInCircle(const World &world, const Vector2f &center, float radius)
+{
+    std::vector<size_t> results;
+    const Vector2f halfSize(radius, radius);
+    world.EnemyGrid.ForEachCandidate(
+        Rectangle<float>(center - halfSize, halfSize * 2.0f), [&world, &center, radius, &results](size_t enemy) {
+            if (isWithinDistance(center, world.enemies.Positions[enemy], radius))
+            {
+                results.emplace_back(enemy);
+            }
+        });
+    // keep the order of the enemy list so that the results do not depend on how the enemies moved between cells
+    sortEnemies(results);
+    return results;
+}
+
+std::vector<size_t> ij::FindEnemiesInRectangle(const World &world, const Rectangle<float> &area)
+{
+    std::vector<size_t> results;
+    world.EnemyGrid.ForEachCandidate(area, [&world, &area, &results](size_t enemy) {
+        const Vector2f &position = world.enemies.Positions[enemy];
+        if (IsValueInRange(position.x, area.Position.x, area.Position.x + area.Size.x) &&
+            IsValueInRange(position.y, area.Position.y, area.Position.y + area.Size.y))
         {
-            results.emplace_back(&enemy);
+            results.emplace_back(enemy);
         }
-    }
+    });
+    sortEnemies(results);
     return results;
 }
 
 namespace ij
 {
-    template <class T>
-    void EraseRandomElementUnstable(std::vector<T> &container, RandomNumberGenerator &random)
+    namespace
     {
-        if (container.empty())
+        void pushDamageEvents(World &world, const size_t entity, const Vector2f &position, const Health damage,
+                              const bool isDead)
         {
-            return;
+            world.Events.Push(
+                SimulationEvent{SimulationEventType::Damage, entity, position, damage, world.SimulatedTicks});
+            if (isDead)
+            {
+                world.Events.Push(
+                    SimulationEvent{SimulationEventType::Death, entity, position, 0, world.SimulatedTicks});
+            }
         }
-        const size_t erased = random.GenerateSize(0, container.size() - 1);
-        container[erased] = std::move(container.back());
-        container.pop_back();
-    }
+    } // namespace
 } // namespace ij
 
-void ij::InflictDamage(LogicEntity &damaged, World &world, const Health damage, RandomNumberGenerator &random)
+void ij::InflictDamage(LogicEntity &damaged, World &world, const Health damage)
 {
     if (!damaged.inflictDamage(damage))
     {
         return;
     }
-    constexpr size_t floatingTextLimit = 1000;
-    while (world.FloatingTexts.size() >= floatingTextLimit)
+    pushDamageEvents(world, PlayerEntity, damaged.Position, damage, isDead(damaged));
+}
+
+void ij::InflictDamageOnEnemy(World &world, const size_t enemy, const Health damage)
+{
+    if (!world.enemies.InflictDamage(enemy, damage))
     {
-        EraseRandomElementUnstable(world.FloatingTexts, random);
+        return;
     }
-    world.FloatingTexts.emplace_back(
-        world.VisualCanvas, fmt::format("{}", damage), damaged.Position, world.Font, random);
+    pushDamageEvents(world, enemy, world.enemies.Positions[enemy], damage, world.enemies.IsDead(enemy));
 }
 
 bool ij::isWithinDistance(const Vector2f &first, const Vector2f &second, const float distance)
@@ -96,17 +179,130 @@ ij::Vector2f ij::GenerateRandomPointForSpawning(const World &world, RandomNumber
     return position;
 }
 
-void ij::UpdateWorld(TimeSpan &remainingSimulationTime, LogicEntity &player, World &world,
-                     RandomNumberGenerator &randomNumberGenerator)
+namespace ij
 {
-    const TimeSpan simulationTimeStep = TimeSpan::FromMilliseconds(AssertCast<Int64>(1000 / FrameRate));
-    while (remainingSimulationTime >= simulationTimeStep)
+    namespace
     {
-        remainingSimulationTime -= simulationTimeStep;
-        updateLogic(player, player, world, simulationTimeStep, randomNumberGenerator);
-        for (Object &enemy : world.enemies)
+        // enemies use their index as the random stream
+        constexpr UInt64 PlayerRandomStream = ~UInt64(0);
+
+        void updatePartition(World &world, const size_t begin, const size_t end, const LogicEntity &player,
+                             const TimeSpan timeStep, CommandBuffer &commands)
         {
-            updateLogic(enemy.Logic, player, world, simulationTimeStep, randomNumberGenerator);
+            EnemyStore &enemies = world.enemies;
+            const UInt64 tick = world.SimulatedTicks;
+            const LevelOfDetailSettings &levelOfDetail = world.LevelOfDetail;
+            const UInt64 midTickInterval = GetMidTickInterval(levelOfDetail, timeStep);
+            // enemies only interact with the player, so every enemy can be updated completely before the next one
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (enemies.IsDead(i))
+                {
+                    continue;
+                }
+                switch (ChooseSimulationTier(levelOfDetail, enemies.Positions[i], player.Position))
+                {
+                case SimulationTier::Near:
+                    ++commands.Counts.Near;
+                    break;
+                case SimulationTier::Mid:
+                    ++commands.Counts.Mid;
+                    // spread the mid range updates evenly over the ticks
+                    if (((tick + i) % midTickInterval) != 0)
+                    {
+                        continue;
+                    }
+                    break;
+                case SimulationTier::Dormant:
+                    ++commands.Counts.Dormant;
+                    continue;
+                }
+
+                CounterBasedRandomNumberGenerator random(world.SimulationSeed, tick, i);
+                const UInt64 elapsedTicks = ((tick + 1) - enemies.SimulatedTicks[i]);
+                enemies.SimulatedTicks[i] = (tick + 1);
+                enemies.IsDirty[i] = true;
+                Vector2f &position = enemies.Positions[i];
+                const Vector2f previousPosition = position;
+                enemies.PreviousPositions[i] = position;
+                TimeSpan deltaTime = timeStep;
+                if (elapsedTicks > midTickInterval)
+                {
+                    ++commands.Counts.CaughtUp;
+                    CatchUpDormantEnemy(
+                        enemies, i, TimeSpan::FromMilliseconds(timeStep.Milliseconds * AssertCast<Int64>(elapsedTicks)),
+                        world, random);
+                    // the enemy jumps to where it would be by now instead of sliding there
+                    enemies.PreviousPositions[i] = position;
+                }
+                else
+                {
+                    deltaTime = TimeSpan::FromMilliseconds(timeStep.Milliseconds * AssertCast<Int64>(elapsedTicks));
+                }
+
+                UpdateBot(enemies, i, player, world.TowardsPlayer, deltaTime, random, commands);
+                if (enemies.Activities[i] == ObjectActivity::Walking)
+                {
+                    commands.Movements.Add(
+                        i, position,
+                        enemies.Directions[i] * (AssertCast<float>(deltaTime.Milliseconds) * WalkingVelocity));
+                }
+                commands.GridMoves.push_back(CommandBuffer::GridMove{i, previousPosition});
+            }
+            MoveWithCollisionDetection(commands.Movements, world.Walkability, enemies.Positions,
+                                       enemies.HasBumpedIntoWall);
         }
+
+        void updateEnemies(World &world, LogicEntity &player, const TimeSpan deltaTime, WorkerPool &workers)
+        {
+            const size_t count = world.enemies.GetCount();
+            const size_t partitions = ((count + EnemiesPerPartition - 1) / EnemiesPerPartition);
+            world.EnemyCommands.resize(partitions);
+            workers.ParallelFor(partitions, [&world, count, &player, deltaTime](const size_t partition) {
+                const size_t begin = (partition * EnemiesPerPartition);
+                updatePartition(world, begin, (std::min)(count, begin + EnemiesPerPartition), player, deltaTime,
+                                world.EnemyCommands[partition]);
+            });
+
+            world.LevelOfDetailCountsLastTick = LevelOfDetailCounts();
+            for (CommandBuffer &commands : world.EnemyCommands)
+            {
+                world.LevelOfDetailCountsLastTick.Add(commands.Counts);
+                for (const CommandBuffer::GridMove &move : commands.GridMoves)
+                {
+                    world.EnemyGrid.Move(move.Enemy, move.From, world.enemies.Positions[move.Enemy]);
+                }
+                for (const CommandBuffer::Attack &attack : commands.AttacksOnPlayer)
+                {
+                    world.Events.Push(SimulationEvent{SimulationEventType::AttackStarted, attack.Enemy,
+                                                      world.enemies.Positions[attack.Enemy], 0, world.SimulatedTicks});
+                    InflictDamage(player, world, attack.Damage);
+                }
+                commands.Clear();
+            }
+        }
+    } // namespace
+} // namespace ij
+
+ij::TimeSpan ij::GetSimulationTimeStep(const unsigned ticksPerSecond)
+{
+    assert(ticksPerSecond > 0);
+    return TimeSpan::FromMilliseconds(AssertCast<Int64>(1000 / ticksPerSecond));
+}
+
+void ij::UpdateWorld(TimeSpan &remainingSimulationTime, LogicEntity &player, World &world, WorkerPool &workers)
+{
+    const TimeSpan simulationTimeStep = world.TimeStep;
+    while (remainingSimulationTime >= simulationTimeStep)
+    {
+        remainingSimulationTime -= simulationTimeStep;
+        // for drawing between the ticks
+        player.PreviousPosition = player.Position;
+        CounterBasedRandomNumberGenerator playerRandom(world.SimulationSeed, world.SimulatedTicks, PlayerRandomStream);
+        updateLogic(player, player, world, simulationTimeStep, playerRandom);
+        // only does something when the player entered another tile
+        (void)world.TowardsPlayer.Update(world.Walkability, player.Position);
+        updateEnemies(world, player, simulationTimeStep, workers);
+        ++world.SimulatedTicks;
     }
 }
@@ -1,13 +1,26 @@
 #pragma once
-#include "FloatingText.h"
+#include "Canvas.h"
+#include "CommandBuffer.h"
+#include "EnemyStore.h"
+#include "FlowField.h"
 #include "LogicEntity.h"
 #include "Map.h"
+#include "SimulationEvents.h"
+#include "SpatialGrid.h"
 #include "VisualEntity.h"
+#include "WalkabilityMap.h"
+#include "WorkerPool.h"
+#include <optional>
 #include <vector>
 
 namespace ij
 {
+    // the usual number of frames per second, which is also the default number of ticks per second
     constexpr unsigned FrameRate = 60;
+    // a tick has to last at least a millisecond
+    constexpr unsigned MaximumTicksPerSecond = 1000;
+    // enemies are updated in groups of this size which is independent from the number of threads
+    constexpr size_t EnemiesPerPartition = 1024;
 
     struct Object final
     {
@@ -19,21 +32,49 @@ namespace ij
 
     struct World final
     {
-        std::vector<Object> enemies;
-        std::vector<FloatingText> FloatingTexts;
+        EnemyStore enemies;
+        // what happened in UpdateWorld for everything outside of the simulation
+        SimulationEventQueue Events;
         const FontId Font;
-        const Map &map;
-        Canvas &VisualCanvas;
+        Map map;
+        WalkabilityMap Walkability;
+        // indices into enemies; has to be kept in sync with the enemy positions
+        SpatialGrid EnemyGrid;
+        // for chasing bots, see UpdateWorld
+        FlowField TowardsPlayer;
+        // the largest sprite of all enemies, needed to find candidates for hits on the sprite area
+        Vector2u LargestEnemySprite;
+        // the random numbers used by the simulation only depend on this seed and the number of simulated ticks
+        const UInt64 SimulationSeed;
+        UInt64 SimulatedTicks = 0;
+        // the duration of one tick, see GameSettings::TicksPerSecond
+        TimeSpan TimeStep;
+        // one per partition of the enemies, reused every tick
+        std::vector<CommandBuffer> EnemyCommands;
+        LevelOfDetailSettings LevelOfDetail;
+        LevelOfDetailCounts LevelOfDetailCountsLastTick;
+        // the sum of the shifts by ReplaceMap, so that positions kept outside of the world can be moved along
+        Vector2f TotalShift;
 
-        explicit World(FontId font, const Map &map, Canvas &visualCanvas);
+        explicit World(FontId font, Map map, UInt64 simulationSeed);
     };
 
-    [[nodiscard]] Object *FindEnemyByPosition(World &world, const Vector2f &position);
-    [[nodiscard]] std::vector<Object *> FindEnemiesInCircle(World &world, const Vector2f &center, float radius);
-    void InflictDamage(LogicEntity &damaged, World &world, Health damage, RandomNumberGenerator &random);
+    void AddEnemy(World &world, const VisualEntity &visuals, const Vector2f &position, const Vector2f &direction,
+                  Health currentHealth, Health maximumHealth);
+    // Replaces the map and moves everything in the world by shift, for example when the map is a moving window into a
+    // larger world. Positions which end up outside of the new map stay there.
+    void ReplaceMap(World &world, LogicEntity &player, Map map, const Vector2f &shift);
+    [[nodiscard]] std::optional<size_t> FindEnemyByPosition(const World &world, const Vector2f &position);
+    [[nodiscard]] std::vector<size_t> FindEnemiesInCircle(const World &world, const Vector2f &center, float radius);
+    [[nodiscard]] std::vector<size_t> FindEnemiesInRectangle(const World &world, const Rectangle<float> &area);
+    // damaged is the player
+    void InflictDamage(LogicEntity &damaged, World &world, Health damage);
+    void InflictDamageOnEnemy(World &world, size_t enemy, Health damage);
     [[nodiscard]] bool isWithinDistance(const Vector2f &first, const Vector2f &second, float distance);
     [[nodiscard]] Vector2f GenerateRandomPointForSpawning(const World &world,
                                                           RandomNumberGenerator &randomNumberGenerator);
-    void UpdateWorld(TimeSpan &remainingSimulationTime, LogicEntity &player, World &world,
-                     RandomNumberGenerator &randomNumberGenerator);
+    // the duration of one tick at this rate, rounded down to whole milliseconds
+    [[nodiscard]] TimeSpan GetSimulationTimeStep(unsigned ticksPerSecond);
+    // The result only depends on World::SimulationSeed, not on the number of workers.
+    void UpdateWorld(TimeSpan &remainingSimulationTime, LogicEntity &player, World &world, WorkerPool &workers);
 } // namespace ij
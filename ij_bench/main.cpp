@@ -0,0 +1,524 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <ij/Camera.h>
+#include <ij/Checksum.h>
+#include <ij/DrawWorld.h>
+#include <ij/InputRecording.h>
+#include <ij/MapFile.h>
+#include <ij/NullCanvas.h>
+#include <ij/NullTextureLoader.h>
+#include <ij/SaveGame.h>
+#include <ij/SimulationClock.h>
+#include <ij/StreamedWorld.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#ifdef _WIN32
+#include <windows.h>
+// windows.h has to come first
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace ij
+{
+    struct BenchmarkSettings final
+    {
+        GameSettings Game = {1, 500, 500, 0.02f};
+        UInt64 Ticks = (60 * FrameRate);
+        size_t NumberOfWorkers = GetDefaultNumberOfWorkers();
+        bool IsDrawing = false;
+        // print the rolling checksum of the world every this many ticks, 0 for only at the end
+        UInt64 ChecksumInterval = 0;
+        // replaces the map settings and the scripted input
+        std::optional<std::filesystem::path> ReplayFile;
+        std::optional<std::filesystem::path> RecordFile;
+        // replaces the generated map
+        std::optional<std::filesystem::path> MapFile;
+        // Runs as many ticks per frame as the game would, given the measured frame times and a display which never
+        // shows more than FrameRate frames per second. Otherwise every frame has exactly one tick.
+        bool IsPaced = false;
+        CatchUpPolicy CatchUp;
+        // saves the game into this file every SaveInterval ticks while running
+        std::optional<std::filesystem::path> SaveGameFile;
+        UInt64 SaveInterval = FrameRate;
+    };
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: ij_bench [--map-width N] [--map-height N] [--enemies-per-tile F] [--ticks N] [--seed N] "
+                     "[--workers N] [--draw] [--checksum-interval N] [--replay FILE] [--record-input FILE] [--paced] "
+                     "[--max-ticks-per-frame N] [--keep-excess-time] [--time-scale F] [--infinite-world] "
+                     "[--map-file FILE] [--save-game FILE] [--save-interval N] [--tick-rate N]\n";
+    }
+
+    // the whole value has to be a number which fits into T, unlike std::stoul which ignores trailing characters
+    template <class T>
+    [[nodiscard]] std::optional<T> ParseInteger(const std::string &value)
+    {
+        T result = 0;
+        const std::from_chars_result parsed = std::from_chars(value.data(), (value.data() + value.size()), result);
+        if ((parsed.ec != std::errc()) || (parsed.ptr != (value.data() + value.size())))
+        {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::optional<BenchmarkSettings> ParseCommandLine(const int argc, char **const argv)
+    {
+        BenchmarkSettings settings;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            if (argument == "--draw")
+            {
+                settings.IsDrawing = true;
+                continue;
+            }
+            if (argument == "--paced")
+            {
+                settings.IsPaced = true;
+                continue;
+            }
+            if (argument == "--infinite-world")
+            {
+                settings.Game.IsWorldInfinite = true;
+                continue;
+            }
+            if (argument == "--keep-excess-time")
+            {
+                settings.CatchUp.IsDroppingExcessTime = false;
+                continue;
+            }
+            if ((i + 1) >= argc)
+            {
+                return std::nullopt;
+            }
+            const std::string value = argv[++i];
+            try
+            {
+                if (argument == "--map-width")
+                {
+                    settings.Game.MapWidth = std::stoull(value);
+                }
+                else if (argument == "--map-height")
+                {
+                    settings.Game.MapHeight = std::stoull(value);
+                }
+                else if (argument == "--enemies-per-tile")
+                {
+                    settings.Game.EnemiesPerTile = std::stof(value);
+                }
+                else if (argument == "--ticks")
+                {
+                    settings.Ticks = std::stoull(value);
+                }
+                else if (argument == "--seed")
+                {
+                    const std::optional<UInt32> seed = ParseInteger<UInt32>(value);
+                    if (!seed)
+                    {
+                        return std::nullopt;
+                    }
+                    settings.Game.Seed = *seed;
+                }
+                else if (argument == "--workers")
+                {
+                    settings.NumberOfWorkers = std::stoull(value);
+                }
+                else if (argument == "--checksum-interval")
+                {
+                    settings.ChecksumInterval = std::stoull(value);
+                }
+                else if (argument == "--max-ticks-per-frame")
+                {
+                    settings.CatchUp.MaximumTicksPerFrame = std::stoull(value);
+                }
+                else if (argument == "--time-scale")
+                {
+                    settings.CatchUp.TimeScale = std::stof(value);
+                }
+                else if (argument == "--replay")
+                {
+                    settings.ReplayFile = value;
+                }
+                else if (argument == "--record-input")
+                {
+                    settings.RecordFile = value;
+                }
+                else if (argument == "--map-file")
+                {
+                    settings.MapFile = value;
+                }
+                else if (argument == "--save-game")
+                {
+                    settings.SaveGameFile = value;
+                }
+                else if (argument == "--save-interval")
+                {
+                    settings.SaveInterval = std::stoull(value);
+                }
+                else if (argument == "--tick-rate")
+                {
+                    const std::optional<unsigned> ticksPerSecond = ParseInteger<unsigned>(value);
+                    if (!ticksPerSecond)
+                    {
+                        return std::nullopt;
+                    }
+                    // checked against MaximumTicksPerSecond below
+                    settings.Game.TicksPerSecond = *ticksPerSecond;
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+            catch (const std::logic_error &)
+            {
+                return std::nullopt;
+            }
+        }
+        if ((settings.Game.MapWidth == 0) || (settings.Game.MapHeight == 0) || (settings.Ticks == 0) ||
+            (settings.SaveInterval == 0) || (settings.CatchUp.MaximumTicksPerFrame == 0) ||
+            !(settings.CatchUp.TimeScale > 0) || (settings.Game.TicksPerSecond == 0) ||
+            (settings.Game.TicksPerSecond > MaximumTicksPerSecond))
+        {
+            return std::nullopt;
+        }
+        return settings;
+    }
+
+    // The player walks in a square and attacks whenever they have completed a side, so that the benchmark covers
+    // walking, fighting and a moving camera.
+    [[nodiscard]] InputRecording ScriptInput(const GameSettings &settings, const UInt64 ticks)
+    {
+        constexpr UInt64 ticksPerSide = (2 * FrameRate);
+        constexpr UInt64 attackTicks = (FrameRate / 2);
+        constexpr std::array<Direction, 4> sides = {Direction::Up, Direction::Right, Direction::Down, Direction::Left};
+        InputRecording recording{settings, {}};
+        for (UInt64 tick = 0; tick < ticks; tick += ticksPerSide)
+        {
+            RecordedInput walking;
+            walking.IsDirectionKeyPressed[AssertCast<size_t>(sides[(tick / ticksPerSide) % sides.size()])] = true;
+            RecordedInput attacking;
+            attacking.IsAttackPressed = true;
+            const UInt64 sideTicks = (std::min)(ticksPerSide, (ticks - tick));
+            const UInt64 walkingTicks = (std::min)(sideTicks, (ticksPerSide - attackTicks));
+            recording.Runs.push_back(InputRun{walking, walkingTicks});
+            if (sideTicks > walkingTicks)
+            {
+                recording.Runs.push_back(InputRun{attacking, (sideTicks - walkingTicks)});
+            }
+        }
+        return recording;
+    }
+
+    [[nodiscard]] std::optional<InputRecording> LoadInput(const BenchmarkSettings &settings)
+    {
+        if (!settings.ReplayFile)
+        {
+            return ScriptInput(settings.Game, settings.Ticks);
+        }
+        std::ifstream file(*settings.ReplayFile, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Could not open " << settings.ReplayFile->string() << '\n';
+            return std::nullopt;
+        }
+        std::optional<InputRecording> recording = ReadInputRecording(file);
+        if (!recording)
+        {
+            std::cerr << settings.ReplayFile->string() << " is not an input recording\n";
+        }
+        return recording;
+    }
+
+    [[nodiscard]] bool SaveInput(const std::filesystem::path &file, const InputRecording &recording)
+    {
+        std::ofstream stream(file, std::ios::binary);
+        if (!stream)
+        {
+            std::cerr << "Could not create " << file.string() << '\n';
+            return false;
+        }
+        InputRecorder recorder(stream, recording.Settings);
+        for (const InputRun &run : recording.Runs)
+        {
+            recorder.Record(run.Input, run.Ticks);
+        }
+        recorder.Finish();
+        return !!stream;
+    }
+
+    // in bytes
+    [[nodiscard]] size_t GetPeakResidentSetSize()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters = {};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return 0;
+        }
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage = {};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+        // Linux reports kilobytes
+        return (AssertCast<size_t>(usage.ru_maxrss) * 1024);
+#endif
+    }
+
+    void PrintLatencies(const char *const name, std::vector<double> &microseconds)
+    {
+        if (microseconds.empty())
+        {
+            return;
+        }
+        // not std::ranges::sort, whose heap code makes GCC warn about signed overflow at -O2
+        std::ranges::stable_sort(microseconds);
+        const auto percentile = [&microseconds](const double fraction) -> double {
+            return microseconds[AssertCast<size_t>(
+                std::floor(fraction * AssertCast<double>(microseconds.size() - 1)))];
+        };
+        std::cout << name << " latency (us): p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 "
+                  << percentile(0.99) << ", p99.9 " << percentile(0.999) << ", max " << microseconds.back() << '\n';
+    }
+
+    [[nodiscard]] double MeasureMicroseconds(const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    [[nodiscard]] bool RunBenchmark(const BenchmarkSettings &settings)
+    {
+        // a recording only contains the settings for generating a map, so its replay would run on another one
+        if (settings.MapFile && settings.RecordFile)
+        {
+            std::cerr << "The input of a game on a map file can not be recorded\n";
+            return false;
+        }
+        const std::optional<InputRecording> recording = LoadInput(settings);
+        if (!recording)
+        {
+            return false;
+        }
+        if (settings.RecordFile && !SaveInput(*settings.RecordFile, *recording))
+        {
+            return false;
+        }
+
+        NullTextureLoader textures;
+        NullCanvas canvas;
+        const std::optional<std::vector<EnemyTemplate>> enemyTemplates = LoadEnemies(textures, "");
+        const std::optional<TextureId> playerTexture = textures.LoadFromFile("");
+        const std::optional<TextureId> grassTexture = textures.LoadFromFile("");
+        if (!enemyTemplates || !playerTexture || !grassTexture)
+        {
+            std::cerr << "Could not load textures\n";
+            return false;
+        }
+
+        const auto setupStart = std::chrono::steady_clock::now();
+        std::optional<Map> map;
+        if (settings.MapFile)
+        {
+            if (recording->Settings.IsWorldInfinite)
+            {
+                std::cerr << "An infinite world has no map file\n";
+                return false;
+            }
+            map = LoadMapFile(*settings.MapFile);
+            if (!map)
+            {
+                std::cerr << "Could not load map " << settings.MapFile->string() << '\n';
+                return false;
+            }
+        }
+        const double mapLoadMicroseconds = MeasureMicroseconds(setupStart);
+        Game game(recording->Settings, *enemyTemplates, *playerTexture, std::move(map));
+        const double setupMicroseconds = MeasureMicroseconds(setupStart);
+        const World &world = game.SimulatedWorld;
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << (game.Streaming ? "Infinite world, map " : "Map ") << world.map.Width << "x"
+                  << world.map.GetHeight() << ", " << world.enemies.GetCount() << " enemies, seed "
+                  << recording->Settings.Seed << ", " << (settings.NumberOfWorkers + 1) << " threads"
+                  << (settings.IsDrawing ? ", drawing" : "") << '\n';
+        std::cout << "Setup: " << (setupMicroseconds / 1000.0) << " ms";
+        if (settings.MapFile)
+        {
+            std::cout << ", of which loading the map file " << std::setprecision(3) << (mapLoadMicroseconds / 1000.0)
+                      << std::setprecision(1) << " ms";
+        }
+        std::cout << '\n';
+
+        std::unique_ptr<SaveGameWriter> saveGameWriter;
+        if (settings.SaveGameFile)
+        {
+            if (game.Streaming)
+            {
+                std::cerr << "An infinite world can not be saved\n";
+                return false;
+            }
+            saveGameWriter = OpenSaveGame(*settings.SaveGameFile);
+            if (!saveGameWriter)
+            {
+                std::cerr << "Could not open save game " << settings.SaveGameFile->string() << '\n';
+                return false;
+            }
+        }
+
+        WorkerPool workers(settings.NumberOfWorkers);
+        Camera camera{game.Player.Logic.Position};
+        Debugging debugging;
+        std::vector<DrawCommand> drawCommands;
+        RenderSnapshot snapshot(game);
+        WorldPresentation presentation(snapshot);
+        const TimeSpan timeStep = world.TimeStep;
+        const TimeSpan refreshPeriod = GetSimulationTimeStep(FrameRate);
+        const UInt64 numberOfTicks = recording->GetNumberOfTicks();
+        std::vector<double> tickMicroseconds;
+        std::vector<double> drawMicroseconds;
+        std::vector<double> snapshotMicroseconds;
+        size_t savedEnemies = 0;
+        size_t spritesDrawn = 0;
+        tickMicroseconds.reserve(numberOfTicks);
+        UInt64 checksum = InitialChecksum;
+        InputPlayback playback(*recording);
+        SimulationClock simulationClock(timeStep);
+        simulationClock.Policy = settings.CatchUp;
+        TimeSpan lastFrameTime = refreshPeriod;
+        UInt64 tick = 0;
+        UInt64 frames = 0;
+        UInt64 eventsCounted = 0;
+        SimulationEventCounts events;
+        const auto start = std::chrono::steady_clock::now();
+        while (!playback.IsFinished())
+        {
+            const auto frameStart = std::chrono::steady_clock::now();
+            const UInt64 ticksThisFrame =
+                settings.IsPaced
+                    ? AssertCast<UInt64>(simulationClock.Advance(lastFrameTime).Milliseconds / timeStep.Milliseconds)
+                    : 1;
+            for (UInt64 i = 0; (i < ticksThisFrame) && !playback.IsFinished(); ++i)
+            {
+                playback.ApplyNextTick(game.CurrentInput, game.SimulatedWorld);
+                const auto tickStart = std::chrono::steady_clock::now();
+                TimeSpan remainingSimulationTime = timeStep;
+                UpdateGame(game, remainingSimulationTime, workers);
+                tickMicroseconds.push_back(MeasureMicroseconds(tickStart));
+                ++tick;
+                if ((settings.ChecksumInterval > 0) && ((tick % settings.ChecksumInterval) == 0))
+                {
+                    checksum = UpdateChecksum(checksum, world, game.Player.Logic);
+                    std::cout << "Tick " << tick << " checksum " << std::hex << std::setw(16) << std::setfill('0')
+                              << checksum << std::dec << std::setfill(' ') << '\n';
+                }
+                if (saveGameWriter && ((tick % settings.SaveInterval) == 0))
+                {
+                    const auto snapshotStart = std::chrono::steady_clock::now();
+                    SaveGameSnapshot snapshot = TakeSaveGameSnapshot(game);
+                    savedEnemies += snapshot.Enemies.size();
+                    snapshotMicroseconds.push_back(MeasureMicroseconds(snapshotStart));
+                    saveGameWriter->Submit(std::move(snapshot));
+                }
+            }
+            events.Lost += game.SimulatedWorld.Events.Consume(
+                eventsCounted, [&events](const SimulationEvent &event) { events.Add(event); });
+            if (settings.IsDrawing)
+            {
+                const auto drawStart = std::chrono::steady_clock::now();
+                AnimateVisibleObjects(game, canvas.GetSize(), lastFrameTime);
+                UpdateRenderSnapshot(snapshot, game, canvas.GetSize());
+                // without pacing every frame ends exactly on a tick
+                const float interpolation = (settings.IsPaced ? simulationClock.GetInterpolation() : 1.0f);
+                camera.Center =
+                    InterpolatePosition(snapshot.PlayerPreviousPosition, snapshot.PlayerPosition, interpolation);
+                DrawWorld(canvas, camera, game.CurrentInput, debugging, snapshot, interpolation, presentation,
+                          *grassTexture, lastFrameTime, drawCommands);
+                canvas.Flush();
+                drawMicroseconds.push_back(MeasureMicroseconds(drawStart));
+                // the enemies and the player
+                spritesDrawn += (debugging.enemiesDrawnLastFrame + 1);
+            }
+            ++frames;
+            // the display waits for the next refresh when a frame is faster than that
+            lastFrameTime = TimeSpan::FromMilliseconds((std::max)(
+                refreshPeriod.Milliseconds, static_cast<Int64>(std::ceil(MeasureMicroseconds(frameStart) / 1000.0))));
+        }
+        const double totalSeconds = (MeasureMicroseconds(start) / 1'000'000.0);
+        checksum = UpdateChecksum(checksum, world, game.Player.Logic);
+
+        std::cout << "Ticks: " << numberOfTicks << " in " << std::setprecision(3) << totalSeconds << " s = "
+                  << std::setprecision(1) << (AssertCast<double>(numberOfTicks) / totalSeconds) << " ticks/s\n";
+        std::cout << "Frames: " << frames << '\n';
+        PrintLatencies("Tick", tickMicroseconds);
+        PrintLatencies("Draw", drawMicroseconds);
+        PrintLatencies("Snapshot", snapshotMicroseconds);
+        if (!drawMicroseconds.empty())
+        {
+            const DepthOrderStatistics &statistics = debugging.SpriteOrder;
+            std::cout << "Sprites: " << (AssertCast<double>(spritesDrawn) / AssertCast<double>(drawMicroseconds.size()))
+                      << " per frame on average, order repaired " << statistics.Repairs << " times, radix sorted "
+                      << statistics.RadixSorts << " times\n";
+        }
+        std::cout << "Events: " << events.Damage << " damage, " << events.Deaths << " deaths, " << events.AttacksStarted
+                  << " attacks started, " << events.Lost << " lost\n";
+        if (saveGameWriter && !snapshotMicroseconds.empty())
+        {
+            saveGameWriter->WaitUntilWritten();
+            const SaveGameStatistics statistics = saveGameWriter->GetStatistics();
+            const double writingSeconds = std::chrono::duration<double>(statistics.TimeSpentWriting).count();
+            std::cout << "Save game: " << snapshotMicroseconds.size() << " saves of on average "
+                      << (AssertCast<double>(savedEnemies) / AssertCast<double>(snapshotMicroseconds.size()))
+                      << " changed enemies, " << statistics.RowsWritten << " rows in " << statistics.Transactions
+                      << " transactions (" << statistics.FailedTransactions << " failed), " << std::setprecision(0)
+                      << (AssertCast<double>(statistics.RowsWritten) / writingSeconds) << " rows/s while writing"
+                      << std::setprecision(1) << (statistics.HasFailed ? ", FAILED" : "") << '\n';
+        }
+        if (settings.IsPaced)
+        {
+            const CatchUpStatistics &statistics = simulationClock.Statistics;
+            std::cout << "Catch up: " << statistics.TicksRun << " ticks run, " << statistics.TicksDropped
+                      << " ticks dropped, worst backlog " << statistics.WorstBacklog.Milliseconds << " ms\n";
+        }
+        if (game.Streaming)
+        {
+            const StreamingStatistics &statistics = game.Streaming->Statistics;
+            const WorldPosition position = ToWorldPosition(game.Player.Logic.Position, game.Streaming->GetOrigin());
+            std::cout << "Streaming: " << statistics.Recenterings << " recenterings, "
+                      << statistics.ChunksGeneratedInBackground << " chunks generated in the background, "
+                      << statistics.ChunksGeneratedOnDemand << " on demand, " << statistics.ChunksEvicted
+                      << " evicted, " << game.Streaming->GetNumberOfLoadedChunks() << " loaded, "
+                      << statistics.RequestsDropped << " requests dropped, "
+                      << statistics.EnemiesSpawned << " enemies spawned, " << statistics.EnemiesEvicted
+                      << " evicted\n";
+            std::cout << "Player in chunk " << position.Chunk.X << ", " << position.Chunk.Y << '\n';
+        }
+        std::cout << "Peak RSS: " << (AssertCast<double>(GetPeakResidentSetSize()) / (1024.0 * 1024.0)) << " MiB\n";
+        std::cout << "Player health at the end: " << game.Player.Logic.GetCurrentHealth() << '\n';
+        std::cout << "Final checksum: " << std::hex << std::setw(16) << std::setfill('0') << checksum << std::dec
+                  << '\n';
+        return true;
+    }
+} // namespace ij
+
+int main(int argc, char **argv)
+{
+    using namespace ij;
+    const std::optional<BenchmarkSettings> settings = ParseCommandLine(argc, argv);
+    if (!settings)
+    {
+        PrintUsage();
+        return 1;
+    }
+    return !RunBenchmark(*settings);
+}
@@ -0,0 +1,98 @@
+#include <ij/FastRandomNumberGenerator.h>
+#include <ij/MapFile.h>
+#include <iostream>
+#include <string>
+
+namespace ij
+{
+    struct ConverterSettings final
+    {
+        UInt32 Seed = 0;
+        size_t MapWidth = 500;
+        size_t MapHeight = 500;
+        std::filesystem::path Output;
+    };
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: ij_map --output FILE [--seed N] [--map-width N] [--map-height N]\n"
+                     "Writes the map that the game generates for the seed to FILE.\n";
+    }
+
+    [[nodiscard]] std::optional<ConverterSettings> ParseCommandLine(const int argc, char **const argv)
+    {
+        ConverterSettings settings;
+        for (int i = 1; (i + 1) < argc; i += 2)
+        {
+            const std::string argument = argv[i];
+            const std::string value = argv[i + 1];
+            try
+            {
+                if (argument == "--output")
+                {
+                    settings.Output = value;
+                }
+                else if (argument == "--seed")
+                {
+                    settings.Seed = AssertCast<UInt32>(std::stoul(value));
+                }
+                else if (argument == "--map-width")
+                {
+                    settings.MapWidth = std::stoull(value);
+                }
+                else if (argument == "--map-height")
+                {
+                    settings.MapHeight = std::stoull(value);
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+            catch (const std::logic_error &)
+            {
+                return std::nullopt;
+            }
+        }
+        if (((argc % 2) == 0) || settings.Output.empty() || (settings.MapWidth == 0) || (settings.MapHeight == 0))
+        {
+            return std::nullopt;
+        }
+        return settings;
+    }
+
+    [[nodiscard]] bool ConvertMap(const ConverterSettings &settings)
+    {
+        // the same random numbers as in Game
+        FastRandomNumberGenerator random(settings.Seed);
+        const Map map = GenerateRandomMap(random, settings.MapWidth, settings.MapHeight);
+        if (!SaveMapFile(settings.Output, map))
+        {
+            std::cerr << "Could not write " << settings.Output.string() << '\n';
+            return false;
+        }
+        const std::optional<Map> loaded = LoadMapFile(settings.Output);
+        if (!loaded)
+        {
+            std::cerr << "Could not load " << settings.Output.string() << " after writing it\n";
+            return false;
+        }
+        std::cout << "Map " << loaded->Width << "x" << loaded->GetHeight() << ", "
+                  << (loaded->GetChunkTiles().size() / Map::TilesPerChunk) << " chunks stored for "
+                  << loaded->GetChunkIndex().size() << " chunks, "
+                  << std::filesystem::file_size(settings.Output) << " bytes\n";
+        return true;
+    }
+} // namespace ij
+
+int main(int argc, char **argv)
+{
+    using namespace ij;
+    const std::optional<ConverterSettings> settings = ParseCommandLine(argc, argv);
+    if (!settings)
+    {
+        PrintUsage();
+        return 1;
+    }
+    return !ConvertMap(*settings);
+}
@@ -1,8 +1,11 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
+#include <ij/DrawCommand.h>
+#include <ij/GlyphAtlas.h>
 #include <ij/Keyboard.h>
 #include <ij/RunGame.h>
+#include <ij/TileChunks.h>
 #include <imgui.h>
 #include <imgui_impl_sdl2.h>
 #include <imgui_impl_sdlrenderer2.h>
@@ -16,10 +19,16 @@ namespace ij
 
     [[nodiscard]] SDL_Color ToSdlColor(const Color &from)
     {
-        const SDL_Color result = {from.Red, from.Green, from.Green, from.Alpha};
+        const SDL_Color result = {from.Red, from.Green, from.Blue, from.Alpha};
         return result;
     }
 
+    struct SdlTexture final
+    {
+        UniqueTexture Texture;
+        Vector2u Size;
+    };
+
     struct SdlTextureManager final : TextureLoader
     {
         explicit SdlTextureManager(SDL_Renderer &renderer)
@@ -28,11 +37,12 @@ namespace ij
         }
 
         [[nodiscard]] std::optional<TextureId> LoadFromFile(const std::filesystem::path &textureFile) override;
-        SDL_Texture &GetTexture(TextureId id);
+        [[nodiscard]] TextureId Add(SdlTexture texture);
+        [[nodiscard]] const SdlTexture &GetTexture(TextureId id) const;
 
     private:
         SDL_Renderer &_renderer;
-        std::vector<UniqueTexture> _textures;
+        SlotMap<SdlTexture> _textures;
     };
 
     std::optional<TextureId> SdlTextureManager::LoadFromFile(const std::filesystem::path &textureFile)
@@ -47,15 +57,18 @@ namespace ij
         {
             return std::nullopt;
         }
-        const TextureId result{AssertCast<UInt32>(_textures.size())};
-        _textures.emplace_back(std::move(texture));
-        return result;
+        const Vector2u size(AssertCast<UInt32>(surface->w), AssertCast<UInt32>(surface->h));
+        return Add(SdlTexture{std::move(texture), size});
     }
 
-    SDL_Texture &SdlTextureManager::GetTexture(TextureId id)
+    TextureId SdlTextureManager::Add(SdlTexture texture)
     {
-        assert(id.Value < _textures.size());
-        return *_textures[id.Value];
+        return TextureId(_textures.Add(std::move(texture)));
+    }
+
+    const SdlTexture &SdlTextureManager::GetTexture(TextureId id) const
+    {
+        return _textures.Get(id.Value);
     }
 
     void SetDrawColor(SDL_Renderer &renderer, const Color color)
@@ -76,13 +89,115 @@ namespace ij
         return Vector2u(AssertCast<Uint32>(width), AssertCast<Uint32>(height));
     }
 
-    struct SdlCanvas final : Canvas
+    struct SdlGlyphAtlas final
+    {
+        GlyphAtlas Glyphs;
+        UniqueTexture Texture;
+        Vector2u TextureSize;
+    };
+
+    // Renders every glyph of the font in white once, so that texts only need quads colored by their vertices.
+    [[nodiscard]] std::optional<SdlGlyphAtlas> LoadGlyphAtlas(SDL_Renderer &renderer, TTF_Font &font)
+    {
+        constexpr int outlineThickness = 1;
+        const SDL_Color white = {255, 255, 255, 255};
+        std::vector<UniqueSurface> surfaces;
+        std::vector<Vector2u> sizes;
+        GlyphAtlas glyphs;
+        for (const int outline : {0, outlineThickness})
+        {
+            TTF_SetFontOutline(&font, outline);
+            for (size_t i = 0; i < AtlasCharacterCount; ++i)
+            {
+                const Uint16 character = AssertCast<Uint16>(FirstAtlasCharacter + i);
+                // nothing for glyphs without pixels like the space
+                UniqueSurface surface(TTF_RenderGlyph_Blended(&font, character, white), &SDL_FreeSurface);
+                sizes.emplace_back(surface ? AssertCast<UInt32>(surface->w) : 0u,
+                                   surface ? AssertCast<UInt32>(surface->h) : 0u);
+                surfaces.emplace_back(std::move(surface));
+                if (outline == 0)
+                {
+                    int advance = 0;
+                    if (TTF_GlyphMetrics(&font, character, nullptr, nullptr, nullptr, nullptr, &advance) != 0)
+                    {
+                        std::cerr << "TTF_GlyphMetrics failed: " << TTF_GetError() << '\n';
+                        return std::nullopt;
+                    }
+                    glyphs.Advances.push_back(AssertCast<float>(advance));
+                }
+            }
+        }
+        TTF_SetFontOutline(&font, 0);
+
+        constexpr UInt32 atlasWidth = 512;
+        const PackedRectangles packed = PackRectangles(sizes, atlasWidth);
+        const UniqueSurface atlas(SDL_CreateRGBSurfaceWithFormat(0, AssertCast<int>(atlasWidth),
+                                                                 AssertCast<int>(packed.Height), 32,
+                                                                 SDL_PIXELFORMAT_RGBA32),
+                                  &SDL_FreeSurface);
+        if (!atlas)
+        {
+            std::cerr << "SDL_CreateRGBSurfaceWithFormat failed: " << SDL_GetError() << '\n';
+            return std::nullopt;
+        }
+        for (size_t i = 0; i < surfaces.size(); ++i)
+        {
+            const bool isOutline = (i >= AtlasCharacterCount);
+            // the outlined glyph is larger by the outline on every side
+            const float offset = (isOutline ? -AssertCast<float>(outlineThickness) : 0.0f);
+            (isOutline ? glyphs.Outlines : glyphs.Fills)
+                .push_back(AtlasGlyph{packed.TopLeft[i], sizes[i], Vector2f(offset, offset)});
+            if (!surfaces[i])
+            {
+                continue;
+            }
+            // copy the alpha channel instead of blending it onto the empty atlas
+            SDL_SetSurfaceBlendMode(surfaces[i].get(), SDL_BLENDMODE_NONE);
+            SDL_Rect destination = {AssertCast<int>(packed.TopLeft[i].x), AssertCast<int>(packed.TopLeft[i].y),
+                                    AssertCast<int>(sizes[i].x), AssertCast<int>(sizes[i].y)};
+            if (SDL_BlitSurface(surfaces[i].get(), nullptr, atlas.get(), &destination) != 0)
+            {
+                std::cerr << "SDL_BlitSurface failed: " << SDL_GetError() << '\n';
+                return std::nullopt;
+            }
+        }
+        UniqueTexture texture(SDL_CreateTextureFromSurface(&renderer, atlas.get()), &SDL_DestroyTexture);
+        if (!texture)
+        {
+            std::cerr << "SDL_CreateTextureFromSurface failed: " << SDL_GetError() << '\n';
+            return std::nullopt;
+        }
+        SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+        return SdlGlyphAtlas{std::move(glyphs), std::move(texture), Vector2u(atlasWidth, packed.Height)};
+    }
+
+    // Texture coordinates are in pixels in the batch, but relative to the size of the texture for SDL.
+    void ConvertVertices(const std::span<const TexturedVertex> from, const Vector2f &viewTopLeft,
+                         const Vector2f &textureSize, std::vector<SDL_Vertex> &to)
+    {
+        to.clear();
+        for (const TexturedVertex &vertex : from)
+        {
+            const Vector2f position = (vertex.Position - viewTopLeft);
+            to.push_back(SDL_Vertex{SDL_FPoint{position.x, position.y}, ToSdlColor(vertex.VertexColor),
+                                    SDL_FPoint{(vertex.TextureCoordinates.x / textureSize.x),
+                                               (vertex.TextureCoordinates.y / textureSize.y)}});
+        }
+    }
+
+    // 16 chunks of 1024 by 1024 pixels, which covers a window of up to 3072 by 3072 pixels. The cache grows beyond
+    // this for a larger window because the chunks in the batch must not be replaced before the batch is flushed.
+    constexpr size_t tileChunkMemoryBudget = (64 * 1024 * 1024);
+
+    struct SdlCanvas final : Canvas, TileChunkRenderer
     {
-        explicit SdlCanvas(SDL_Window &window, SDL_Renderer &renderer, SdlTextureManager &textures, TTF_Font &font0)
+        explicit SdlCanvas(SDL_Window &window, SDL_Renderer &renderer, SdlTextureManager &textures,
+                           SdlGlyphAtlas &glyphs)
             : _window(window)
             , _renderer(renderer)
             , _textures(textures)
-            , _font0(font0)
+            , _glyphs(glyphs)
+            , _tileChunkCache(tileChunkMemoryBudget)
         {
         }
 
@@ -91,18 +206,14 @@ namespace ij
             return GetWindowSize(_window);
         }
 
+        // a single pixel, like SDL_RenderDrawPoint
         void DrawDot(const Vector2i &position, const Color color) override
         {
-            SetDrawColor(_renderer, color);
-            const int returnCode =
-                SDL_RenderDrawPoint(&_renderer, position.x - _viewTopLeft.x, position.y - _viewTopLeft.y);
-            if (returnCode != 0)
-            {
-                std::cerr << "SDL_RenderDrawPoint failed with " << returnCode << ": " << SDL_GetError() << '\n';
-                return;
-            }
+            AppendQuad(AssertCastVector<float>(position), Vector2f(1, 1), Vector2f(0, 0), color,
+                       _batch.Continue(BatchSource::Color));
         }
 
+        // The outline is inside of the rectangle and at least one pixel thick.
         void DrawRectangle(const Vector2i &topLeft, const Vector2u &size, const Color outline, const Color fill,
                            float outlineThickness) override
         {
@@ -110,144 +221,62 @@ namespace ij
             {
                 return;
             }
-            SetDrawColor(_renderer, outline);
-            const int integerThickness = (std::max)(1, RoundDown<int>(outlineThickness));
-            for (int i = 0; i < integerThickness; ++i)
+            const Int32 integerThickness = (std::max)(1, RoundDown<Int32>(outlineThickness));
+            const Vector2u inner(
+                AssertCast<UInt32>((std::max)(0, AssertCast<Int32>(size.x) - (2 * integerThickness))),
+                AssertCast<UInt32>((std::max)(0, AssertCast<Int32>(size.y) - (2 * integerThickness))));
+            if ((inner.x == 0) || (inner.y == 0))
             {
-                const SDL_Rect rectangle = {topLeft.x - _viewTopLeft.x + i, topLeft.y - _viewTopLeft.y + i,
-                                            std::max(0, AssertCast<int>(size.x) - (2 * i)),
-                                            std::max(0, AssertCast<int>(size.y) - (2 * i))};
-                const int returnCode = SDL_RenderDrawRect(&_renderer, &rectangle);
-                if (returnCode != 0)
-                {
-                    std::cerr << "SDL_RenderDrawRect failed with " << returnCode << ": " << SDL_GetError() << '\n';
-                    return;
-                }
-            }
-            if (fill.Alpha == 0)
-            {
-                // rectangle is not filled
-                return;
-            }
-            SetDrawColor(_renderer, fill);
-            const SDL_Rect rectangle = {topLeft.x - _viewTopLeft.x + integerThickness,
-                                        topLeft.y - _viewTopLeft.y + integerThickness,
-                                        std::max(0, AssertCast<int>(size.x) - (2 * integerThickness)),
-                                        std::max(0, AssertCast<int>(size.y) - (2 * integerThickness))};
-            const int returnCode = SDL_RenderFillRect(&_renderer, &rectangle);
-            if (returnCode != 0)
-            {
-                std::cerr << "SDL_RenderFillRect failed with " << returnCode << ": " << SDL_GetError() << '\n';
+                // only the outline fits
+                _batch.AddRectangle(topLeft, size, outline, outline, 0);
                 return;
             }
+            _batch.AddRectangle(topLeft + Vector2i(integerThickness, integerThickness), inner, outline, fill,
+                                AssertCast<float>(integerThickness));
         }
 
         void DrawSprite(const Sprite &sprite) override
         {
-            SDL_Texture &texture = _textures.GetTexture(sprite.Texture);
-            {
-                const int returnCode = SDL_SetTextureColorMod(
-                    &texture, sprite.ColorMultiplier.Red, sprite.ColorMultiplier.Green, sprite.ColorMultiplier.Blue);
-                if (returnCode != 0)
-                {
-                    std::cerr << "SDL_SetTextureColorMod failed with " << returnCode << ": " << SDL_GetError() << '\n';
-                    return;
-                }
-            }
-            {
-                const int returnCode = SDL_SetTextureAlphaMod(&texture, sprite.ColorMultiplier.Alpha);
-                if (returnCode != 0)
-                {
-                    std::cerr << "SDL_SetTextureAlphaMod failed with " << returnCode << ": " << SDL_GetError() << '\n';
-                    return;
-                }
-            }
-            const SDL_Rect source = {AssertCast<int>(sprite.TextureTopLeft.x), AssertCast<int>(sprite.TextureTopLeft.y),
-                                     AssertCast<int>(sprite.TextureSize.x), AssertCast<int>(sprite.TextureSize.y)};
-            const SDL_Rect destination = {sprite.Position.x - _viewTopLeft.x, sprite.Position.y - _viewTopLeft.y,
-                                          AssertCast<int>(sprite.TextureSize.x), AssertCast<int>(sprite.TextureSize.y)};
-            const int returnCode = SDL_RenderCopy(&_renderer, &texture, &source, &destination);
-            if (returnCode != 0)
-            {
-                std::cerr << "SDL_RenderCopy failed with " << returnCode << ": " << SDL_GetError() << '\n';
-                return;
-            }
+            _batch.AddSprite(sprite);
         }
 
-        [[nodiscard]] Text CreateText(const std::string &content, FontId font, const Vector2f &position,
+        [[nodiscard]] Text CreateText(const std::string_view content, FontId font, const Vector2f &position,
                                       Color fillColor, Color outlineColor, float outlineThickness) override
         {
             assert(font == 0);
-            UniqueSurface textSurface(
-                TTF_RenderUTF8_Shaded(&_font0, content.c_str(), ToSdlColor(fillColor), ToSdlColor(outlineColor)),
-                SDL_FreeSurface);
-            assert(textSurface);
-            UniqueTexture textTexture(SDL_CreateTextureFromSurface(&_renderer, textSurface.get()), SDL_DestroyTexture);
-            assert(textTexture);
-            TextSlot textSlot(std::move(textTexture), position);
-            const auto foundEmptySlot =
-                std::find_if(_texts.begin(), _texts.end(), [](const TextSlot &text) { return !text.Texture; });
-            if (foundEmptySlot == _texts.end())
-            {
-                const TextId id = _texts.size();
-                _texts.emplace_back(std::move(textSlot));
-                return Text(*this, id);
-            }
-            const TextId id = AssertCast<size_t>(std::distance(_texts.begin(), foundEmptySlot));
-            *foundEmptySlot = std::move(textSlot);
-            return Text(*this, id);
+            // the outlines in the atlas have a thickness of 1
+            (void)outlineThickness;
+            return Text(*this, _texts.Create(content, position, fillColor, outlineColor));
         }
 
         void SetTextPosition(TextId id, const Vector2f &position) override
         {
-            assert(id < _texts.size());
-            assert(_texts[id].Texture);
-            _texts[id].Position = position;
+            _texts.SetPosition(id, position);
         }
 
         Vector2f GetTextPosition(TextId id) override
         {
-            assert(id < _texts.size());
-            assert(_texts[id].Texture);
-            return _texts[id].Position;
+            return _texts.GetPosition(id);
         }
 
         void DeleteText(TextId id) override
         {
-            assert(id < _texts.size());
-            assert(_texts[id].Texture);
-            _texts[id].Texture.reset();
+            _texts.Delete(id);
         }
 
         void DrawText(TextId id) override
         {
-            assert(id < _texts.size());
-            const TextSlot &textSlot = _texts[id];
-            assert(textSlot.Texture);
-            int textureWidth = 0;
-            int textureHeight = 0;
-            {
-                const int returnCode =
-                    SDL_QueryTexture(textSlot.Texture.get(), NULL, NULL, &textureWidth, &textureHeight);
-                if (returnCode != 0)
-                {
-                    std::cerr << "SDL_QueryTexture failed with " << returnCode << ": " << SDL_GetError() << '\n';
-                    return;
-                }
-            }
-            const SDL_Rect destination = {RoundDown<int>(textSlot.Position.x) - _viewTopLeft.x,
-                                          RoundDown<int>(textSlot.Position.y - _viewTopLeft.y), textureWidth,
-                                          textureHeight};
-            const int returnCode = SDL_RenderCopy(&_renderer, textSlot.Texture.get(), nullptr, &destination);
-            if (returnCode != 0)
-            {
-                std::cerr << "SDL_RenderCopy failed with " << returnCode << ": " << SDL_GetError() << '\n';
-                return;
-            }
+            _texts.AppendVertices(id, _glyphs.Glyphs, _batch.Continue(BatchSource::Glyphs));
+        }
+
+        void Submit(const std::span<const DrawCommand> commands) override
+        {
+            SubmitOneByOne(*this, commands);
         }
 
         void SetView(const Rectangle<float> &view) override
         {
+            Flush();
             _viewTopLeft = RoundDown<Int32>(view.Position);
             const Vector2u windowSize = GetSize();
             const int returnCode =
@@ -259,25 +288,137 @@ namespace ij
             }
         }
 
-    private:
-        struct TextSlot final
+        // One SDL_RenderGeometry for each run of primitives with the same texture. The colors are in the vertices, so
+        // the color and alpha modulation of the textures never has to change.
+        void Flush() override
+        {
+            const Vector2f viewTopLeft = AssertCastVector<float>(_viewTopLeft);
+            for (size_t i = 0; i < _batch.Runs.size(); ++i)
+            {
+                const VertexRun &run = _batch.Runs[i];
+                const size_t end = _batch.GetRunEnd(i);
+                if (end == run.Begin)
+                {
+                    continue;
+                }
+                SDL_Texture *texture = nullptr;
+                Vector2f textureSize(1, 1);
+                switch (run.Source)
+                {
+                case BatchSource::Color:
+                    break;
+                case BatchSource::Texture: {
+                    const SdlTexture &sdlTexture = _textures.GetTexture(run.Texture);
+                    texture = sdlTexture.Texture.get();
+                    textureSize = AssertCastVector<float>(sdlTexture.Size);
+                    break;
+                }
+                case BatchSource::Glyphs:
+                    texture = _glyphs.Texture.get();
+                    textureSize = AssertCastVector<float>(_glyphs.TextureSize);
+                    break;
+                }
+                ConvertVertices(std::span<const TexturedVertex>(_batch.Vertices).subspan(run.Begin, (end - run.Begin)),
+                                viewTopLeft, textureSize, _sdlVertices);
+                const int returnCode = SDL_RenderGeometry(&_renderer, texture, _sdlVertices.data(),
+                                                          AssertCast<int>(_sdlVertices.size()), nullptr, 0);
+                ++_drawCalls;
+                if (returnCode != 0)
+                {
+                    std::cerr << "SDL_RenderGeometry failed with " << returnCode << ": " << SDL_GetError() << '\n';
+                    break;
+                }
+            }
+            _batch.Clear();
+            _tileChunkCache.StartFrame();
+        }
+
+        [[nodiscard]] UInt64 GetDrawCallCount() override
         {
-            UniqueTexture Texture;
-            Vector2f Position;
+            return _drawCalls;
+        }
+
+        [[nodiscard]] TileChunkRenderer *GetTileChunkRenderer() override
+        {
+            return this;
+        }
 
-            TextSlot(UniqueTexture texture, const Vector2f &position) noexcept
-                : Texture(std::move(texture))
-                , Position(position)
+        [[nodiscard]] bool DrawTileChunk(const std::span<const Tile, Map::TilesPerChunk> tiles,
+                                         const TextureId tileset, const Vector2i &topLeft) override
+        {
+            const TileChunkCache::Lookup lookup = _tileChunkCache.Find(tiles);
+            bool isDrawn = lookup.IsCached;
+            // the cache hands out the slots in order
+            while (_tileChunkTextures.size() <= lookup.Slot)
             {
+                UniqueTexture texture(SDL_CreateTexture(&_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+                                                        AssertCast<int>(TileChunkPixels),
+                                                        AssertCast<int>(TileChunkPixels)),
+                                      &SDL_DestroyTexture);
+                if (!texture)
+                {
+                    std::cerr << "SDL_CreateTexture failed: " << SDL_GetError() << '\n';
+                    return false;
+                }
+                SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+                _tileChunkTextures.push_back(
+                    _textures.Add(SdlTexture{std::move(texture), Vector2u(TileChunkPixels, TileChunkPixels)}));
+                isDrawn = false;
             }
-        };
+            const TextureId texture = _tileChunkTextures[lookup.Slot];
+            if (!isDrawn && !drawTilesInto(tiles, tileset, *_textures.GetTexture(texture).Texture))
+            {
+                return false;
+            }
+            _batch.AddSprite(Sprite(texture, topLeft, Color(255, 255, 255, 255), Vector2u(0, 0),
+                                    Vector2u(TileChunkPixels, TileChunkPixels)));
+            return lookup.IsCached;
+        }
 
+    private:
         SDL_Window &_window;
         SDL_Renderer &_renderer;
         SdlTextureManager &_textures;
-        TTF_Font &_font0;
+        SdlGlyphAtlas &_glyphs;
         Vector2i _viewTopLeft{0, 0};
-        std::vector<TextSlot> _texts;
+        AtlasTexts _texts;
+        VertexBatch _batch;
+        std::vector<SDL_Vertex> _sdlVertices;
+        UInt64 _drawCalls = 0;
+        TileChunkCache _tileChunkCache;
+        // one per slot of the cache
+        std::vector<TextureId> _tileChunkTextures;
+
+        [[nodiscard]] bool drawTilesInto(const std::span<const Tile, Map::TilesPerChunk> tiles,
+                                         const TextureId tileset, SDL_Texture &target)
+        {
+            VertexBatch batch;
+            AddTileSprites(tiles, tileset, batch);
+            const SdlTexture &tilesetTexture = _textures.GetTexture(tileset);
+            std::vector<SDL_Vertex> vertices;
+            ConvertVertices(batch.Vertices, Vector2f(0, 0), AssertCastVector<float>(tilesetTexture.Size), vertices);
+            if (SDL_SetRenderTarget(&_renderer, &target) != 0)
+            {
+                std::cerr << "SDL_SetRenderTarget failed: " << SDL_GetError() << '\n';
+                return false;
+            }
+            SetDrawColor(_renderer, Color(0, 0, 0, 0));
+            bool isSuccess = (SDL_RenderClear(&_renderer) == 0);
+            isSuccess = isSuccess && (SDL_RenderGeometry(&_renderer, tilesetTexture.Texture.get(), vertices.data(),
+                                                         AssertCast<int>(vertices.size()), nullptr, 0) == 0);
+            ++_drawCalls;
+            if (!isSuccess)
+            {
+                std::cerr << "Drawing a tile chunk failed: " << SDL_GetError() << '\n';
+            }
+            // the scale of the view is restored together with the window as the target
+            if (SDL_SetRenderTarget(&_renderer, nullptr) != 0)
+            {
+                std::cerr << "SDL_SetRenderTarget failed: " << SDL_GetError() << '\n';
+                return false;
+            }
+            return isSuccess;
+        }
     };
 
     [[nodiscard]] std::optional<keyboard::Key> KeyFromSdl(const SDL_Keycode key)
@@ -332,7 +473,7 @@ namespace ij
             return _isOpen;
         }
 
-        void ProcessEvents(Input &input, const Camera &camera, World &world) override
+        void ProcessEvents(Input &input, const Camera &camera, std::optional<Vector2f> &selectionClick) override
         {
             SDL_Event event;
             while (SDL_PollEvent(&event))
@@ -358,9 +499,8 @@ namespace ij
                 {
                     if ((event.type == SDL_MOUSEBUTTONDOWN) && (event.button.button == 1))
                     {
-                        const Vector2f pointInWorld = camera.getWorldFromScreenCoordinates(
+                        selectionClick = camera.getWorldFromScreenCoordinates(
                             GetWindowSize(_window), Vector2i(event.button.x, event.button.y));
-                        input.selectedEnemy = FindEnemyByPosition(world, pointInWorld);
                     }
                 }
             }
@@ -495,15 +635,22 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    std::optional<SdlGlyphAtlas> glyphs = LoadGlyphAtlas(*renderer, *font0);
+    if (!glyphs)
+    {
+        std::cerr << "Could not create the glyph atlas\n";
+        return 1;
+    }
+
     SdlTextureManager textures(*renderer);
-    SdlCanvas canvas(*window, *renderer, textures, *font0);
+    SdlCanvas canvas(*window, *renderer, textures, *glyphs);
     {
         const Vector2f windowSize = AssertCastVector<float>(canvas.GetSize());
         ImGui::GetIO().DisplaySize = ImVec2{windowSize.x, windowSize.y};
     }
 
     SdlWindowFunctions windowFunctions(*window, *renderer);
-    const bool success = RunGame(textures, canvas, assets, windowFunctions);
+    const bool success = RunGame(textures, canvas, assets, windowFunctions, ParseGameOptions(argc, argv));
     ImGui_ImplSDLRenderer2_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
@@ -1,21 +1,20 @@
 #include "FromSfml.h"
 #include "ToSfml.h"
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
-#include <SFML/Graphics/Sprite.hpp>
-#include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/Clock.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <array>
-#include <fmt/format.h>
 #include <ij/AssertCast.h>
 #include <ij/Bot.h>
+#include <ij/DrawCommand.h>
 #include <ij/DrawWorld.h>
-#include <ij/FloatingText.h>
+#include <ij/GlyphAtlas.h>
 #include <ij/Keyboard.h>
 #include <ij/LogicEntity.h>
 #include <ij/Map.h>
@@ -24,6 +23,8 @@
 #include <ij/RandomNumberGenerator.h>
 #include <ij/RunGame.h>
 #include <ij/TextureCutter.h>
+#include <ij/TileChunks.h>
+#include <ij/Unreachable.h>
 #include <ij/UserInterface.h>
 #include <ij/VisualEntity.h>
 #include <ij/World.h>
@@ -72,7 +73,8 @@ namespace ij
         }
     }
 
-    void ProcessEvents(Input &input, sf::RenderWindow &window, const Camera &camera, World &world)
+    void ProcessEvents(Input &input, sf::RenderWindow &window, const Camera &camera,
+                       std::optional<Vector2f> &selectionClick)
     {
         sf::Event event = {};
         while (window.pollEvent(event))
@@ -97,9 +99,8 @@ namespace ij
             if (!ImGui::GetIO().WantCaptureMouse && (event.type == sf::Event::MouseButtonPressed) &&
                 (event.mouseButton.button == sf::Mouse::Button::Left))
             {
-                const Vector2f pointInWorld = camera.getWorldFromScreenCoordinates(
+                selectionClick = camera.getWorldFromScreenCoordinates(
                     FromSfml(window.getSize()), Vector2i(event.mouseButton.x, event.mouseButton.y));
-                input.selectedEnemy = FindEnemyByPosition(world, pointInWorld);
             }
         }
     }
@@ -107,10 +108,12 @@ namespace ij
     struct SfmlTextureManager final : TextureLoader
     {
         [[nodiscard]] std::optional<TextureId> LoadFromFile(const std::filesystem::path &textureFile) override;
-        const sf::Texture &GetTexture(const TextureId &id) const;
+        [[nodiscard]] TextureId Add(sf::Texture texture);
+        [[nodiscard]] sf::Texture &GetTexture(const TextureId &id);
+        [[nodiscard]] const sf::Texture &GetTexture(const TextureId &id) const;
 
     private:
-        std::vector<sf::Texture> _textures;
+        SlotMap<sf::Texture> _textures;
     };
 
     std::optional<TextureId> SfmlTextureManager::LoadFromFile(const std::filesystem::path &textureFile)
@@ -120,15 +123,22 @@ namespace ij
         {
             return std::nullopt;
         }
-        TextureId result{AssertCast<UInt32>(_textures.size())};
-        _textures.emplace_back(std::move(loading));
-        return result;
+        return Add(std::move(loading));
+    }
+
+    TextureId SfmlTextureManager::Add(sf::Texture texture)
+    {
+        return TextureId(_textures.Add(std::move(texture)));
+    }
+
+    sf::Texture &SfmlTextureManager::GetTexture(const TextureId &id)
+    {
+        return _textures.Get(id.Value);
     }
 
     const sf::Texture &SfmlTextureManager::GetTexture(const TextureId &id) const
     {
-        assert(id.Value < _textures.size());
-        return _textures[id.Value];
+        return _textures.Get(id.Value);
     }
 
     sf::Color ToSfml(const Color &value) noexcept
@@ -136,17 +146,58 @@ namespace ij
         return sf::Color(value.Red, value.Green, value.Blue, value.Alpha);
     }
 
-    struct SfmlCanvas final : Canvas
+    constexpr unsigned textCharacterSize = 14;
+
+    [[nodiscard]] AtlasGlyph ToAtlasGlyph(const sf::Glyph &glyph)
+    {
+        // sf::Text puts the base line at the character size below the top
+        const sf::IntRect &texture = glyph.textureRect;
+        return AtlasGlyph{Vector2u(AssertCast<UInt32>(texture.left), AssertCast<UInt32>(texture.top)),
+                          Vector2u(AssertCast<UInt32>(texture.width), AssertCast<UInt32>(texture.height)),
+                          Vector2f(glyph.bounds.left, (glyph.bounds.top + AssertCast<float>(textCharacterSize)))};
+    }
+
+    // The font keeps the glyphs of each size in one texture. Loading all of them at the start means that the texture
+    // does not change while the game runs and can be used as the atlas.
+    [[nodiscard]] GlyphAtlas LoadGlyphAtlas(const sf::Font &font)
+    {
+        GlyphAtlas atlas;
+        for (size_t i = 0; i < AtlasCharacterCount; ++i)
+        {
+            const sf::Uint32 character = AssertCast<sf::Uint32>(FirstAtlasCharacter + i);
+            const sf::Glyph &fill = font.getGlyph(character, textCharacterSize, false, 0);
+            atlas.Fills.push_back(ToAtlasGlyph(fill));
+            atlas.Advances.push_back(fill.advance);
+            atlas.Outlines.push_back(ToAtlasGlyph(font.getGlyph(character, textCharacterSize, false, 1)));
+        }
+        return atlas;
+    }
+
+    void ConvertVertices(const std::span<const TexturedVertex> from, std::vector<sf::Vertex> &to)
+    {
+        to.clear();
+        for (const TexturedVertex &vertex : from)
+        {
+            to.emplace_back(ToSfml(vertex.Position), ToSfml(vertex.VertexColor), ToSfml(vertex.TextureCoordinates));
+        }
+    }
+
+    // 16 chunks of 1024 by 1024 pixels, which covers a window of up to 3072 by 3072 pixels. The cache grows beyond
+    // this for a larger window because the chunks in the batch must not be replaced before the batch is flushed.
+    constexpr size_t tileChunkMemoryBudget = (64 * 1024 * 1024);
+
+    struct SfmlCanvas final : Canvas, TileChunkRenderer
     {
         sf::RenderWindow &Window;
         SfmlTextureManager &Textures;
-        std::vector<std::unique_ptr<sf::Text>> Texts;
         const sf::Font &Font0;
 
         explicit SfmlCanvas(sf::RenderWindow &window, SfmlTextureManager &textures, const sf::Font &font0)
             : Window(window)
             , Textures(textures)
             , Font0(font0)
+            , _glyphs(LoadGlyphAtlas(font0))
+            , _tileChunkCache(tileChunkMemoryBudget)
         {
         }
 
@@ -157,92 +208,162 @@ namespace ij
 
         void DrawDot(const Vector2i &position, const Color color) override
         {
-            sf::CircleShape circle(1);
-            circle.setOutlineColor(ToSfml(color));
-            circle.setFillColor(ToSfml(color));
-            circle.setPosition(sf::Vector2f(ToSfml(position)));
-            Window.draw(circle);
+            _batch.AddDot(position, color);
         }
 
         void DrawRectangle(const Vector2i &topLeft, const Vector2u &size, const Color outline, const Color fill,
                            float outlineThickness) override
         {
-            sf::RectangleShape rect;
-            rect.setPosition(sf::Vector2f(ToSfml(topLeft)));
-            rect.setSize(sf::Vector2f(ToSfml(size)));
-            rect.setFillColor(ToSfml(fill));
-            rect.setOutlineColor(ToSfml(outline));
-            rect.setOutlineThickness(outlineThickness);
-            Window.draw(rect);
+            _batch.AddRectangle(topLeft, size, outline, fill, outlineThickness);
         }
 
         void DrawSprite(const Sprite &sprite) override
         {
-            sf::Sprite sfmlSprite(Textures.GetTexture(sprite.Texture));
-            sfmlSprite.setPosition(ToSfml(AssertCastVector<float>(sprite.Position)));
-            sfmlSprite.setColor(ToSfml(sprite.ColorMultiplier));
-            sfmlSprite.setTextureRect(sf::IntRect(ToSfml(AssertCastVector<Int32>(sprite.TextureTopLeft)),
-                                                  ToSfml(AssertCastVector<Int32>(sprite.TextureSize))));
-            Window.draw(sfmlSprite);
+            _batch.AddSprite(sprite);
         }
 
-        [[nodiscard]] Text CreateText(const std::string &content, FontId font, const Vector2f &position,
+        [[nodiscard]] Text CreateText(const std::string_view content, FontId font, const Vector2f &position,
                                       Color fillColor, Color outlineColor, float outlineThickness) override
         {
             assert(font == 0);
-            auto instance = std::make_unique<sf::Text>(content, Font0, 14);
-            instance->setPosition(ToSfml(position));
-            instance->setFillColor(ToSfml(fillColor));
-            instance->setOutlineColor(ToSfml(outlineColor));
-            instance->setOutlineThickness(outlineThickness);
-            const auto foundEmptySlot = std::find(Texts.begin(), Texts.end(), nullptr);
-            if (foundEmptySlot == Texts.end())
-            {
-                const TextId id = Texts.size();
-                Texts.emplace_back(std::move(instance));
-                return Text(*this, id);
-            }
-            const TextId id = AssertCast<size_t>(std::distance(Texts.begin(), foundEmptySlot));
-            *foundEmptySlot = std::move(instance);
-            return Text(*this, id);
+            // the outlines in the atlas have a thickness of 1
+            (void)outlineThickness;
+            return Text(*this, _texts.Create(content, position, fillColor, outlineColor));
         }
 
         void SetTextPosition(TextId id, const Vector2f &position) override
         {
-            assert(id < Texts.size());
-            const auto &slot = Texts[id];
-            assert(slot);
-            slot->setPosition(ToSfml(position));
+            _texts.SetPosition(id, position);
         }
 
         Vector2f GetTextPosition(TextId id) override
         {
-            assert(id < Texts.size());
-            const auto &slot = Texts[id];
-            assert(slot);
-            return FromSfml(slot->getPosition());
+            return _texts.GetPosition(id);
         }
 
         void DeleteText(TextId id) override
         {
-            assert(id < Texts.size());
-            auto &slot = Texts[id];
-            assert(slot);
-            slot.reset();
+            _texts.Delete(id);
         }
 
         void DrawText(TextId id) override
         {
-            assert(id < Texts.size());
-            const auto &slot = Texts[id];
-            assert(slot);
-            Window.draw(*slot);
+            _texts.AppendVertices(id, _glyphs, _batch.Continue(BatchSource::Glyphs));
+        }
+
+        void Submit(const std::span<const DrawCommand> commands) override
+        {
+            SubmitOneByOne(*this, commands);
         }
 
         void SetView(const Rectangle<float> &view) override
         {
+            Flush();
             Window.setView(sf::View(ToSfml(view.Position + (view.Size / 2.0f)), ToSfml(view.Size)));
         }
+
+        // one draw call for each run of primitives with the same texture
+        void Flush() override
+        {
+            ConvertVertices(_batch.Vertices, _sfmlVertices);
+            for (size_t i = 0; i < _batch.Runs.size(); ++i)
+            {
+                const VertexRun &run = _batch.Runs[i];
+                const size_t end = _batch.GetRunEnd(i);
+                if (end == run.Begin)
+                {
+                    continue;
+                }
+                Window.draw((_sfmlVertices.data() + run.Begin), (end - run.Begin), sf::Triangles,
+                            getRenderStates(run));
+                ++_drawCalls;
+            }
+            _batch.Clear();
+            _tileChunkCache.StartFrame();
+        }
+
+        [[nodiscard]] UInt64 GetDrawCallCount() override
+        {
+            return _drawCalls;
+        }
+
+        [[nodiscard]] TileChunkRenderer *GetTileChunkRenderer() override
+        {
+            return this;
+        }
+
+        [[nodiscard]] bool DrawTileChunk(const std::span<const Tile, Map::TilesPerChunk> tiles,
+                                         const TextureId tileset, const Vector2i &topLeft) override
+        {
+            const TileChunkCache::Lookup lookup = _tileChunkCache.Find(tiles);
+            // the cache hands out the slots in order
+            if (lookup.Slot == _tileChunkTextures.size())
+            {
+                sf::Texture texture;
+                if (!texture.create(TileChunkPixels, TileChunkPixels))
+                {
+                    std::cerr << "Could not create a texture for a tile chunk\n";
+                }
+                _tileChunkTextures.push_back(Textures.Add(std::move(texture)));
+            }
+            const TextureId texture = _tileChunkTextures[lookup.Slot];
+            if (!lookup.IsCached)
+            {
+                drawTilesInto(tiles, tileset, Textures.GetTexture(texture));
+            }
+            _batch.AddSprite(Sprite(texture, topLeft, Color(255, 255, 255, 255), Vector2u(0, 0),
+                                    Vector2u(TileChunkPixels, TileChunkPixels)));
+            return lookup.IsCached;
+        }
+
+    private:
+        const GlyphAtlas _glyphs;
+        AtlasTexts _texts;
+        VertexBatch _batch;
+        std::vector<sf::Vertex> _sfmlVertices;
+        UInt64 _drawCalls = 0;
+        TileChunkCache _tileChunkCache;
+        // one per slot of the cache
+        std::vector<TextureId> _tileChunkTextures;
+        // created on first use; SFML can only draw into a RenderTexture, so the result is copied from here
+        std::unique_ptr<sf::RenderTexture> _tileChunkTarget;
+        std::vector<sf::Vertex> _tileChunkVertices;
+
+        void drawTilesInto(const std::span<const Tile, Map::TilesPerChunk> tiles, const TextureId tileset,
+                           sf::Texture &texture)
+        {
+            if (!_tileChunkTarget)
+            {
+                _tileChunkTarget = std::make_unique<sf::RenderTexture>();
+                if (!_tileChunkTarget->create(TileChunkPixels, TileChunkPixels))
+                {
+                    std::cerr << "Could not create a render texture for tile chunks\n";
+                }
+            }
+            VertexBatch batch;
+            AddTileSprites(tiles, tileset, batch);
+            ConvertVertices(batch.Vertices, _tileChunkVertices);
+            _tileChunkTarget->clear(sf::Color::Transparent);
+            _tileChunkTarget->draw(_tileChunkVertices.data(), _tileChunkVertices.size(), sf::Triangles,
+                                   sf::RenderStates(&Textures.GetTexture(tileset)));
+            _tileChunkTarget->display();
+            texture.update(_tileChunkTarget->getTexture());
+            ++_drawCalls;
+        }
+
+        [[nodiscard]] sf::RenderStates getRenderStates(const VertexRun &run) const
+        {
+            switch (run.Source)
+            {
+            case BatchSource::Color:
+                return sf::RenderStates::Default;
+            case BatchSource::Texture:
+                return sf::RenderStates(&Textures.GetTexture(run.Texture));
+            case BatchSource::Glyphs:
+                return sf::RenderStates(&Font0.getTexture(textCharacterSize));
+            }
+            IJ_UNREACHABLE();
+        }
     };
 
     struct SfmlWindowFunctions : WindowFunctions
@@ -257,9 +378,9 @@ namespace ij
             return _sfml.isOpen();
         }
 
-        void ProcessEvents(Input &input, const Camera &camera, World &world) override
+        void ProcessEvents(Input &input, const Camera &camera, std::optional<Vector2f> &selectionClick) override
         {
-            ij::ProcessEvents(input, _sfml, camera, world);
+            ij::ProcessEvents(input, _sfml, camera, selectionClick);
         }
 
         void UpdateGui(TimeSpan deltaTime) override
@@ -294,7 +415,7 @@ namespace ij
     };
 } // namespace ij
 
-int main()
+int main(int argc, char **argv)
 {
     using namespace ij;
     sf::RenderWindow window(sf::VideoMode(1200, 800), "Improved Journey");
@@ -318,7 +439,7 @@ int main()
     SfmlTextureManager textures;
     SfmlCanvas canvas{window, textures, font};
     SfmlWindowFunctions windowFunctions{window};
-    const bool success = RunGame(textures, canvas, assets, windowFunctions);
+    const bool success = RunGame(textures, canvas, assets, windowFunctions, ParseGameOptions(argc, argv));
     ImGui::SFML::Shutdown();
     return !success;
 }
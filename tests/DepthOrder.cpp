@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/DepthOrder.h>
+#include <ij/RandomNumberGenerator.h>
+#include <vector>
+
+namespace
+{
+    struct Object final
+    {
+        ij::UInt64 Id;
+        ij::Int32 Key;
+    };
+
+    [[nodiscard]] std::vector<ij::Int32> sortKeys(ij::DepthOrder &order, const std::vector<Object> &objects)
+    {
+        for (const Object &object : objects)
+        {
+            order.Add(object.Id, object.Key);
+        }
+        const std::span<const ij::UInt32> sorted = order.Sort();
+        REQUIRE(sorted.size() == objects.size());
+        std::vector<ij::UInt32> elements(sorted.begin(), sorted.end());
+        std::ranges::stable_sort(elements);
+        CHECK(std::ranges::adjacent_find(elements) == elements.end());
+        std::vector<ij::Int32> keys;
+        for (const ij::UInt32 element : sorted)
+        {
+            keys.push_back(objects[element].Key);
+        }
+        return keys;
+    }
+} // namespace
+
+TEST_CASE("DepthOrder sorts objects which move, appear and disappear", "[draw]")
+{
+    ij::StandardRandomNumberGenerator random(7);
+    std::vector<Object> objects;
+    for (ij::UInt64 i = 0; i < 500; ++i)
+    {
+        objects.push_back(Object{(i * 1'000'000), random.GenerateInt32(-1000, 1000)});
+    }
+    ij::DepthOrder order;
+    for (size_t frame = 0; frame < 100; ++frame)
+    {
+        const std::vector<ij::Int32> keys = sortKeys(order, objects);
+        CHECK(std::ranges::is_sorted(keys));
+        for (Object &object : objects)
+        {
+            // a few pixels per frame, and sometimes a jump
+            object.Key += ((frame % 25) == 24) ? random.GenerateInt32(-1000, 1000) : random.GenerateInt32(-3, 3);
+        }
+        if ((frame % 10) == 5)
+        {
+            // some leave the window and others enter it
+            objects.erase(objects.begin() + 100, objects.begin() + 110);
+            const ij::UInt64 id = ((objects[299].Id + objects[300].Id) / 2);
+            objects.insert(objects.begin() + 300, Object{id, random.GenerateInt32(-1000, 1000)});
+        }
+    }
+    CHECK(order.Statistics.Repairs > 0);
+    CHECK(order.Statistics.RadixSorts > 1);
+}
+
+TEST_CASE("DepthOrder keeps objects with the same key in the previous order", "[draw]")
+{
+    ij::DepthOrder order;
+    order.Add(1, 10);
+    order.Add(2, 20);
+    order.Add(3, 30);
+    std::span<const ij::UInt32> sorted = order.Sort();
+    CHECK(std::vector<ij::UInt32>(sorted.begin(), sorted.end()) == std::vector<ij::UInt32>{0, 1, 2});
+
+    // object 3 moves in front of object 1
+    order.Add(1, 10);
+    order.Add(2, 20);
+    order.Add(3, 5);
+    sorted = order.Sort();
+    CHECK(std::vector<ij::UInt32>(sorted.begin(), sorted.end()) == std::vector<ij::UInt32>{2, 0, 1});
+    CHECK(order.Statistics.MovesLastFrame == 2);
+
+    // and stays in front of it at the same key, although it was added later
+    order.Add(1, 10);
+    order.Add(2, 20);
+    order.Add(3, 10);
+    sorted = order.Sort();
+    CHECK(std::vector<ij::UInt32>(sorted.begin(), sorted.end()) == std::vector<ij::UInt32>{2, 0, 1});
+    CHECK(order.Statistics.RadixSorts == 1);
+    CHECK(order.Statistics.Repairs == 2);
+    CHECK(order.Statistics.MovesLastFrame == 0);
+}
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/FastRandomNumberGenerator.h>
+#include <vector>
+
+TEST_CASE("BatchRandomNumberGenerator fills with every number of the range", "[random]")
+{
+    ij::BatchRandomNumberGenerator random(5);
+    // not a multiple of the number of lanes
+    std::vector<ij::Int32> numbers(1001, -1);
+    random.FillInt32(numbers, -2, 3);
+    CHECK(std::ranges::all_of(numbers, [](const ij::Int32 number) { return (number >= -2) && (number <= 3); }));
+    for (ij::Int32 expected = -2; expected <= 3; ++expected)
+    {
+        CHECK(std::ranges::count(numbers, expected) > 100);
+    }
+}
+
+TEST_CASE("Fast random number generators only depend on the seed", "[random]")
+{
+    std::vector<ij::Int32> first(100);
+    std::vector<ij::Int32> second(100);
+    ij::BatchRandomNumberGenerator(7).FillInt32(first, 0, 1000);
+    ij::BatchRandomNumberGenerator(7).FillInt32(second, 0, 1000);
+    CHECK(first == second);
+
+    ij::Xoshiro256 a(7);
+    ij::Xoshiro256 b(7);
+    ij::Xoshiro256 c(8);
+    bool isDifferentFromOtherSeed = false;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const ij::UInt64 number = a.GenerateUInt64();
+        CHECK(number == b.GenerateUInt64());
+        isDifferentFromOtherSeed |= (number != c.GenerateUInt64());
+        const ij::Int32 bounded = a.GenerateInt32(10, 12);
+        CHECK(bounded >= 10);
+        CHECK(bounded <= 12);
+        (void)b.GenerateInt32(10, 12);
+    }
+    CHECK(isDifferentFromOtherSeed);
+}
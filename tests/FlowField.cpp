@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/World.h>
+
+namespace
+{
+    constexpr ij::Tile W = ij::NoTile;
+
+    // the center of a tile
+    [[nodiscard]] ij::Vector2f at(const float column, const float row)
+    {
+        return ij::Vector2f(((column + 0.5f) * ij::TileSize), ((row + 0.5f) * ij::TileSize));
+    }
+} // namespace
+
+TEST_CASE("FlowField leads around walls", "[flow]")
+{
+    // clang-format off
+    const std::array<ij::Tile, 6 * 4> tiles = {
+        0, 0, W, 0, 0, 0,
+        0, 0, W, 0, 0, 0,
+        0, 0, 0, 0, 0, W,
+        0, 0, W, 0, W, 0,
+    };
+    // clang-format on
+    const ij::Map map = ij::CreateMapFromTiles(6, 4, tiles);
+    const ij::WalkabilityMap walkability(map);
+    ij::FlowField field(5);
+    CHECK(!field.GetDirection(at(0, 0)));
+    CHECK(field.Update(walkability, at(4, 0)));
+    CHECK(!field.Update(walkability, (at(4, 0) + ij::Vector2f(10, -10))));
+
+    // through the gap in the wall, which takes two diagonal steps because corners can not be cut
+    CHECK(field.GetCost(at(0, 0)) == 68u);
+    const std::optional<ij::Vector2f> direction = field.GetDirection(at(0, 0));
+    REQUIRE(direction);
+    CHECK(direction->y > 0);
+    CHECK(field.GetCost(at(4, 0)) == 0u);
+    CHECK(!field.GetDirection(at(4, 0)));
+    // walled in
+    CHECK(!field.GetCost(at(5, 3)));
+    CHECK(!field.GetDirection(at(5, 3)));
+    // outside of the field
+    CHECK(!field.GetDirection(at(-2, 0)));
+
+    field.Invalidate();
+    CHECK(field.Update(walkability, at(4, 0)));
+    CHECK(field.Update(walkability, at(0, 3)));
+    CHECK(field.GetCost(at(0, 0)) == 30u);
+}
+
+TEST_CASE("Entities which follow a FlowField do not bump into walls", "[flow]")
+{
+    ij::StandardRandomNumberGenerator random(5);
+    const ij::World world(0, ij::GenerateRandomMap(random, 60, 60), 1);
+    ij::FlowField field(ij::GetFlowFieldRadius(ij::BotChaseDistance));
+    const ij::Vector2f goal = ij::GenerateRandomPointForSpawning(world, random);
+    REQUIRE(field.Update(world.Walkability, goal));
+    size_t reachable = 0;
+    size_t arrived = 0;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        ij::Vector2f position = ij::GenerateRandomPointForSpawning(world, random);
+        if (!field.GetCost(position))
+        {
+            continue;
+        }
+        ++reachable;
+        // far more steps than the longest path in the field needs
+        for (size_t step = 0; step < 10000; ++step)
+        {
+            const std::optional<ij::Vector2f> direction = field.GetDirection(position);
+            if (!direction)
+            {
+                ++arrived;
+                break;
+            }
+            REQUIRE(!ij::MoveWithCollisionDetection(position, true, (*direction * 2.0f), world));
+        }
+    }
+    CHECK(reachable > 0);
+    CHECK(arrived == reachable);
+}
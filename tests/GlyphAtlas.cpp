@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/GlyphAtlas.h>
+
+namespace
+{
+    // every glyph is a square of its index in size, next to each other in one row
+    [[nodiscard]] ij::GlyphAtlas createAtlas()
+    {
+        ij::GlyphAtlas atlas;
+        for (ij::UInt32 i = 0; i < ij::AtlasCharacterCount; ++i)
+        {
+            atlas.Fills.push_back(ij::AtlasGlyph{ij::Vector2u((i * 100), 0), ij::Vector2u(i, i), ij::Vector2f(0, 1)});
+            atlas.Outlines.push_back(
+                ij::AtlasGlyph{ij::Vector2u((i * 100), 100), ij::Vector2u(i, i), ij::Vector2f(-1, 0)});
+            atlas.Advances.push_back(10);
+        }
+        return atlas;
+    }
+} // namespace
+
+TEST_CASE("PackRectangles places rectangles without overlap", "[glyphs]")
+{
+    std::vector<ij::Vector2u> sizes;
+    for (ij::UInt32 i = 0; i < 50; ++i)
+    {
+        sizes.emplace_back((1 + ((i * 7) % 13)), (1 + ((i * 5) % 11)));
+    }
+    const ij::UInt32 width = 40;
+    const ij::PackedRectangles packed = ij::PackRectangles(sizes, width);
+    REQUIRE(packed.TopLeft.size() == sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        const ij::Vector2u &topLeft = packed.TopLeft[i];
+        CHECK((topLeft.x + sizes[i].x) < width);
+        CHECK((topLeft.y + sizes[i].y) < packed.Height);
+        for (size_t k = 0; k < i; ++k)
+        {
+            const ij::Vector2u &other = packed.TopLeft[k];
+            // including the gap of one pixel
+            const bool isApart = ((topLeft.x > (other.x + sizes[k].x)) || (other.x > (topLeft.x + sizes[i].x)) ||
+                                  (topLeft.y > (other.y + sizes[k].y)) || (other.y > (topLeft.y + sizes[i].y)));
+            CHECK(isApart);
+        }
+    }
+}
+
+TEST_CASE("AtlasTexts are drawn as quads from the atlas", "[glyphs]")
+{
+    const ij::GlyphAtlas atlas = createAtlas();
+    ij::AtlasTexts texts;
+    const ij::Color red(255, 0, 0, 255);
+    const ij::Color black(0, 0, 0, 255);
+    const ij::TextId first = texts.Create("12", ij::Vector2f(5, 7), red, black);
+    std::vector<ij::TexturedVertex> vertices;
+    texts.AppendVertices(first, atlas, vertices);
+    REQUIRE(vertices.size() == (4 * 6));
+    // the outlines come first so that the fills are drawn on top
+    CHECK(vertices[0].VertexColor.Red == 0);
+    CHECK(vertices[0].Position.x == 4);
+    CHECK(vertices[0].Position.y == 7);
+    CHECK(vertices[0].TextureCoordinates.x == (('1' - ij::FirstAtlasCharacter) * 100));
+    CHECK(vertices[0].TextureCoordinates.y == 100);
+    CHECK(vertices[6].Position.x == 14);
+    CHECK(vertices[12].VertexColor.Red == 255);
+    CHECK(vertices[12].Position.x == 5);
+    CHECK(vertices[12].Position.y == 8);
+    CHECK(vertices[12].TextureCoordinates.y == 0);
+    // the opposite corner of the last quad
+    const ij::UInt32 size = ('2' - ij::FirstAtlasCharacter);
+    CHECK(vertices.back().Position.x == (15 + size));
+    CHECK(vertices.back().TextureCoordinates.x == ((size * 100) + size));
+
+    // the space has no pixels, only an advance
+    vertices.clear();
+    texts.SetPosition(first, ij::Vector2f(0, 0));
+    CHECK(texts.GetPosition(first).x == 0);
+    const ij::TextId second = texts.Create(" 1\n", ij::Vector2f(0, 0), red, black);
+    CHECK(second != first);
+    texts.AppendVertices(second, atlas, vertices);
+    CHECK(vertices.size() == (4 * 6));
+
+    // slots are reused under a new generation and long texts are cut off
+    texts.Delete(first);
+    const ij::TextId third = texts.Create(std::string(100, '1'), ij::Vector2f(0, 0), red, black);
+    CHECK(third.Index == first.Index);
+    CHECK(third.Generation != first.Generation);
+    vertices.clear();
+    texts.AppendVertices(third, atlas, vertices);
+    CHECK(vertices.size() == (2 * ij::MaximumAtlasTextLength * 6));
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/Checksum.h>
+#include <ij/InputRecording.h>
+#include <ij/NullTextureLoader.h>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+    [[nodiscard]] ij::InputRecording createRecording()
+    {
+        ij::InputRecording recording{ij::GameSettings{123, 100, 80, 0.05f}, {}};
+        recording.Settings.TicksPerSecond = 30;
+        ij::RecordedInput input;
+        input.IsDirectionKeyPressed[1] = true;
+        recording.Runs.push_back(ij::InputRun{input, 100});
+        input.IsAttackPressed = true;
+        input.SelectedEnemy = 3;
+        recording.Runs.push_back(ij::InputRun{input, 50});
+        input.IsDirectionKeyPressed = {};
+        input.SelectedEnemy = std::nullopt;
+        input.LevelOfDetail.NearRadius = 700;
+        recording.Runs.push_back(ij::InputRun{input, 200});
+        return recording;
+    }
+
+    [[nodiscard]] std::vector<ij::UInt64> replay(const ij::InputRecording &recording, const size_t numberOfWorkers)
+    {
+        ij::NullTextureLoader textures;
+        const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+        REQUIRE(enemies);
+        ij::Game game(recording.Settings, *enemies, ij::TextureId(0));
+        ij::WorkerPool workers(numberOfWorkers);
+        std::vector<ij::UInt64> checksums;
+        ij::UInt64 checksum = ij::InitialChecksum;
+        ij::ReplayInputRecording(game, recording, workers, [&](const ij::UInt64 tick) {
+            if ((tick % 50) == 0)
+            {
+                checksum = ij::UpdateChecksum(checksum, game.SimulatedWorld, game.Player.Logic);
+                checksums.push_back(checksum);
+            }
+        });
+        return checksums;
+    }
+} // namespace
+
+TEST_CASE("InputRecorder merges equal ticks and ReadInputRecording restores them", "[input]")
+{
+    const ij::InputRecording original = createRecording();
+    std::stringstream stream;
+    {
+        ij::InputRecorder recorder(stream, original.Settings);
+        for (const ij::InputRun &run : original.Runs)
+        {
+            // frames with several ticks, frames with none
+            for (ij::UInt64 i = 0; i < run.Ticks; i += 2)
+            {
+                recorder.Record(run.Input, 0);
+                recorder.Record(run.Input, (std::min)(ij::UInt64(2), (run.Ticks - i)));
+            }
+        }
+    }
+    const std::optional<ij::InputRecording> read = ij::ReadInputRecording(stream);
+    REQUIRE(read);
+    CHECK(read->Settings.Seed == 123);
+    CHECK(read->Settings.MapWidth == 100);
+    CHECK(read->Settings.MapHeight == 80);
+    CHECK(read->Settings.EnemiesPerTile == 0.05f);
+    CHECK(!read->Settings.IsWorldInfinite);
+    CHECK(read->Settings.TicksPerSecond == 30);
+    REQUIRE(read->Runs.size() == original.Runs.size());
+    for (size_t i = 0; i < original.Runs.size(); ++i)
+    {
+        CHECK(read->Runs[i].Input == original.Runs[i].Input);
+        CHECK(read->Runs[i].Ticks == original.Runs[i].Ticks);
+    }
+    CHECK(read->GetNumberOfTicks() == 350);
+}
+
+TEST_CASE("ReadInputRecording rejects other files", "[input]")
+{
+    std::stringstream stream("not a recording");
+    CHECK(!ij::ReadInputRecording(stream));
+}
+
+TEST_CASE("ReadInputRecording rejects settings for which no map can be generated", "[input]")
+{
+    const auto isReadable = [](const ij::GameSettings &settings) -> bool {
+        std::stringstream stream;
+        {
+            ij::InputRecorder recorder(stream, settings);
+        }
+        return ij::ReadInputRecording(stream).has_value();
+    };
+    CHECK(isReadable(ij::GameSettings{1, 100, 80, 0.05f}));
+    CHECK(!isReadable(ij::GameSettings{1, 0, 80, 0.05f}));
+    CHECK(!isReadable(ij::GameSettings{1, 100, 0, 0.05f}));
+    CHECK(!isReadable(ij::GameSettings{1, (ij::Map::MaximumSideLength + 1), 80, 0.05f}));
+    CHECK(!isReadable(ij::GameSettings{1, 100, (ij::Map::MaximumSideLength + 1), 0.05f}));
+    CHECK(!isReadable(ij::GameSettings{1, 100, 80, -0.05f}));
+    CHECK(!isReadable(ij::GameSettings{1, 100, 80, 2.0f}));
+    CHECK(!isReadable(ij::GameSettings{1, 100, 80, std::numeric_limits<float>::quiet_NaN()}));
+    CHECK(!isReadable(ij::GameSettings{1, 100, 80, std::numeric_limits<float>::infinity()}));
+}
+
+TEST_CASE("Replaying an input recording is deterministic", "[input]")
+{
+    const ij::InputRecording recording = createRecording();
+    const std::vector<ij::UInt64> expected = replay(recording, 0);
+    CHECK(expected.size() == 7);
+    CHECK(replay(recording, 3) == expected);
+}
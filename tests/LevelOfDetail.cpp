@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <functional>
+#include <ij/LevelOfDetail.h>
+#include <ij/PlayerCharacter.h>
+
+namespace
+{
+    const ij::VisualEntity enemyVisuals(ij::TextureId(0), ij::Vector2u(64, 64), 4, ij::TimeSpan::FromMilliseconds(0),
+                                        &ij::cutEnemyTexture<4, 3>, ij::ObjectAnimation::Standing);
+
+    [[nodiscard]] ij::Map createMap(const size_t width, const size_t height,
+                                    const std::function<ij::Tile(size_t, size_t)> &getTile)
+    {
+        std::vector<ij::Tile> tiles;
+        for (size_t y = 0; y < height; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                tiles.push_back(getTile(x, y));
+            }
+        }
+        return ij::CreateMapFromTiles(width, height, tiles);
+    }
+} // namespace
+
+TEST_CASE("ChooseSimulationTier compares the distance to the player with both radii", "[world]")
+{
+    const ij::LevelOfDetailSettings settings;
+    const ij::Vector2f player(100, 100);
+    CHECK(ij::ChooseSimulationTier(settings, ij::Vector2f(100, 100), player) == ij::SimulationTier::Near);
+    CHECK(ij::ChooseSimulationTier(settings, ij::Vector2f(1100, 100), player) == ij::SimulationTier::Near);
+    CHECK(ij::ChooseSimulationTier(settings, ij::Vector2f(1101, 100), player) == ij::SimulationTier::Mid);
+    CHECK(ij::ChooseSimulationTier(settings, ij::Vector2f(100, -1900), player) == ij::SimulationTier::Mid);
+    CHECK(ij::ChooseSimulationTier(settings, ij::Vector2f(100, -1901), player) == ij::SimulationTier::Dormant);
+}
+
+TEST_CASE("Mid range enemies are updated after the same time at any tick rate", "[world]")
+{
+    const ij::LevelOfDetailSettings settings;
+    CHECK(ij::GetMidTickInterval(settings, ij::GetSimulationTimeStep(60)) == 4);
+    CHECK(ij::GetMidTickInterval(settings, ij::GetSimulationTimeStep(30)) == 2);
+    CHECK(ij::GetMidTickInterval(settings, ij::GetSimulationTimeStep(20)) == 1);
+    CHECK(ij::GetMidTickInterval(settings, ij::GetSimulationTimeStep(1000)) == 64);
+}
+
+TEST_CASE("Enemies are simulated according to their distance to the player", "[world]")
+{
+    ij::World world(0, createMap(200, 10, [](size_t, size_t) -> ij::Tile { return 0; }), 42);
+    const std::array<bool, 4> isDirectionKeyPressed = {};
+    bool isAttackPressed = false;
+    ij::LogicEntity player(std::make_unique<ij::PlayerCharacter>(isDirectionKeyPressed, isAttackPressed),
+                           ij::Vector2f(16, 160), ij::Vector2f(0, 0), false, false, 1000, 1000,
+                           ij::ObjectActivity::Standing);
+    constexpr size_t near = 0;
+    constexpr size_t mid = 1;
+    constexpr size_t dormant = 2;
+    ij::AddEnemy(world, enemyVisuals, ij::Vector2f(600, 160), ij::Vector2f(1, 0), 100, 100);
+    ij::AddEnemy(world, enemyVisuals, ij::Vector2f(1500, 160), ij::Vector2f(1, 0), 100, 100);
+    ij::AddEnemy(world, enemyVisuals, ij::Vector2f(3000, 160), ij::Vector2f(1, 0), 100, 100);
+    const ij::UInt64 interval = ij::GetMidTickInterval(world.LevelOfDetail, world.TimeStep);
+    REQUIRE(interval > 1);
+    ij::WorkerPool workers(0);
+    const ij::EnemyStore &enemies = world.enemies;
+    size_t midUpdates = 0;
+    for (size_t i = 0; i < (10 * interval); ++i)
+    {
+        const ij::UInt64 midTicksBefore = enemies.SimulatedTicks[mid];
+        ij::TimeSpan remaining = world.TimeStep;
+        ij::UpdateWorld(remaining, player, world, workers);
+        const ij::LevelOfDetailCounts &counts = world.LevelOfDetailCountsLastTick;
+        CHECK(counts.Near == 1);
+        CHECK(counts.Mid == 1);
+        CHECK(counts.Dormant == 1);
+        CHECK(counts.CaughtUp == 0);
+        CHECK(enemies.SimulatedTicks[near] == world.SimulatedTicks);
+        CHECK((world.SimulatedTicks - enemies.SimulatedTicks[mid]) < interval);
+        if (enemies.SimulatedTicks[mid] != midTicksBefore)
+        {
+            ++midUpdates;
+        }
+        CHECK(enemies.SimulatedTicks[dormant] == 0);
+    }
+    CHECK(midUpdates == 10);
+
+    // the dormant enemy wakes up when the player comes close
+    player.Position = ij::Vector2f(2900, 160);
+    ij::TimeSpan remaining = world.TimeStep;
+    ij::UpdateWorld(remaining, player, world, workers);
+    CHECK(world.LevelOfDetailCountsLastTick.CaughtUp == 1);
+    CHECK(enemies.SimulatedTicks[dormant] == world.SimulatedTicks);
+}
+
+TEST_CASE("Dormant enemies do not cross walls or gaps in the map while they catch up", "[world]")
+{
+    // an island of 3 by 3 tiles surrounded by a gap of one tile in the middle of a large walkable area
+    constexpr size_t islandBegin = 59;
+    constexpr size_t islandEnd = 62;
+    const auto isOnIsland = [](const size_t x, const size_t y) -> bool {
+        return (x >= islandBegin) && (x < islandEnd) && (y >= islandBegin) && (y < islandEnd);
+    };
+    const auto isInGap = [&isOnIsland](const size_t x, const size_t y) -> bool {
+        return !isOnIsland(x, y) && (x >= (islandBegin - 1)) && (x <= islandEnd) && (y >= (islandBegin - 1)) &&
+               (y <= islandEnd);
+    };
+    ij::World world(0, createMap(120, 120, [&isInGap](const size_t x, const size_t y) -> ij::Tile {
+                        return isInGap(x, y) ? ij::NoTile : 0;
+                    }),
+                    42);
+    const float center = ((islandBegin + 1.5f) * ij::TileSize);
+    for (size_t i = 0; i < 200; ++i)
+    {
+        ij::AddEnemy(world, enemyVisuals, ij::Vector2f(center, center), ij::Vector2f(1, 0), 100, 100);
+    }
+
+    ij::EnemyStore &enemies = world.enemies;
+    size_t bumps = 0;
+    for (size_t i = 0; i < enemies.GetCount(); ++i)
+    {
+        // from a second to ten minutes, which is far enough to jump over the gap many times
+        const ij::TimeSpan dormantTime = ij::TimeSpan::FromMilliseconds(ij::AssertCast<ij::Int64>(1000 + (i * 3000)));
+        ij::CounterBasedRandomNumberGenerator random(world.SimulationSeed, 0, i);
+        ij::CatchUpDormantEnemy(enemies, i, dormantTime, world, random);
+        const ij::Vector2f &position = enemies.Positions[i];
+        INFO("Enemy " << i << " at " << position.x << ", " << position.y);
+        CHECK(ij::IsWalkable(position, ij::DefaultEntityDimensions, world));
+        CHECK(isOnIsland(ij::AssertCast<size_t>(std::floor(position.x / ij::TileSize)),
+                         ij::AssertCast<size_t>(std::floor(position.y / ij::TileSize))));
+        if (enemies.HasBumpedIntoWall[i])
+        {
+            ++bumps;
+        }
+    }
+    // make sure that the test covers the interesting case
+    CHECK(bumps > 100);
+}
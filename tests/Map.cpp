@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/Map.h>
+
+TEST_CASE("CreateMapFromTiles keeps every tile", "[map]")
+{
+    // not a multiple of the chunk size
+    constexpr size_t width = 45;
+    constexpr size_t height = 70;
+    std::vector<ij::Tile> tiles(width * height);
+    for (size_t i = 0; i < tiles.size(); ++i)
+    {
+        tiles[i] = static_cast<ij::Tile>((i * 7) % 4);
+    }
+    const ij::Map map = ij::CreateMapFromTiles(width, height, tiles);
+    REQUIRE(map.Width == width);
+    REQUIRE(map.GetHeight() == height);
+    CHECK(map.GetNumberOfTiles() == tiles.size());
+    CHECK(map.GetWidthInChunks() == 2);
+    CHECK(map.GetHeightInChunks() == 3);
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            CHECK(map.GetTileAt(x, y) == tiles[(y * width) + x]);
+        }
+    }
+    // the part of the last chunk which is outside of the map
+    CHECK(map.GetChunk(1, 2)[(ij::Map::ChunkSize * 10) + 20] == ij::NoTile);
+}
+
+TEST_CASE("Uniform chunks share their storage", "[map]")
+{
+    constexpr size_t size = (ij::Map::ChunkSize * 4);
+    std::vector<ij::Tile> tiles(size * size, ij::NoTile);
+    // an island in the top left chunk
+    tiles[(5 * size) + 5] = 1;
+    // a chunk full of grass
+    for (size_t y = 0; y < ij::Map::ChunkSize; ++y)
+    {
+        for (size_t x = 0; x < ij::Map::ChunkSize; ++x)
+        {
+            tiles[((y + ij::Map::ChunkSize) * size) + x] = 2;
+        }
+    }
+    const ij::Map map = ij::CreateMapFromTiles(size, size, tiles);
+    CHECK(!map.IsChunkUniform(0, 0));
+    CHECK(map.IsChunkUniform(0, 1));
+    CHECK(map.IsChunkUniform(3, 3));
+    CHECK(map.GetTileAt(5, 5) == 1);
+    CHECK(map.GetTileAt(6, 5) == ij::NoTile);
+    CHECK(map.GetTileAt(0, ij::Map::ChunkSize) == 2);
+    CHECK(map.GetTileAt(size - 1, size - 1) == ij::NoTile);
+    // the island, the grass and the water
+    CHECK(map.GetChunkTiles().size() == (3 * ij::Map::TilesPerChunk));
+    CHECK(map.GetMemoryUsage() == ((3 * ij::Map::TilesPerChunk) + (16 * sizeof(ij::UInt32))));
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <ij/FastRandomNumberGenerator.h>
+#include <ij/MapFile.h>
+#include <sstream>
+
+namespace
+{
+    [[nodiscard]] std::filesystem::path writeTemporaryFile(const std::string &content)
+    {
+        const std::filesystem::path file = (std::filesystem::temp_directory_path() / "ij_test_map_file.ijmap");
+        std::ofstream output(file, std::ios::binary);
+        output.write(content.data(), ij::AssertCast<std::streamsize>(content.size()));
+        return file;
+    }
+} // namespace
+
+TEST_CASE("A saved map loads with the same tiles", "[map]")
+{
+    ij::FastRandomNumberGenerator random(1);
+    // not a multiple of the chunk size
+    const ij::Map original = ij::GenerateRandomMap(random, 100, 70);
+    std::stringstream stream;
+    REQUIRE(ij::WriteMapFile(stream, original));
+    const std::string content = stream.str();
+    CHECK((content.size() % ij::MapFileAlignment) == 0);
+    const std::filesystem::path file = writeTemporaryFile(content);
+    {
+        const std::optional<ij::Map> loaded = ij::LoadMapFile(file);
+        REQUIRE(loaded);
+        REQUIRE(loaded->Width == original.Width);
+        REQUIRE(loaded->GetHeight() == original.GetHeight());
+        for (size_t y = 0; y < original.GetHeight(); ++y)
+        {
+            for (size_t x = 0; x < original.Width; ++x)
+            {
+                CHECK(loaded->GetTileAt(x, y) == original.GetTileAt(x, y));
+            }
+        }
+        CHECK(loaded->IsChunkUniform(3, 2) == original.IsChunkUniform(3, 2));
+        CHECK(loaded->GetMemoryUsage() == original.GetMemoryUsage());
+    }
+    std::filesystem::remove(file);
+}
+
+TEST_CASE("LoadMapFile rejects broken files", "[map]")
+{
+    std::vector<ij::Tile> tiles(64 * 64, 1);
+    tiles[100] = ij::NoTile;
+    std::stringstream stream;
+    REQUIRE(ij::WriteMapFile(stream, ij::CreateMapFromTiles(64, 64, tiles)));
+    const std::string valid = stream.str();
+
+    SECTION("missing file")
+    {
+        CHECK(!ij::LoadMapFile(std::filesystem::temp_directory_path() / "ij_test_map_file_does_not_exist"));
+    }
+    SECTION("other file")
+    {
+        CHECK(!ij::LoadMapFile(writeTemporaryFile("not a map")));
+    }
+    SECTION("truncated")
+    {
+        CHECK(!ij::LoadMapFile(writeTemporaryFile(valid.substr(0, valid.size() - 1))));
+    }
+    SECTION("chunk index out of range")
+    {
+        std::string broken = valid;
+        // the first entry of the index
+        broken[40] = 100;
+        CHECK(!ij::LoadMapFile(writeTemporaryFile(broken)));
+    }
+    SECTION("unknown version")
+    {
+        std::string broken = valid;
+        broken[4] = 2;
+        CHECK(!ij::LoadMapFile(writeTemporaryFile(broken)));
+    }
+    std::filesystem::remove(std::filesystem::temp_directory_path() / "ij_test_map_file.ijmap");
+}
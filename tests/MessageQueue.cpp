@@ -0,0 +1,44 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/MessageQueue.h>
+#include <thread>
+
+TEST_CASE("MessageQueue keeps the order and refuses messages when it is full", "[threads]")
+{
+    ij::MessageQueue<int> queue(2);
+    CHECK(!queue.TryReceive());
+    CHECK(queue.TrySend(1));
+    CHECK(queue.TrySend(2));
+    CHECK(!queue.TrySend(3));
+    CHECK(queue.TryReceive() == 1);
+    CHECK(queue.TrySend(3));
+    CHECK(queue.TryReceive() == 2);
+    CHECK(queue.TryReceive() == 3);
+    CHECK(!queue.TryReceive());
+}
+
+TEST_CASE("MessageQueue passes every message from one thread to another", "[threads]")
+{
+    constexpr int messages = 100000;
+    ij::MessageQueue<int> queue(16);
+    std::thread sender([&queue]() {
+        for (int i = 0; i < messages;)
+        {
+            if (queue.TrySend(i))
+            {
+                ++i;
+            }
+        }
+    });
+    int expected = 0;
+    bool isInOrder = true;
+    while (expected < messages)
+    {
+        if (const std::optional<int> received = queue.TryReceive())
+        {
+            isInOrder = (isInOrder && (*received == expected));
+            ++expected;
+        }
+    }
+    sender.join();
+    CHECK(isInOrder);
+}
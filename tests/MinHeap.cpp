@@ -0,0 +1,30 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/MinHeap.h>
+#include <ij/RandomNumberGenerator.h>
+
+TEST_CASE("MinHeap gives out the smallest element first", "[pathfinding]")
+{
+    ij::StandardRandomNumberGenerator random(5);
+    ij::MinHeap<std::pair<ij::Int32, size_t>> heap;
+    for (size_t round = 0; round < 10; ++round)
+    {
+        for (size_t i = 0; i < 100; ++i)
+        {
+            heap.Push(std::make_pair(random.GenerateInt32(-50, 50), i));
+        }
+        // pushing and popping alternate like in a search
+        std::pair<ij::Int32, size_t> previous = heap.Pop();
+        for (size_t i = 1; i < 50; ++i)
+        {
+            const std::pair<ij::Int32, size_t> next = heap.Pop();
+            CHECK(!(next < previous));
+            previous = next;
+        }
+    }
+    size_t remaining = 0;
+    for (; !heap.IsEmpty(); ++remaining)
+    {
+        (void)heap.Pop();
+    }
+    CHECK(remaining == 500);
+}
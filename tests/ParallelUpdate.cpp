@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <ij/PlayerCharacter.h>
+
+namespace
+{
+    struct TestGame final
+    {
+        ij::World World;
+        std::array<bool, 4> IsDirectionKeyPressed = {};
+        bool IsAttackPressed = true;
+        ij::LogicEntity Player;
+        std::vector<ij::SimulationEvent> Events;
+        ij::UInt64 EventsConsumed = 0;
+
+        TestGame(const ij::Map &map, const size_t numberOfEnemies)
+            : World(0, map, 42)
+            , Player(std::make_unique<ij::PlayerCharacter>(IsDirectionKeyPressed, IsAttackPressed),
+                     ij::Vector2f(0, 0), ij::Vector2f(0, 0), false, false, 1000, 1000, ij::ObjectActivity::Standing)
+        {
+            ij::StandardRandomNumberGenerator random(7);
+            const ij::VisualEntity visuals(ij::TextureId(0), ij::Vector2u(64, 64), 4, ij::TimeSpan::FromMilliseconds(0),
+                                           &ij::cutEnemyTexture<4, 3>, ij::ObjectAnimation::Standing);
+            for (size_t i = 0; i < numberOfEnemies; ++i)
+            {
+                ij::AddEnemy(World, visuals, ij::GenerateRandomPointForSpawning(World, random),
+                             ij::Vector2f(1, 0), 100, 100);
+            }
+            // stand in the middle of some enemies so that there is fighting
+            Player.Position = World.enemies.Positions[numberOfEnemies / 2];
+        }
+
+        void Update(ij::WorkerPool &workers)
+        {
+            ij::TimeSpan remaining = ij::TimeSpan::FromMilliseconds(1000 / ij::FrameRate);
+            ij::UpdateWorld(remaining, Player, World, workers);
+            REQUIRE(World.Events.Consume(EventsConsumed, [this](const ij::SimulationEvent &event) {
+                Events.push_back(event);
+            }) == 0);
+        }
+    };
+
+    template <class T>
+    [[nodiscard]] bool areBitIdentical(const std::vector<T> &first, const std::vector<T> &second)
+    {
+        return (first.size() == second.size()) &&
+               (std::memcmp(first.data(), second.data(), first.size() * sizeof(T)) == 0);
+    }
+} // namespace
+
+TEST_CASE("Parallel and single threaded simulation produce identical worlds", "[world]")
+{
+    ij::StandardRandomNumberGenerator random(3);
+    const ij::Map map = ij::GenerateRandomMap(random);
+    TestGame singleThreaded(map, 5000);
+    TestGame parallel(map, 5000);
+    ij::WorkerPool noWorkers(0);
+    ij::WorkerPool workers(3);
+    for (size_t i = 0; i < 600; ++i)
+    {
+        // kill the enemies close by, then let the others come and attack
+        singleThreaded.IsAttackPressed = parallel.IsAttackPressed = (i < 60);
+        singleThreaded.Update(noWorkers);
+        parallel.Update(workers);
+    }
+    const ij::EnemyStore &expected = singleThreaded.World.enemies;
+    const ij::EnemyStore &actual = parallel.World.enemies;
+    CHECK(areBitIdentical(expected.Positions, actual.Positions));
+    CHECK(areBitIdentical(expected.Directions, actual.Directions));
+    CHECK(areBitIdentical(expected.CurrentHealth, actual.CurrentHealth));
+    CHECK(areBitIdentical(expected.Activities, actual.Activities));
+    CHECK(singleThreaded.Player.GetCurrentHealth() == parallel.Player.GetCurrentHealth());
+    // make sure that the test covers the interesting cases
+    CHECK(singleThreaded.Player.GetCurrentHealth() < 1000);
+    CHECK(std::ranges::count(expected.CurrentHealth, 0) > 0);
+
+    REQUIRE(singleThreaded.Events.size() == parallel.Events.size());
+    ij::SimulationEventCounts counts;
+    for (size_t i = 0; i < singleThreaded.Events.size(); ++i)
+    {
+        const ij::SimulationEvent &expectedEvent = singleThreaded.Events[i];
+        const ij::SimulationEvent &actualEvent = parallel.Events[i];
+        CHECK(expectedEvent.Type == actualEvent.Type);
+        CHECK(expectedEvent.Entity == actualEvent.Entity);
+        CHECK(expectedEvent.Amount == actualEvent.Amount);
+        CHECK(expectedEvent.Tick == actualEvent.Tick);
+        counts.Add(expectedEvent);
+    }
+    CHECK(counts.Damage > 0);
+    CHECK(counts.Deaths > 0);
+    CHECK(counts.AttacksStarted > 0);
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/PathFinder.h>
+#include <ij/RandomNumberGenerator.h>
+
+namespace
+{
+    [[nodiscard]] bool isNextTo(const ij::TilePosition &first, const ij::TilePosition &second)
+    {
+        const auto distance = [](const ij::UInt32 from, const ij::UInt32 to) {
+            return ((from > to) ? (from - to) : (to - from));
+        };
+        const ij::UInt32 x = distance(first.x, second.x);
+        const ij::UInt32 y = distance(first.y, second.y);
+        return (x <= 1) && (y <= 1) && ((x + y) > 0);
+    }
+
+    // a map of three chunks side by side with walls between them which have a single gap each
+    [[nodiscard]] ij::Map createWalledMap()
+    {
+        constexpr size_t width = (3 * ij::Map::ChunkSize);
+        constexpr size_t height = ij::Map::ChunkSize;
+        std::vector<ij::Tile> tiles(width * height, 0);
+        for (size_t y = 0; y < height; ++y)
+        {
+            if (y != 3)
+            {
+                tiles[(y * width) + 31] = ij::NoTile;
+            }
+            if (y != 28)
+            {
+                tiles[(y * width) + 64] = ij::NoTile;
+            }
+        }
+        // a room in the last chunk which can not be entered
+        for (size_t x = 80; x < 85; ++x)
+        {
+            tiles[(10 * width) + x] = ij::NoTile;
+            tiles[(14 * width) + x] = ij::NoTile;
+        }
+        for (size_t y = 10; y < 15; ++y)
+        {
+            tiles[(y * width) + 80] = ij::NoTile;
+            tiles[(y * width) + 84] = ij::NoTile;
+        }
+        return ij::CreateMapFromTiles(width, height, tiles);
+    }
+} // namespace
+
+TEST_CASE("PathFinder finds paths through the gaps in walls", "[path]")
+{
+    ij::PathFinder finder(createWalledMap(), 10);
+    // two entrances with a node on either side
+    CHECK(finder.GetNumberOfNodes() == 4);
+
+    const ij::TilePosition start(2, 30);
+    const ij::TilePosition goal(90, 2);
+    const ij::FoundPath found = finder.FindPath(start, goal);
+    REQUIRE(found.IsFound);
+    REQUIRE(found.Waypoints.size() == 6);
+    CHECK(found.Waypoints[1].x == 31);
+    CHECK(found.Waypoints[1].y == 3);
+    CHECK(found.Waypoints[4].x == 64);
+    CHECK(found.Waypoints[4].y == 28);
+
+    // every step of the refined path is walkable and next to the one before
+    ij::TilePosition previous = start;
+    for (size_t i = 1; i < found.Waypoints.size(); ++i)
+    {
+        const std::vector<ij::TilePosition> tiles = finder.RefineSegment(found.Waypoints[i - 1], found.Waypoints[i]);
+        REQUIRE(!tiles.empty());
+        for (const ij::TilePosition &tile : tiles)
+        {
+            CHECK(isNextTo(previous, tile));
+            previous = tile;
+        }
+    }
+    CHECK(previous.x == goal.x);
+    CHECK(previous.y == goal.y);
+
+    CHECK(!finder.FindPath(start, ij::TilePosition(82, 12)).IsFound);
+    CHECK(!finder.FindPath(start, ij::TilePosition(31, 0)).IsFound);
+    const ij::FoundPath same = finder.FindPath(start, start);
+    CHECK(same.IsFound);
+    CHECK(same.Waypoints.size() == 1);
+    const ij::FoundPath withinChunk = finder.FindPath(start, ij::TilePosition(20, 1));
+    CHECK(withinChunk.IsFound);
+    CHECK(withinChunk.Waypoints.size() == 2);
+
+    // another start and goal in the same chunks
+    const size_t cacheHits = finder.Statistics.CacheHits;
+    const ij::FoundPath cached = finder.FindPath(ij::TilePosition(5, 5), ij::TilePosition(80, 30));
+    CHECK(cached.IsFound);
+    CHECK(cached.Waypoints.size() == 6);
+    CHECK(finder.Statistics.CacheHits == (cacheHits + 1));
+}
+
+TEST_CASE("PathFinder answers requests over several calls like a search at once", "[path]")
+{
+    ij::StandardRandomNumberGenerator random(7);
+    const ij::Map map = ij::GenerateRandomMap(random, 200, 200);
+    ij::PathFinder immediate(map, 0);
+    ij::PathFinder spread(map, 0);
+    std::vector<std::pair<ij::TilePosition, ij::TilePosition>> queries;
+    std::vector<ij::PathRequestId> requests;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const auto randomTile = [&random]() {
+            return ij::TilePosition(ij::AssertCast<ij::UInt32>(random.GenerateSize(0, 199)),
+                                    ij::AssertCast<ij::UInt32>(random.GenerateSize(0, 199)));
+        };
+        queries.emplace_back(randomTile(), randomTile());
+        requests.push_back(spread.RequestPath(queries.back().first, queries.back().second));
+    }
+    CHECK(!spread.TakeResult(requests.front()));
+
+    size_t calls = 0;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        std::optional<ij::FoundPath> result;
+        while (!result)
+        {
+            spread.ProcessRequests(20);
+            ++calls;
+            result = spread.TakeResult(requests[i]);
+        }
+        CHECK(!spread.TakeResult(requests[i]));
+        const ij::FoundPath expected = immediate.FindPath(queries[i].first, queries[i].second);
+        REQUIRE(result->IsFound == expected.IsFound);
+        REQUIRE(result->Waypoints.size() == expected.Waypoints.size());
+        for (size_t k = 0; k < expected.Waypoints.size(); ++k)
+        {
+            CHECK(result->Waypoints[k].x == expected.Waypoints[k].x);
+            CHECK(result->Waypoints[k].y == expected.Waypoints[k].y);
+        }
+    }
+    CHECK(calls > queries.size());
+    CHECK(spread.Statistics.Searches == queries.size());
+}
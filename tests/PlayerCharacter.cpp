@@ -0,0 +1,32 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/PlayerCharacter.h>
+
+namespace
+{
+    [[nodiscard]] ij::Health attackForOneSecond(const unsigned ticksPerSecond)
+    {
+        const std::array<ij::Tile, 100> tiles = {};
+        ij::World world(0, ij::CreateMapFromTiles(10, 10, tiles), 42);
+        world.TimeStep = ij::GetSimulationTimeStep(ticksPerSecond);
+        const std::array<bool, 4> isDirectionKeyPressed = {};
+        bool isAttackPressed = true;
+        ij::LogicEntity player(std::make_unique<ij::PlayerCharacter>(isDirectionKeyPressed, isAttackPressed),
+                               ij::Vector2f(160, 160), ij::Vector2f(0, 0), false, false, 1000, 1000,
+                               ij::ObjectActivity::Standing);
+        const ij::VisualEntity visuals(ij::TextureId(0), ij::Vector2u(64, 64), 4, ij::TimeSpan::FromMilliseconds(0),
+                                       &ij::cutEnemyTexture<4, 3>, ij::ObjectAnimation::Standing);
+        ij::AddEnemy(world, visuals, ij::Vector2f(200, 160), ij::Vector2f(1, 0), 1000, 1000);
+        ij::WorkerPool workers(0);
+        ij::TimeSpan remaining = ij::TimeSpan::FromMilliseconds(1000);
+        ij::UpdateWorld(remaining, player, world, workers);
+        return (1000 - world.enemies.CurrentHealth[0]);
+    }
+} // namespace
+
+TEST_CASE("The player deals the same damage per second at any tick rate", "[world]")
+{
+    const ij::Health damageAt20 = attackForOneSecond(20);
+    const ij::Health damageAt60 = attackForOneSecond(60);
+    CHECK(damageAt20 == 120);
+    CHECK(damageAt60 == damageAt20);
+}
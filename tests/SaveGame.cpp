@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/Checksum.h>
+#include <ij/NullTextureLoader.h>
+#include <ij/SaveGame.h>
+#include <sqlite3.h>
+
+namespace
+{
+    [[nodiscard]] std::filesystem::path getEmptySaveGameFile()
+    {
+        const std::filesystem::path file = (std::filesystem::temp_directory_path() / "ij_test_save_game.sqlite");
+        for (const char *const suffix : {"", "-wal", "-shm"})
+        {
+            std::filesystem::remove(file.string() + suffix);
+        }
+        return file;
+    }
+
+    [[nodiscard]] ij::UInt64 simulate(ij::Game &game, const ij::UInt64 ticks, ij::WorkerPool &workers)
+    {
+        ij::TimeSpan remainingSimulationTime = ij::TimeSpan::FromMilliseconds(
+            game.SimulatedWorld.TimeStep.Milliseconds * ij::AssertCast<ij::Int64>(ticks));
+        ij::UpdateGame(game, remainingSimulationTime, workers);
+        return ij::UpdateChecksum(ij::InitialChecksum, game.SimulatedWorld, game.Player.Logic);
+    }
+} // namespace
+
+TEST_CASE("Only enemies which changed since the last snapshot are saved again", "[save]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    // large enough for dormant enemies
+    ij::Game game(ij::GameSettings{7, 200, 200, 0.05f}, *enemies, ij::TextureId(0));
+    const size_t count = game.SimulatedWorld.enemies.GetCount();
+    CHECK(ij::TakeSaveGameSnapshot(game).Enemies.size() == count);
+    CHECK(ij::TakeSaveGameSnapshot(game).Enemies.empty());
+
+    ij::WorkerPool workers(0);
+    (void)simulate(game, 1, workers);
+    const ij::SaveGameSnapshot snapshot = ij::TakeSaveGameSnapshot(game);
+    CHECK(!snapshot.Enemies.empty());
+    CHECK(snapshot.Enemies.size() < count);
+    CHECK(snapshot.Enemies.size() <=
+          (game.SimulatedWorld.LevelOfDetailCountsLastTick.Near + game.SimulatedWorld.LevelOfDetailCountsLastTick.Mid));
+}
+
+TEST_CASE("A loaded game continues exactly like the saved one", "[save]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    const std::filesystem::path file = getEmptySaveGameFile();
+    CHECK(!ij::ReadSaveGame(file));
+
+    ij::GameSettings settings{7, 100, 80, 0.05f};
+    // not the default, which the loaded game would silently use otherwise
+    settings.TicksPerSecond = 20;
+    ij::Game original(settings, *enemies, ij::TextureId(0));
+    original.CurrentInput.isDirectionKeyPressed[1] = true;
+    original.CurrentInput.isAttackPressed = true;
+    ij::WorkerPool workers(0);
+    {
+        const std::unique_ptr<ij::SaveGameWriter> writer = ij::OpenSaveGame(file);
+        REQUIRE(writer);
+        // several saves so that the later ones only contain some of the enemies
+        for (int i = 0; i < 5; ++i)
+        {
+            (void)simulate(original, 30, workers);
+            writer->Submit(ij::TakeSaveGameSnapshot(original));
+        }
+        writer->WaitUntilWritten();
+        const ij::SaveGameStatistics statistics = writer->GetStatistics();
+        CHECK(statistics.SnapshotsWritten == 5);
+        CHECK(!statistics.HasFailed);
+    }
+
+    const std::optional<ij::SaveGameSnapshot> snapshot = ij::ReadSaveGame(file);
+    REQUIRE(snapshot);
+    CHECK(snapshot->Settings.Seed == settings.Seed);
+    CHECK(snapshot->Settings.TicksPerSecond == settings.TicksPerSecond);
+    CHECK(snapshot->SimulatedTicks == 150);
+    ij::Game loaded(snapshot->Settings, *enemies, ij::TextureId(0));
+    REQUIRE(ij::RestoreSaveGame(loaded, *snapshot));
+    loaded.CurrentInput = original.CurrentInput;
+    CHECK(ij::UpdateChecksum(ij::InitialChecksum, loaded.SimulatedWorld, loaded.Player.Logic) ==
+          ij::UpdateChecksum(ij::InitialChecksum, original.SimulatedWorld, original.Player.Logic));
+    CHECK(simulate(loaded, 200, workers) == simulate(original, 200, workers));
+
+    // a game with different settings does not fit
+    ij::Game other(ij::GameSettings{8, 100, 80, 0.05f}, *enemies, ij::TextureId(0));
+    CHECK(!ij::RestoreSaveGame(other, *snapshot));
+}
+
+TEST_CASE("Snapshots of a failed transaction are written with the next one", "[save]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    const std::filesystem::path file = getEmptySaveGameFile();
+    ij::Game game(ij::GameSettings{7, 100, 80, 0.05f}, *enemies, ij::TextureId(0));
+    ij::WorkerPool workers(0);
+    const std::unique_ptr<ij::SaveGameWriter> writer = ij::OpenSaveGame(file);
+    REQUIRE(writer);
+
+    // another connection holds the write lock, so the first snapshot with all the enemies can not be written
+    sqlite3 *lock = nullptr;
+    REQUIRE(sqlite3_open(file.string().c_str(), &lock) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(lock, "BEGIN IMMEDIATE", nullptr, nullptr, nullptr) == SQLITE_OK);
+    writer->Submit(ij::TakeSaveGameSnapshot(game));
+    writer->WaitUntilWritten();
+    ij::SaveGameStatistics statistics = writer->GetStatistics();
+    CHECK(statistics.HasFailed);
+    CHECK(statistics.FailedTransactions == 1);
+    CHECK(statistics.SnapshotsWritten == 0);
+    CHECK(sqlite3_exec(lock, "ROLLBACK", nullptr, nullptr, nullptr) == SQLITE_OK);
+    CHECK(sqlite3_close(lock) == SQLITE_OK);
+
+    // the second snapshot only has the enemies which changed in the meantime
+    const ij::UInt64 checksum = simulate(game, 30, workers);
+    const ij::SaveGameSnapshot second = ij::TakeSaveGameSnapshot(game);
+    CHECK(second.Enemies.size() < game.SimulatedWorld.enemies.GetCount());
+    writer->Submit(second);
+    writer->WaitUntilWritten();
+    statistics = writer->GetStatistics();
+    CHECK(!statistics.HasFailed);
+    CHECK(statistics.SnapshotsWritten == 2);
+
+    const std::optional<ij::SaveGameSnapshot> snapshot = ij::ReadSaveGame(file);
+    REQUIRE(snapshot);
+    ij::Game loaded(snapshot->Settings, *enemies, ij::TextureId(0));
+    REQUIRE(ij::RestoreSaveGame(loaded, *snapshot));
+    CHECK(ij::UpdateChecksum(ij::InitialChecksum, loaded.SimulatedWorld, loaded.Player.Logic) == checksum);
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/SimulationClock.h>
+#include <ij/World.h>
+
+TEST_CASE("SimulationClock limits the ticks per frame", "[clock]")
+{
+    const ij::Int64 step = ij::GetSimulationTimeStep(ij::FrameRate).Milliseconds;
+    ij::SimulationClock clock(ij::TimeSpan::FromMilliseconds(step));
+    clock.Policy.MaximumTicksPerFrame = 3;
+
+    SECTION("dropping the excess time")
+    {
+        CHECK(clock.Advance(ij::TimeSpan::FromMilliseconds((10 * step) + 1)).Milliseconds == (3 * step));
+        CHECK(clock.Statistics.TicksDropped == 7);
+        // the fraction of a tick is kept
+        CHECK(clock.Advance(ij::TimeSpan::FromMilliseconds(step - 1)).Milliseconds == step);
+        CHECK(clock.Statistics.TicksRun == 4);
+    }
+
+    SECTION("catching up later")
+    {
+        clock.Policy.IsDroppingExcessTime = false;
+        CHECK(clock.Advance(ij::TimeSpan::FromMilliseconds(5 * step)).Milliseconds == (3 * step));
+        CHECK(clock.Advance(ij::TimeSpan::FromMilliseconds(0)).Milliseconds == (2 * step));
+        CHECK(clock.Statistics.TicksDropped == 0);
+        CHECK(clock.Statistics.TicksRun == 5);
+    }
+
+    CHECK(clock.Statistics.WorstBacklog.Milliseconds >= (5 * step));
+}
+
+TEST_CASE("SimulationClock scales the time", "[clock]")
+{
+    const ij::Int64 step = ij::GetSimulationTimeStep(ij::FrameRate).Milliseconds;
+    ij::SimulationClock clock(ij::TimeSpan::FromMilliseconds(step));
+    clock.Policy.TimeScale = 0.25f;
+    ij::Int64 simulated = 0;
+    for (size_t i = 0; i < 400; ++i)
+    {
+        simulated += clock.Advance(ij::TimeSpan::FromMilliseconds(step)).Milliseconds;
+    }
+    CHECK(simulated == (100 * step));
+}
+
+TEST_CASE("SimulationClock tells how far the present is between two ticks", "[clock]")
+{
+    const ij::Int64 step = ij::GetSimulationTimeStep(20).Milliseconds;
+    REQUIRE(step == 50);
+    ij::SimulationClock clock(ij::TimeSpan::FromMilliseconds(step));
+    CHECK(clock.GetInterpolation() == 0.0f);
+    CHECK(clock.Advance(ij::TimeSpan::FromMilliseconds(20)).Milliseconds == 0);
+    CHECK(clock.GetInterpolation() == 0.4f);
+    CHECK(clock.Advance(ij::TimeSpan::FromMilliseconds(55)).Milliseconds == step);
+    CHECK(clock.GetInterpolation() == 0.5f);
+
+    clock.Policy.IsDroppingExcessTime = false;
+    clock.Policy.MaximumTicksPerFrame = 1;
+    CHECK(clock.Advance(ij::TimeSpan::FromMilliseconds(3 * step)).Milliseconds == step);
+    CHECK(clock.GetInterpolation() == 1.0f);
+}
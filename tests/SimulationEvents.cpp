@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/SimulationEvents.h>
+
+namespace
+{
+    [[nodiscard]] ij::SimulationEvent createDamage(const ij::Health amount)
+    {
+        return ij::SimulationEvent{ij::SimulationEventType::Damage, 0, ij::Vector2f(0, 0), amount, 0};
+    }
+} // namespace
+
+TEST_CASE("Every consumer of the SimulationEventQueue reads each event once", "[events]")
+{
+    ij::SimulationEventQueue queue(4);
+    ij::UInt64 often = 0;
+    ij::UInt64 rarely = 0;
+    std::vector<ij::Health> readOften;
+    std::vector<ij::Health> readRarely;
+    const auto readInto = [](std::vector<ij::Health> &read) {
+        return [&read](const ij::SimulationEvent &event) { read.push_back(event.Amount); };
+    };
+
+    queue.Push(createDamage(1));
+    queue.Push(createDamage(2));
+    CHECK(queue.Consume(often, readInto(readOften)) == 0);
+    CHECK(readOften == std::vector<ij::Health>{1, 2});
+    CHECK(queue.Consume(often, readInto(readOften)) == 0);
+    CHECK(readOften.size() == 2);
+
+    // the two oldest are overwritten before the second consumer gets to them
+    for (ij::Health i = 3; i <= 6; ++i)
+    {
+        queue.Push(createDamage(i));
+    }
+    CHECK(queue.GetEnd() == 6);
+    CHECK(queue.Consume(often, readInto(readOften)) == 0);
+    CHECK(readOften == std::vector<ij::Health>{1, 2, 3, 4, 5, 6});
+    CHECK(queue.Consume(rarely, readInto(readRarely)) == 2);
+    CHECK(readRarely == std::vector<ij::Health>{3, 4, 5, 6});
+    CHECK(rarely == queue.GetEnd());
+}
+
+TEST_CASE("A copy of the SimulationEventQueue can be kept up to date with the new events only", "[events]")
+{
+    ij::SimulationEventQueue source(4);
+    source.Push(createDamage(1));
+    ij::SimulationEventQueue copy = source;
+    source.Push(createDamage(2));
+    source.Push(createDamage(3));
+    copy.CopyNewEvents(source);
+    ij::UInt64 position = 0;
+    std::vector<ij::Health> read;
+    CHECK(copy.Consume(position, [&read](const ij::SimulationEvent &event) { read.push_back(event.Amount); }) == 0);
+    CHECK(read == std::vector<ij::Health>{1, 2, 3});
+
+    // more new events than fit into the queue
+    for (ij::Health i = 4; i <= 9; ++i)
+    {
+        source.Push(createDamage(i));
+    }
+    copy.CopyNewEvents(source);
+    CHECK(copy.GetEnd() == source.GetEnd());
+    read.clear();
+    CHECK(copy.Consume(position, [&read](const ij::SimulationEvent &event) { read.push_back(event.Amount); }) == 2);
+    CHECK(read == std::vector<ij::Health>{6, 7, 8, 9});
+}
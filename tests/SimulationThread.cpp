@@ -0,0 +1,34 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <ij/NullTextureLoader.h>
+#include <ij/SimulationThread.h>
+#include <thread>
+
+TEST_CASE("SimulationThread runs the game and publishes snapshots of it", "[threads]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    ij::Game game(ij::GameSettings{123, 100, 80, 0.05f}, *enemies, ij::TextureId(0));
+    const ij::Vector2f start = game.Player.Logic.Position;
+    const ij::SimulationClock clock(game.SimulatedWorld.TimeStep);
+    ij::InputMessage input{{}, false, false, std::nullopt, ij::Vector2u(800, 600),
+                           ij::GetSimulationControls(game, clock)};
+    input.IsDirectionKeyPressed[1] = true;
+    ij::WorkerPool workers(1);
+    {
+        ij::SimulationThread simulation(game, workers, nullptr, input);
+        const auto giveUp = (std::chrono::steady_clock::now() + std::chrono::seconds(10));
+        while ((simulation.GetLatestSnapshot().SimulatedTicks < 10) && (std::chrono::steady_clock::now() < giveUp))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        const ij::RenderSnapshot &snapshot = simulation.GetLatestSnapshot();
+        REQUIRE(snapshot.SimulatedTicks >= 10);
+        CHECK(snapshot.NumberOfEnemies > 0);
+        CHECK(!snapshot.SelectedEnemy);
+    }
+    // the thread has stopped, so the game can be read again
+    CHECK(game.SimulatedWorld.SimulatedTicks >= 10);
+    CHECK(((game.Player.Logic.Position.x != start.x) || (game.Player.Logic.Position.y != start.y)));
+}
@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/SlotMap.h>
+#include <string>
+
+TEST_CASE("SlotMap detects handles of removed values", "[slots]")
+{
+    ij::SlotMap<std::string> map;
+    const ij::SlotHandle first = map.Add("first");
+    const ij::SlotHandle second = map.Add("second");
+    CHECK(map.Contains(first));
+    CHECK(map.Get(second) == "second");
+
+    map.Remove(first);
+    CHECK(!map.Contains(first));
+    CHECK(map.Get(second) == "second");
+
+    // the slot is reused, but the old handle stays invalid
+    const ij::SlotHandle third = map.Add("third");
+    CHECK(third.Index == first.Index);
+    CHECK(third.Generation != first.Generation);
+    CHECK(!map.Contains(first));
+    CHECK(map.Get(third) == "third");
+}
+
+TEST_CASE("SlotMap keeps its values without gaps", "[slots]")
+{
+    ij::SlotMap<int> map;
+    std::vector<ij::SlotHandle> handles;
+    for (int i = 0; i < 10; ++i)
+    {
+        handles.push_back(map.Add(i));
+    }
+    for (size_t i = 0; i < handles.size(); i += 3)
+    {
+        map.Remove(handles[i]);
+    }
+    REQUIRE(map.GetSize() == 6);
+    std::vector<int> values(map.GetValues().begin(), map.GetValues().end());
+    std::ranges::stable_sort(values);
+    CHECK(values == std::vector<int>{1, 2, 4, 5, 7, 8});
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        CHECK(map.Contains(handles[i]) == ((i % 3) != 0));
+        if (map.Contains(handles[i]))
+        {
+            CHECK(map.Get(handles[i]) == static_cast<int>(i));
+        }
+    }
+}
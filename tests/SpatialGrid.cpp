@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/SpatialGrid.h>
+
+namespace
+{
+    [[nodiscard]] std::vector<size_t> findCandidates(const ij::SpatialGrid &grid, const ij::Rectangle<float> &area)
+    {
+        std::vector<size_t> found;
+        grid.ForEachCandidate(area, [&found](size_t element) { found.push_back(element); });
+        std::ranges::stable_sort(found);
+        return found;
+    }
+} // namespace
+
+TEST_CASE("SpatialGrid finds elements only in the cells around the area", "[grid]")
+{
+    ij::SpatialGrid grid(100, 100);
+    grid.Insert(0, ij::Vector2f(10, 10));
+    grid.Insert(1, ij::Vector2f(1000, 1000));
+    grid.Insert(2, ij::Vector2f(20, 30));
+    CHECK(findCandidates(grid, ij::Rectangle<float>(ij::Vector2f(0, 0), ij::Vector2f(50, 50))) ==
+          std::vector<size_t>{0, 2});
+    CHECK(findCandidates(grid, ij::Rectangle<float>(ij::Vector2f(990, 990), ij::Vector2f(20, 20))) ==
+          std::vector<size_t>{1});
+}
+
+TEST_CASE("SpatialGrid follows moving elements", "[grid]")
+{
+    ij::SpatialGrid grid(100, 100);
+    grid.Insert(0, ij::Vector2f(10, 10));
+    grid.Move(0, ij::Vector2f(10, 10), ij::Vector2f(2000, 10));
+    CHECK(findCandidates(grid, ij::Rectangle<float>(ij::Vector2f(0, 0), ij::Vector2f(50, 50))).empty());
+    CHECK(findCandidates(grid, ij::Rectangle<float>(ij::Vector2f(1990, 0), ij::Vector2f(20, 20))) ==
+          std::vector<size_t>{0});
+}
+
+TEST_CASE("SpatialGrid keeps elements outside of the map in the border cells", "[grid]")
+{
+    ij::SpatialGrid grid(10, 10);
+    grid.Insert(0, ij::Vector2f(-500, 5000));
+    CHECK(findCandidates(grid, ij::Rectangle<float>(ij::Vector2f(-600, 4900), ij::Vector2f(200, 200))) ==
+          std::vector<size_t>{0});
+}
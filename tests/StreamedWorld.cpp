@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <ij/Game.h>
+#include <ij/NullTextureLoader.h>
+#include <thread>
+
+namespace
+{
+    // whether World::map consists of the chunks which GenerateChunk creates on the calling thread
+    [[nodiscard]] bool isMapGeneratedCorrectly(const ij::Game &game)
+    {
+        const ij::Map &map = game.SimulatedWorld.map;
+        const ij::ChunkCoordinates origin = game.Streaming->GetOrigin();
+        ij::ChunkTiles expected;
+        for (size_t y = 0; y < map.GetHeightInChunks(); ++y)
+        {
+            for (size_t x = 0; x < map.GetWidthInChunks(); ++x)
+            {
+                ij::GenerateChunk(game.Streaming->GetSeed(),
+                                  ij::ChunkCoordinates{(origin.X + ij::AssertCast<ij::Int64>(x)),
+                                                       (origin.Y + ij::AssertCast<ij::Int64>(y))},
+                                  expected);
+                if (!std::ranges::equal(map.GetChunk(x, y), expected))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE("World positions keep their precision far away from the origin", "[streaming]")
+{
+    const ij::ChunkCoordinates origin{1'000'000'000, -2'000'000'000};
+    const ij::WorldPosition position = ij::ToWorldPosition(ij::Vector2f(2500.25f, -0.5f), origin);
+    CHECK(position.Chunk == ij::ChunkCoordinates{1'000'000'002, -2'000'000'001});
+    CHECK(position.Offset.x == (2500.25f - (2 * ij::ChunkSizeInPixels)));
+    CHECK(position.Offset.y == (ij::ChunkSizeInPixels - 0.5f));
+    const ij::Vector2f local = ij::ToLocalPosition(position, origin);
+    CHECK(local.x == 2500.25f);
+    CHECK(local.y == -0.5f);
+}
+
+TEST_CASE("Chunks only depend on the seed and their coordinates", "[streaming]")
+{
+    ij::ChunkTiles first;
+    ij::ChunkTiles second;
+    ij::GenerateChunk(1, ij::ChunkCoordinates{5, -7}, first);
+    ij::GenerateChunk(1, ij::ChunkCoordinates{5, -7}, second);
+    CHECK(first == second);
+    ij::GenerateChunk(1, ij::ChunkCoordinates{-7, 5}, second);
+    CHECK(first != second);
+    ij::GenerateChunk(2, ij::ChunkCoordinates{5, -7}, second);
+    CHECK(first != second);
+}
+
+TEST_CASE("An infinite world moves along with the player and forgets what is left behind", "[streaming]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    ij::GameSettings settings;
+    settings.IsWorldInfinite = true;
+    ij::Game first(settings, *enemies, ij::TextureId(0));
+    REQUIRE(first.Streaming);
+    const size_t chunksPerSide = ((2 * first.Streaming->Settings.ActiveRadius) + 1);
+    CHECK(first.SimulatedWorld.map.Width == (chunksPerSide * ij::Map::ChunkSize));
+    const ij::WorldPosition start = ij::ToWorldPosition(first.Player.Logic.Position, first.Streaming->GetOrigin());
+    const size_t enemiesAtStart = first.SimulatedWorld.enemies.GetCount();
+    CHECK(enemiesAtStart > 0);
+    first.CurrentInput.selectedEnemy = 0;
+
+    // far enough that nothing of the start remains
+    constexpr size_t steps = 40;
+    for (size_t i = 0; i < steps; ++i)
+    {
+        first.Player.Logic.Position.x += ij::ChunkSizeInPixels;
+        first.Streaming->Update(first.SimulatedWorld, first.Player.Logic, first.CurrentInput.selectedEnemy);
+        // the player stays near the center of the map
+        CHECK(first.Player.Logic.Position.x <
+              (ij::AssertCast<float>(first.SimulatedWorld.map.Width * ij::TileSize) * 0.75f));
+        const size_t loadedChunkLimit = ((chunksPerSide + 4) * (chunksPerSide + 4));
+        CHECK(first.Streaming->GetNumberOfLoadedChunks() <= loadedChunkLimit);
+        CHECK(first.SimulatedWorld.enemies.GetCount() < (enemiesAtStart * 2));
+    }
+    const ij::WorldPosition end = ij::ToWorldPosition(first.Player.Logic.Position, first.Streaming->GetOrigin());
+    CHECK(end.Chunk.X == (start.Chunk.X + ij::AssertCast<ij::Int64>(steps)));
+    CHECK(end.Chunk.Y == start.Chunk.Y);
+    CHECK(end.Offset.x == start.Offset.x);
+    CHECK(end.Offset.y == start.Offset.y);
+    CHECK(first.Streaming->Statistics.Recenterings > 0);
+    CHECK(first.Streaming->Statistics.EnemiesEvicted >= enemiesAtStart);
+    CHECK(!first.CurrentInput.selectedEnemy);
+
+    CHECK(isMapGeneratedCorrectly(first));
+}
+
+TEST_CASE("Chunks from the background thread are the same as the ones generated on demand", "[streaming]")
+{
+    ij::NullTextureLoader textures;
+    const std::optional<std::vector<ij::EnemyTemplate>> enemies = ij::LoadEnemies(textures, "");
+    REQUIRE(enemies);
+    ij::GameSettings settings;
+    settings.IsWorldInfinite = true;
+    ij::Game game(settings, *enemies, ij::TextureId(0));
+    REQUIRE(game.Streaming);
+    const auto giveUp = (std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    while ((game.Streaming->Statistics.ChunksGeneratedInBackground == 0) &&
+           (std::chrono::steady_clock::now() < giveUp))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        game.Streaming->Update(game.SimulatedWorld, game.Player.Logic, game.CurrentInput.selectedEnemy);
+    }
+    REQUIRE(game.Streaming->Statistics.ChunksGeneratedInBackground > 0);
+    // let the background thread finish the rest of the prefetched chunks
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // into the chunks which were prefetched
+    for (size_t i = 0; i < 2; ++i)
+    {
+        game.Player.Logic.Position.y += ij::ChunkSizeInPixels;
+        game.Streaming->Update(game.SimulatedWorld, game.Player.Logic, game.CurrentInput.selectedEnemy);
+    }
+    CHECK(game.Streaming->Statistics.Recenterings > 0);
+    CHECK(isMapGeneratedCorrectly(game));
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/TileChunks.h>
+
+TEST_CASE("TileChunkCache replaces the chunk which was drawn least recently", "[chunks]")
+{
+    // room for two chunks
+    ij::TileChunkCache cache(2 * ij::TileChunkPixels * ij::TileChunkPixels * 4);
+    REQUIRE(cache.GetSlotCount() == 2);
+    std::vector<std::array<ij::Tile, ij::Map::TilesPerChunk>> chunks(3);
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        chunks[i].fill(ij::AssertCast<ij::Tile>(i));
+    }
+
+    const ij::TileChunkCache::Lookup first = cache.Find(chunks[0]);
+    CHECK(!first.IsCached);
+    const ij::TileChunkCache::Lookup second = cache.Find(chunks[1]);
+    CHECK(!second.IsCached);
+    CHECK(second.Slot != first.Slot);
+    CHECK(cache.Find(chunks[0]).IsCached);
+
+    // the second chunk has not been drawn for the longest time
+    cache.StartFrame();
+    const ij::TileChunkCache::Lookup third = cache.Find(chunks[2]);
+    CHECK(!third.IsCached);
+    CHECK(third.Slot == second.Slot);
+    CHECK(cache.Find(chunks[0]).IsCached);
+    cache.StartFrame();
+    CHECK(!cache.Find(chunks[1]).IsCached);
+
+    // a different map can have other tiles at the same address
+    chunks[1].fill(7);
+    const ij::TileChunkCache::Lookup changed = cache.Find(chunks[1]);
+    CHECK(!changed.IsCached);
+    CHECK(cache.Find(chunks[1]).IsCached);
+}
+
+TEST_CASE("TileChunkCache grows instead of replacing a chunk of the current frame", "[chunks]")
+{
+    ij::TileChunkCache cache(2 * ij::TileChunkPixels * ij::TileChunkPixels * 4);
+    REQUIRE(cache.GetSlotCount() == 2);
+    // more chunks than slots are visible in every frame
+    std::vector<std::array<ij::Tile, ij::Map::TilesPerChunk>> chunks(5);
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        chunks[i].fill(ij::AssertCast<ij::Tile>(i));
+    }
+    for (size_t frame = 0; frame < 3; ++frame)
+    {
+        std::vector<size_t> slots;
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            const ij::TileChunkCache::Lookup lookup = cache.Find(chunks[i]);
+            CHECK(lookup.IsCached == (frame > 0));
+            CHECK(std::ranges::find(slots, lookup.Slot) == slots.end());
+            slots.push_back(lookup.Slot);
+        }
+        cache.StartFrame();
+    }
+    CHECK(cache.GetSlotCount() == chunks.size());
+
+    // a new chunk replaces one which has not been drawn in the current frame yet
+    std::array<ij::Tile, ij::Map::TilesPerChunk> other;
+    other.fill(9);
+    const ij::TileChunkCache::Lookup first = cache.Find(chunks[0]);
+    CHECK(first.IsCached);
+    const ij::TileChunkCache::Lookup added = cache.Find(other);
+    CHECK(!added.IsCached);
+    CHECK(added.Slot != first.Slot);
+    CHECK(cache.Find(chunks[0]).IsCached);
+    CHECK(cache.GetSlotCount() == chunks.size());
+}
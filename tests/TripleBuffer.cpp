@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <ij/TripleBuffer.h>
+#include <thread>
+#include <vector>
+
+TEST_CASE("TripleBuffer hands the newest version to the reader", "[threads]")
+{
+    ij::TripleBuffer<int> buffer(0);
+    CHECK(!buffer.Update());
+    CHECK(buffer.GetReadBuffer() == 0);
+
+    buffer.GetWriteBuffer() = 1;
+    buffer.Publish();
+    buffer.GetWriteBuffer() = 2;
+    buffer.Publish();
+    // the reader keeps its version until it asks for a new one
+    CHECK(buffer.GetReadBuffer() == 0);
+    CHECK(buffer.Update());
+    // 1 was skipped
+    CHECK(buffer.GetReadBuffer() == 2);
+    CHECK(!buffer.Update());
+    CHECK(buffer.GetReadBuffer() == 2);
+
+    buffer.GetWriteBuffer() = 3;
+    buffer.Publish();
+    CHECK(buffer.Update());
+    CHECK(buffer.GetReadBuffer() == 3);
+}
+
+TEST_CASE("TripleBuffer never shows a version which is still being written", "[threads]")
+{
+    constexpr int versions = 20000;
+    ij::TripleBuffer<std::vector<int>> buffer(std::vector<int>(64, 0));
+    std::thread writer([&buffer]() {
+        for (int version = 1; version <= versions; ++version)
+        {
+            std::vector<int> &written = buffer.GetWriteBuffer();
+            std::ranges::fill(written, version);
+            buffer.Publish();
+        }
+    });
+    int previous = 0;
+    bool isConsistent = true;
+    bool isMonotonic = true;
+    while (previous < versions)
+    {
+        (void)buffer.Update();
+        const std::vector<int> &read = buffer.GetReadBuffer();
+        isConsistent = (isConsistent && std::ranges::all_of(read, [&read](int value) { return value == read[0]; }));
+        isMonotonic = (isMonotonic && (read[0] >= previous));
+        previous = read[0];
+    }
+    writer.join();
+    CHECK(isConsistent);
+    CHECK(isMonotonic);
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/VertexBatch.h>
+
+namespace
+{
+    [[nodiscard]] ij::Sprite createSprite(const ij::UInt32 texture, const ij::Int32 x)
+    {
+        return ij::Sprite(ij::TextureId(texture), ij::Vector2i(x, 10), ij::Color(255, 255, 255, 255),
+                          ij::Vector2u(64, 0), ij::Vector2u(32, 16));
+    }
+} // namespace
+
+TEST_CASE("VertexBatch merges consecutive primitives with the same texture", "[batch]")
+{
+    ij::VertexBatch batch;
+    CHECK(batch.IsEmpty());
+    batch.AddSprite(createSprite(0, 0));
+    batch.AddSprite(createSprite(0, 32));
+    batch.AddSprite(createSprite(1, 64));
+    // the order has to stay the same, so this can not go into the first run
+    batch.AddSprite(createSprite(0, 96));
+    batch.AddRectangle(ij::Vector2i(0, 0), ij::Vector2u(10, 4), ij::Color(255, 0, 0, 255), ij::Color(0, 0, 0, 0), 1);
+    batch.AddDot(ij::Vector2i(5, 5), ij::Color(0, 255, 0, 255));
+    ij::AppendQuad(ij::Vector2f(0, 0), ij::Vector2f(8, 8), ij::Vector2f(0, 0), ij::Color(0, 0, 0, 255),
+                   batch.Continue(ij::BatchSource::Glyphs));
+
+    REQUIRE(batch.Runs.size() == 5);
+    CHECK(batch.Runs[0].Source == ij::BatchSource::Texture);
+    CHECK(batch.Runs[0].Texture.Value.Index == 0);
+    CHECK(batch.GetRunEnd(0) == (2 * 6));
+    CHECK(batch.Runs[1].Texture.Value.Index == 1);
+    CHECK(batch.Runs[2].Texture.Value.Index == 0);
+    CHECK(batch.Runs[3].Source == ij::BatchSource::Color);
+    // four edges of the outline without a fill, then the dot
+    CHECK((batch.GetRunEnd(3) - batch.Runs[3].Begin) == ((4 + 1) * 6));
+    CHECK(batch.Runs[4].Source == ij::BatchSource::Glyphs);
+    CHECK(batch.GetRunEnd(4) == batch.Vertices.size());
+
+    // the texture coordinates are in pixels
+    const ij::TexturedVertex &bottomRight = batch.Vertices[5];
+    CHECK(bottomRight.Position.x == 32);
+    CHECK(bottomRight.Position.y == 26);
+    CHECK(bottomRight.TextureCoordinates.x == 96);
+    CHECK(bottomRight.TextureCoordinates.y == 16);
+
+    // the outline is around the rectangle
+    const ij::TexturedVertex &outlineTopLeft = batch.Vertices[batch.Runs[3].Begin];
+    CHECK(outlineTopLeft.Position.x == -1);
+    CHECK(outlineTopLeft.Position.y == -1);
+
+    batch.Clear();
+    CHECK(batch.IsEmpty());
+    CHECK(batch.Runs.empty());
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ij/World.h>
+
+TEST_CASE("WalkabilityMap treats everything outside of the map as walls", "[collision]")
+{
+    const std::array<ij::Tile, 4> tiles = {0, ij::NoTile, 1, 2};
+    const ij::WalkabilityMap walkability(ij::CreateMapFromTiles(2, 2, tiles));
+    CHECK(walkability.IsWalkablePoint(0, 0));
+    CHECK(walkability.IsWalkablePoint(31.9f, 31.9f));
+    CHECK(!walkability.IsWalkablePoint(32, 0));
+    CHECK(walkability.IsWalkablePoint(63.9f, 63.9f));
+    CHECK(!walkability.IsWalkablePoint(-0.1f, 0));
+    CHECK(!walkability.IsWalkablePoint(0, -0.1f));
+    CHECK(!walkability.IsWalkablePoint(64, 40));
+    CHECK(!walkability.IsWalkablePoint(40, 64));
+    CHECK(!walkability.IsWalkablePoint(-1e30f, 1e30f));
+    CHECK(!walkability.IsWalkablePoint(1e30f, -1e30f));
+}
+
+TEST_CASE("MovementBatch has the same result as moving one entity at a time", "[collision]")
+{
+    ij::StandardRandomNumberGenerator random(11);
+    const ij::Map map = ij::GenerateRandomMap(random, 40, 30);
+    const ij::World world(0, map, 1);
+    std::vector<ij::Vector2f> expectedPositions;
+    std::vector<std::uint8_t> expectedBumps;
+    ij::MovementBatch batch;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        ij::Vector2f position = ij::GenerateRandomPointForSpawning(world, random);
+        const ij::Vector2f change(ij::AssertCast<float>(random.GenerateInt32(-40, 40)),
+                                  ij::AssertCast<float>(random.GenerateInt32(-40, 40)));
+        batch.Add(i, position, change);
+        expectedBumps.push_back(ij::MoveWithCollisionDetection(position, true, change, world));
+        expectedPositions.push_back(position);
+    }
+    std::vector<ij::Vector2f> positions(expectedPositions.size(), ij::Vector2f(0, 0));
+    std::vector<std::uint8_t> bumps(expectedBumps.size());
+    ij::MoveWithCollisionDetection(batch, world.Walkability, positions, bumps);
+    CHECK(bumps == expectedBumps);
+    // make sure that all the cases are covered
+    CHECK(std::ranges::count(bumps, 0) > 100);
+    CHECK(std::ranges::count(bumps, 1) > 100);
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        CHECK(positions[i].x == expectedPositions[i].x);
+        CHECK(positions[i].y == expectedPositions[i].y);
+    }
+}